@@ -0,0 +1,40 @@
+// (c) IMT - Information Management Technology AG, CH-9470 Buchs, www.imt.ch.
+// SW guideline: Technote Coding Guidelines Ver. 1.5.1
+
+#include "ApplicationEvents.h"
+
+// Project includes
+#include "ApplicationParts.h"
+
+namespace blinky {
+
+EventQueue ApplicationEvents::queue;
+EventQueue_Slot ApplicationEvents::slots[ApplicationEvents::CAPACITY];
+
+void ApplicationEvents::init(void) {
+    EventQueue_Init(&queue, slots, CAPACITY);
+}
+
+uint32_t ApplicationEvents::dispatch(void) {
+    return EventQueue_Drain(&queue, &ApplicationEvents::onEvent, NULL, MAX_BATCH);
+}
+
+void ApplicationEvents::onEvent(void* pContext, const EventQueue_Event* const pEvent) {
+    (void)pContext;
+    // the data flow began in the interrupt, its timestamp is on the clock of the runtime (ApplicationParts::getCycles)
+    switch (pEvent->Type) {
+        case TYPE_BUTTON_CHANGED:
+            (void)RuntimeCore::post(ApplicationParts::getButtonInput(), LedPart::MESSAGE_BUTTON_CHANGED, pEvent->Data, pEvent->Cycles);
+            break;
+        case TYPE_USART_RECEIVED:
+            (void)RuntimeCore::post(ApplicationParts::getUsartInput(), UsartPart::MESSAGE_RECEIVED, 0U, pEvent->Cycles);
+            break;
+        case TYPE_PATTERN_SELECTED:
+            (void)RuntimeCore::post(ApplicationParts::getPatternInput(), LedPart::MESSAGE_SELECT_PATTERN, pEvent->Data, pEvent->Cycles);
+            break;
+        default:
+            break;
+    }
+}
+
+} // namespace blinky
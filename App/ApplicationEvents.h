@@ -0,0 +1,107 @@
+// (c) IMT - Information Management Technology AG, CH-9470 Buchs, www.imt.ch.
+// SW guideline: Technote Coding Guidelines Ver. 1.5.1
+
+#ifndef APPLICATIONEVENTS_H
+#define APPLICATIONEVENTS_H
+
+// Must be very first include
+#include <Imt.Base.Core.Platform/Platform.h>
+
+// Project includes
+#include "SystemEventQueue.h"
+
+namespace blinky {
+
+//@{
+// Event queue of the application from the interrupt handlers to the main loop (@see SystemEventQueue.h).
+// The interrupt handlers only capture their data and post an event, dispatch forwards the events in the main loop
+// to the active parts (@see ApplicationParts.h).
+//@}
+class ApplicationEvents {
+
+public:
+
+    // Number of queued events, a power of two
+    static const uint32_t CAPACITY = 32U;
+
+    // Maximum number of events handled per dispatch call
+    static const uint32_t MAX_BATCH = 8U;
+
+    //@{
+    // Event types
+    //@}
+    enum Type {
+        // Confirmed level change of a button, Parameter: EXTI line, Data: level
+        TYPE_BUTTON_CHANGED,
+        // Bytes received by the link (APPLICATION_LINK_PORT) are pending in the ring of the link (@see SystemUsartLink.h)
+        TYPE_USART_RECEIVED,
+        // LED pattern written by the Modbus master (@see ModbusApp.h), Data: pattern index
+        TYPE_PATTERN_SELECTED
+    };
+
+    //@{
+    // Initialize the queue, call it before the interrupts are enabled.
+    //@}
+    static void init(void);
+
+    //@{
+    // Post an event, callable from any interrupt (inline: no long call from SRAM resident handlers).
+    // @param type: Event type.
+    // @param parameter: Event parameter.
+    // @param data: Event data.
+    // @return bool: false if the queue was full and the event is dropped
+    //@}
+    static bool post(const Type type, const uint16_t parameter, const uint32_t data) {
+        return EventQueue_Post(&queue, (uint16_t)type, parameter, data);
+    }
+
+    //@{
+    // Handle a batch of the queued events, call it from the main loop.
+    // @return uint32_t: Number of events handled
+    //@}
+    static uint32_t dispatch(void);
+
+    //@{
+    // Returns the queue for the statistics.
+    //@}
+    static const EventQueue& getQueue(void) {
+        return queue;
+    }
+
+private:
+
+    //@{
+    // Handle one event.
+    // @param pContext: Not used.
+    // @param pEvent: Event.
+    //@}
+    static void onEvent(void* pContext, const EventQueue_Event* const pEvent);
+
+    //@{
+    // Constructor.
+    //@}
+    explicit ApplicationEvents();
+
+    //@{
+    // Destructor.
+    //@}
+    ~ApplicationEvents();
+
+    //@{
+    // Provide the private copy constructor so the compiler does not generate the default one.
+    //@}
+    ApplicationEvents(const ApplicationEvents& other);
+
+    //@{
+    // Provide the private assignment operator so the compiler does not generate the default one.
+    //@}
+    ApplicationEvents& operator=(const ApplicationEvents& other);
+
+    static EventQueue queue;
+    static EventQueue_Slot slots[CAPACITY];
+};
+
+} // namespace blinky
+using blinky::ApplicationEvents;
+
+#endif // APPLICATIONEVENTS_H
@@ -0,0 +1,171 @@
+// (c) IMT - Information Management Technology AG, CH-9470 Buchs, www.imt.ch.
+// SW guideline: Technote Coding Guidelines Ver. 1.5.1
+
+#include "ApplicationParts.h"
+
+// Project includes
+#include "TimerApp.h"
+#include "CommandShell.h"
+#include "ApplicationHardwareConfig.h"
+#if defined(__IAR_SYSTEMS_ICC__)
+#include "Core_CortexM3.h"
+#endif // __IAR_SYSTEMS_ICC__
+
+// Imt.Base includes
+#include <Imt.Base.Core.Diagnostics/Diagnostics.h>
+
+//@{
+// LED patterns, step durations in ms (on, off, on, ...)
+//@}
+static const uint16_t PATTERN_BLINK[] = { 500U, 850U };
+static const uint16_t PATTERN_HEARTBEAT[] = { 100U, 150U, 100U, 650U };
+static const uint16_t PATTERN_SOS[] = { 150U, 150U, 150U, 150U, 150U, 450U,
+                                        450U, 150U, 450U, 150U, 450U, 450U,
+                                        150U, 150U, 150U, 150U, 150U, 1050U };
+struct LedPattern {
+    const uint16_t* pDurationsMs;
+    uint32_t Count;
+};
+static const LedPattern LED_PATTERNS[] = {
+    { PATTERN_BLINK, sizeof(PATTERN_BLINK) / sizeof(PATTERN_BLINK[0]) },
+    { PATTERN_HEARTBEAT, sizeof(PATTERN_HEARTBEAT) / sizeof(PATTERN_HEARTBEAT[0]) },
+    { PATTERN_SOS, sizeof(PATTERN_SOS) / sizeof(PATTERN_SOS[0]) }
+};
+ASSERT_COMPILER((sizeof(LED_PATTERNS) / sizeof(LED_PATTERNS[0])) == blinky::TimerPart::PATTERN_COUNT);
+
+//@{
+// Scheduling priorities of the parts, 0 is the highest
+//@}
+static const uint32_t PRIORITY_TIMER = 0U;
+static const uint32_t PRIORITY_LED = 1U;
+static const uint32_t PRIORITY_USART = 2U;
+
+namespace blinky {
+
+//------------------------------------------------------------------------------
+// Parts and wiring: button -> LED -> timer, USART
+//------------------------------------------------------------------------------
+static TimerPart timerPart(PRIORITY_TIMER);
+static LedPart ledPart(PRIORITY_LED, timerPart.patternIn);
+static UsartPart usartPart(PRIORITY_USART);
+
+LedPart::LedPart(const uint32_t priority, InputPort& patternTarget) :
+    ActivePart("Led", priority, queue, QUEUE_SIZE),
+    buttonIn(*this, 0U),
+    patternOut(patternTarget),
+    patternIndex(0U) {
+}
+
+void LedPart::onMessage(const Message& message) {
+    if ((message.Id == MESSAGE_BUTTON_CHANGED) && (message.Data == 0U)) {
+        patternIndex = (patternIndex + 1U) % TimerPart::PATTERN_COUNT;
+        (void)send(patternOut, MESSAGE_SELECT_PATTERN, patternIndex);
+    }
+}
+
+TimerPart::TimerPart(const uint32_t priority) :
+    ActivePart("Timer", priority, queue, QUEUE_SIZE),
+    patternIn(*this, 0U),
+    patternIndex(0U) {
+}
+
+void TimerPart::onStart(void) {
+    (void)TimerApp::startPattern(LED_PATTERNS[0].pDurationsMs, LED_PATTERNS[0].Count);
+}
+
+void TimerPart::onMessage(const Message& message) {
+    if (message.Data < PATTERN_COUNT) {
+        if (TimerApp::startPattern(LED_PATTERNS[message.Data].pDurationsMs, LED_PATTERNS[message.Data].Count)) {
+            patternIndex = message.Data;
+        }
+    }
+}
+
+UsartPart::UsartPart(const uint32_t priority) :
+    ActivePart("Usart", priority, queue, QUEUE_SIZE),
+    rxIn(*this, 0U),
+    txSequence(0U) {
+}
+
+void UsartPart::getStatistics(Framing_Statistics* const pStatistics) const {
+    Framing_GetStatistics(&decoder, pStatistics);
+}
+
+void UsartPart::resetStatistics(void) {
+    Framing_ResetStatistics(&decoder);
+}
+
+void UsartPart::onStart(void) {
+    Framing_DecoderInit(&decoder, MAX_PAYLOAD_SIZE, &UsartPart::onFrame, this);
+}
+
+void UsartPart::onMessage(const Message& message) {
+    if (message.Id == MESSAGE_RECEIVED) {
+        // the bytes of an incomplete frame are held in the ring
+        if (!ApplicationLink::receive(&UsartPart::onChunk, this, decoder.EncodedSize)) {
+            Framing_DecoderReset(&decoder);
+        }
+    }
+}
+
+void UsartPart::onChunk(void* pContext, uint8_t* const pChunk, const uint32_t size) {
+    UsartPart* const pPart = static_cast<UsartPart*>(pContext);
+    // the shell copies the text before the decoder overwrites the chunk
+    CommandShell::put(pChunk, size);
+    Framing_DecoderPut(&pPart->decoder, pChunk, size);
+}
+
+void UsartPart::onFrame(void* pContext, const Framing_Frame* const pFrame) {
+    UsartPart* const pPart = static_cast<UsartPart*>(pContext);
+    const uint8_t acknowledge[] = { FRAME_ACKNOWLEDGE, pFrame->Sequence };
+    const uint32_t capacity = FRAMING_MAX_ENCODED_SIZE(sizeof(acknowledge));
+    // encoded directly into the transmit ring, dropped if it is full (counted by the link)
+    uint8_t* const pRegion = ApplicationLink::reserveTransmit(capacity);
+    if (pRegion != NULL) {
+        ApplicationLink::commitTransmit(Framing_Encode(pRegion, capacity, pPart->txSequence, acknowledge, sizeof(acknowledge)));
+        ++pPart->txSequence;
+    }
+}
+
+void ApplicationParts::start(void) {
+    RuntimeCore::init(&ApplicationParts::getCycles);
+    RuntimeCore::start();
+}
+
+uint32_t ApplicationParts::run(void) {
+    return RuntimeCore::runUntilIdle(MAX_MESSAGES_PER_RUN);
+}
+
+InputPort& ApplicationParts::getButtonInput(void) {
+    return ledPart.buttonIn;
+}
+
+InputPort& ApplicationParts::getUsartInput(void) {
+    return usartPart.rxIn;
+}
+
+InputPort& ApplicationParts::getPatternInput(void) {
+    return timerPart.patternIn;
+}
+
+uint32_t ApplicationParts::getPatternIndex(void) {
+    return timerPart.getPatternIndex();
+}
+
+void ApplicationParts::getFrameStatistics(Framing_Statistics* const pStatistics) {
+    usartPart.getStatistics(pStatistics);
+}
+
+void ApplicationParts::resetFrameStatistics(void) {
+    usartPart.resetStatistics();
+}
+
+uint32_t ApplicationParts::getCycles(void) {
+#if defined(__IAR_SYSTEMS_ICC__)
+    return DWT->CYCCNT;
+#else
+    return 0U;
+#endif // __IAR_SYSTEMS_ICC__
+}
+
+} // namespace blinky
@@ -0,0 +1,241 @@
+// (c) IMT - Information Management Technology AG, CH-9470 Buchs, www.imt.ch.
+// SW guideline: Technote Coding Guidelines Ver. 1.5.1
+
+#ifndef APPLICATIONPARTS_H
+#define APPLICATIONPARTS_H
+
+// Must be very first include
+#include <Imt.Base.Core.Platform/Platform.h>
+
+// Project includes
+#include "SystemFraming.h"
+
+// Imt.Base includes
+#include <Imt.Base.Dff.Runtime/RuntimeCore.h>
+
+namespace blinky {
+
+//@{
+// LED part: selects the next LED pattern on a press of the user button B1 (active low).
+// buttonIn: confirmed button level (Data: level) -> patternOut: pattern index (Data: index)
+//@}
+class LedPart : public ActivePart {
+
+public:
+
+    // Message ids
+    static const uint16_t MESSAGE_BUTTON_CHANGED = 0U;
+    static const uint16_t MESSAGE_SELECT_PATTERN = 1U;
+
+    //@{
+    // Constructor.
+    // @param priority: Scheduling priority.
+    // @param patternTarget: Input port receiving the selected pattern.
+    //@}
+    LedPart(const uint32_t priority, InputPort& patternTarget);
+
+    // Button level of the debouncer
+    InputPort buttonIn;
+
+private:
+
+    virtual void onMessage(const Message& message);
+
+    // Number of queued messages
+    static const uint32_t QUEUE_SIZE = 4U;
+
+    OutputPort patternOut;
+    Message queue[QUEUE_SIZE];
+    // Index of the running pattern
+    uint32_t patternIndex;
+};
+
+//@{
+// Timer part: runs the selected LED pattern on the output compare of TIM2 (@see TimerApp.h), starts with pattern 0.
+// patternIn: pattern index (Data: index)
+//@}
+class TimerPart : public ActivePart {
+
+public:
+
+    // Number of LED patterns, indices 0..PATTERN_COUNT-1
+    static const uint32_t PATTERN_COUNT = 3U;
+
+    //@{
+    // Constructor.
+    // @param priority: Scheduling priority.
+    //@}
+    explicit TimerPart(const uint32_t priority);
+
+    //@{
+    // Returns the index of the running pattern.
+    //@}
+    uint32_t getPatternIndex(void) const {
+        return patternIndex;
+    }
+
+    // Pattern to run
+    InputPort patternIn;
+
+private:
+
+    virtual void onStart(void);
+    virtual void onMessage(const Message& message);
+
+    // Number of queued messages
+    static const uint32_t QUEUE_SIZE = 4U;
+
+    Message queue[QUEUE_SIZE];
+    // Index of the running pattern
+    uint32_t patternIndex;
+};
+
+//@{
+// USART part: decodes the frames received on APPLICATION_LINK_PORT in place in the receive ring of the link
+// (@see SystemFraming.h, SystemUsartLink.h) and acknowledges each valid frame with the frame { FRAME_ACKNOWLEDGE, received sequence number },
+// encoded directly into the transmit ring. The received text lines are passed to the command shell (@see CommandShell.h).
+// rxIn: received bytes pending in the link (Data: not used)
+//@}
+class UsartPart : public ActivePart {
+
+public:
+
+    // Message ids
+    static const uint16_t MESSAGE_RECEIVED = 0U;
+
+    // Maximum payload size of a received frame
+    static const uint32_t MAX_PAYLOAD_SIZE = 64U;
+
+    // First payload byte of the acknowledge frame
+    static const uint8_t FRAME_ACKNOWLEDGE = 0x06U;
+
+    //@{
+    // Constructor.
+    // @param priority: Scheduling priority.
+    //@}
+    explicit UsartPart(const uint32_t priority);
+
+    //@{
+    // Copy the statistics of the frame decoder.
+    // @param pStatistics: Pointer to the Framing_Statistics structure to fill.
+    //@}
+    void getStatistics(Framing_Statistics* const pStatistics) const;
+
+    //@{
+    // Reset the statistics of the frame decoder.
+    //@}
+    void resetStatistics(void);
+
+    // Received bytes pending
+    InputPort rxIn;
+
+private:
+
+    virtual void onStart(void);
+    virtual void onMessage(const Message& message);
+
+    //@{
+    // Receive handler of the link: decodes a chunk of the receive ring in place.
+    //@}
+    static void onChunk(void* pContext, uint8_t* const pChunk, const uint32_t size);
+
+    //@{
+    // Frame handler of the decoder: acknowledges the frame.
+    //@}
+    static void onFrame(void* pContext, const Framing_Frame* const pFrame);
+
+    // Number of queued messages, one message drains all pending bytes
+    static const uint32_t QUEUE_SIZE = 4U;
+
+    Message queue[QUEUE_SIZE];
+    Framing_Decoder decoder;
+    // Sequence number of the next transmitted frame
+    uint8_t txSequence;
+};
+
+//@{
+// Active parts of the application and their wiring (@see RuntimeCore.h).
+// The interrupts post their events to the application event queue, ApplicationEvents::dispatch forwards them to the
+// input ports of the parts, run executes the parts. The profiles are measured in CPU cycles.
+//@}
+class ApplicationParts {
+
+public:
+
+    //@{
+    // Set the profile clock and start the parts, call it before the interrupts are enabled.
+    //@}
+    static void start(void);
+
+    //@{
+    // Execute the queued messages, call it from the main loop.
+    // @return uint32_t: Number of messages handled
+    //@}
+    static uint32_t run(void);
+
+    //@{
+    // Returns the input port of the confirmed button levels.
+    //@}
+    static InputPort& getButtonInput(void);
+
+    //@{
+    // Returns the input port of the bytes received by the link.
+    //@}
+    static InputPort& getUsartInput(void);
+
+    //@{
+    // Returns the input port of the LED pattern selection of the timer part.
+    //@}
+    static InputPort& getPatternInput(void);
+
+    //@{
+    // Returns the index of the running LED pattern.
+    //@}
+    static uint32_t getPatternIndex(void);
+
+    //@{
+    // Copy the statistics of the frame decoder of the USART part.
+    // @param pStatistics: Pointer to the Framing_Statistics structure to fill.
+    //@}
+    static void getFrameStatistics(Framing_Statistics* const pStatistics);
+
+    //@{
+    // Reset the statistics of the frame decoder of the USART part.
+    //@}
+    static void resetFrameStatistics(void);
+
+private:
+
+    // Maximum number of messages handled per run call
+    static const uint32_t MAX_MESSAGES_PER_RUN = 16U;
+
+    //@{
+    // Returns the CPU cycle counter, clock of the profiles.
+    //@}
+    static uint32_t getCycles(void);
+
+    //@{
+    // Constructor.
+    //@}
+    explicit ApplicationParts();
+
+    //@{
+    // Destructor.
+    //@}
+    ~ApplicationParts();
+
+    //@{
+    // Provide the private copy constructor so the compiler does not generate the default one.
+    //@}
+    ApplicationParts(const ApplicationParts& other);
+
+    //@{
+    // Provide the private assignment operator so the compiler does not generate the default one.
+    //@}
+    ApplicationParts& operator=(const ApplicationParts& other);
+};
+
+} // namespace blinky
+using blinky::ApplicationParts;
+
+#endif // APPLICATIONPARTS_H
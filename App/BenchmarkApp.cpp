@@ -0,0 +1,49 @@
+// (c) IMT - Information Management Technology AG, CH-9470 Buchs, www.imt.ch.
+// SW guideline: Technote Coding Guidelines Ver. 1.5.1
+
+#include "BenchmarkApp.h"
+
+// Project includes
+#include "SystemMemoryMap.h"
+#if defined(__IAR_SYSTEMS_ICC__)
+#include "Core_CortexM3.h"
+#endif // __IAR_SYSTEMS_ICC__
+
+// Imt.Base includes
+#include <Imt.Base.Core.Diagnostics/Diagnostics.h>
+
+namespace blinky {
+
+BenchmarkApp::Results BenchmarkApp::results;
+
+void BenchmarkApp::measure(void) {
+    // the latency is measured by swapping VTOR, the flash table alone has nothing to compare with
+    if (VectorTable_IsInRam()) {
+        VectorTable_MeasureDispatchLatency(&results.DispatchLatency);
+    }
+    RamCode_MeasureCopy(RAMCODE_BENCHMARK_MAX_SIZE, &results.RamCodeCopy);
+#if defined(__IAR_SYSTEMS_ICC__)
+    // word aligned flash: the DMA variant feeds the CRC unit directly from flash
+    CRC_MeasureThroughput((const void*)FLASH_BASE, CRC_BENCHMARK_SIZE, &results.CrcFlash); //lint !e923 cast from int to pointer [MISRA C++ Rule 5-2-8]
+    EventQueue_MeasureCost(&results.EventQueue);
+#endif // __IAR_SYSTEMS_ICC__
+    Framing_MeasureCost(&BenchmarkApp::getCycles, FRAMING_BENCHMARK_MAX_SIZE, &results.Framing);
+}
+
+void BenchmarkApp::getResults(Results* const pResults) {
+    if (pResults == NULL) {
+        ASSERT_DEBUG(false);
+        return;
+    }
+    *pResults = results;
+}
+
+uint32_t BenchmarkApp::getCycles(void) {
+#if defined(__IAR_SYSTEMS_ICC__)
+    return DWT->CYCCNT;
+#else
+    return 0U;
+#endif // __IAR_SYSTEMS_ICC__
+}
+
+} // namespace blinky
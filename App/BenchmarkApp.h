@@ -0,0 +1,90 @@
+// (c) IMT - Information Management Technology AG, CH-9470 Buchs, www.imt.ch.
+// SW guideline: Technote Coding Guidelines Ver. 1.5.1
+
+#ifndef BENCHMARKAPP_H
+#define BENCHMARKAPP_H
+
+// Must be very first include
+#include <Imt.Base.Core.Platform/Platform.h>
+
+// Project includes
+#include "SystemVectorTable.h"
+#include "SystemRamCode.h"
+#include "SystemPeripherals_CRC.h"
+#include "SystemEventQueue.h"
+#include "SystemFraming.h"
+
+namespace blinky {
+
+//@{
+// Benchmarks of the HAL on the target, measured once at startup and read out by the timing command of the shell
+// (@see CommandShell.h). The values are CPU cycles of the DWT cycle counter (@see SystemStartupControl.h).
+//@}
+class BenchmarkApp {
+
+public:
+
+    // Size of the CRC benchmark in bytes
+    static const uint32_t CRC_BENCHMARK_SIZE = 1024U;
+
+    //@{
+    // Results of the last measure call, 0 if not measured
+    //@}
+    struct Results {
+        // Dispatch latency of the flash and the SRAM vector table, 0 if the vector table is not relocated
+        VectorTable_Latency DispatchLatency;
+        // MemoryCopy_Copy of RAMCODE_BENCHMARK_MAX_SIZE bytes from flash and from SRAM, at the 2 flash wait states of 72 MHz
+        RamCode_Benchmark RamCodeCopy;
+        // Checksum of the first CRC_BENCHMARK_SIZE bytes of the flash, the image check of a bootloader
+        CRC_Benchmark CrcFlash;
+        // Post and drain of one event
+        EventQueue_Benchmark EventQueue;
+        // Encode and decode of a FRAMING_BENCHMARK_MAX_SIZE byte frame per byte
+        Framing_Benchmark Framing;
+    };
+
+    //@{
+    // Run the benchmarks, call it after the interrupt initialization and before the interrupts are enabled.
+    //@}
+    static void measure(void);
+
+    //@{
+    // Copy the results.
+    // @param pResults: Pointer to the Results structure to fill.
+    //@}
+    static void getResults(Results* const pResults);
+
+private:
+
+    //@{
+    // Returns the CPU cycle counter, clock of the framing benchmark.
+    //@}
+    static uint32_t getCycles(void);
+
+    //@{
+    // Constructor.
+    //@}
+    explicit BenchmarkApp();
+
+    //@{
+    // Destructor.
+    //@}
+    ~BenchmarkApp();
+
+    //@{
+    // Provide the private copy constructor so the compiler does not generate the default one.
+    //@}
+    BenchmarkApp(const BenchmarkApp& other);
+
+    //@{
+    // Provide the private assignment operator so the compiler does not generate the default one.
+    //@}
+    BenchmarkApp& operator=(const BenchmarkApp& other);
+
+    static Results results;
+};
+
+} // namespace blinky
+using blinky::BenchmarkApp;
+
+#endif // BENCHMARKAPP_H
@@ -0,0 +1,113 @@
+// (c) IMT - Information Management Technology AG, CH-9470 Buchs, www.imt.ch.
+// SW guideline: Technote Coding Guidelines Ver. 1.5.1
+
+#include "ButtonDebouncer.h"
+
+// Project includes
+#include "SystemPeripherals_EXTI.h"
+#include "SystemExtiDispatcher.h"
+
+// Imt.Base includes
+#include <Imt.Base.Core.Diagnostics/Diagnostics.h>
+
+// IAR includes
+#include <intrinsics.h>
+
+namespace blinky {
+
+ButtonDebouncer::Input ButtonDebouncer::inputs[ButtonDebouncer::MAX_INPUTS];
+Atomic_Uint32 ButtonDebouncer::settlingMask;
+volatile uint32_t ButtonDebouncer::tickCount = 0U;
+
+bool ButtonDebouncer::addInput(const uint32_t lineNumber, const volatile uint32_t* const pPinState, const uint32_t settleTimeMs,
+                               const StateChangedCallback callback, void* const pContext) {
+    if ((lineNumber >= MAX_INPUTS) || (pPinState == NULL) || (settleTimeMs == 0U) || (callback == NULL)) {
+        ASSERT_DEBUG(false);
+        return false;
+    }
+    Input& input = inputs[lineNumber];
+    input.pPinState = pPinState;
+    input.Callback = callback;
+    input.pContext = pContext;
+    input.SettleTimeMs = settleTimeMs;
+    input.CurrentSettleTimeMs = settleTimeMs;
+    input.Deadline = 0U;
+    input.Level = (*pPinState != 0U);
+    input.Counters.Edges = 0U;
+    input.Counters.Bounces = 0U;
+    input.Counters.Changes = 0U;
+    ExtiDispatcher_RegisterHandler(lineNumber, &ButtonDebouncer::onEdge, NULL);
+    return true;
+}
+
+void ButtonDebouncer::onEdge(void* pContext, const uint32_t lineNumber) {
+    (void)pContext;
+    if ((lineNumber >= MAX_INPUTS) || (inputs[lineNumber].pPinState == NULL)) {
+        return;
+    }
+    Input& input = inputs[lineNumber];
+
+    // no further interrupts of this line until the level is confirmed
+    EXTI_EnableInterrupt((uint32_t)1U << lineNumber, false);
+    input.Deadline = tickCount + input.CurrentSettleTimeMs;
+    ++input.Counters.Edges;
+    // the deadline is valid before the tick can see the input settling
+    AtomicFlags_Set(&settlingMask, lineNumber);
+}
+
+void ButtonDebouncer::onTick(void) {
+    const uint32_t now = tickCount + 1U;
+    tickCount = now;
+
+    uint32_t settling = Atomic_Load32(&settlingMask);
+    while (settling != 0U) {
+        const uint32_t lineNumber = 31U - (uint32_t)__CLZ(settling);
+        const uint32_t lineMask = (uint32_t)1U << lineNumber;
+        settling &= ~lineMask;
+
+        Input& input = inputs[lineNumber];
+        if ((int32_t)(now - input.Deadline) < 0) {
+            continue;
+        }
+
+        if (EXTI_IsITPending((EXTI_Line)lineMask)) {
+            // bounced during the window: restart it with doubled length, the line stays masked
+            EXTI_ClearITPendingBit((EXTI_Line)lineMask);
+            ++input.Counters.Bounces;
+            const uint32_t maxSettleTimeMs = input.SettleTimeMs * MAX_SETTLE_FACTOR;
+            input.CurrentSettleTimeMs = (input.CurrentSettleTimeMs >= (maxSettleTimeMs / 2U)) ? maxSettleTimeMs : (input.CurrentSettleTimeMs * 2U);
+            input.Deadline = now + input.CurrentSettleTimeMs;
+            continue;
+        }
+
+        // stable for the whole window: an edge from now on is latched in the pending register and taken after unmasking
+        input.CurrentSettleTimeMs = input.SettleTimeMs;
+        const bool level = (*input.pPinState != 0U);
+        AtomicFlags_Clear(&settlingMask, lineNumber);
+        EXTI_EnableInterrupt(lineMask, true);
+
+        if (level != input.Level) {
+            input.Level = level;
+            ++input.Counters.Changes;
+            input.Callback(input.pContext, level);
+        }
+    }
+}
+
+bool ButtonDebouncer::getLevel(const uint32_t lineNumber) {
+    if (lineNumber >= MAX_INPUTS) {
+        ASSERT_DEBUG(false);
+        return false;
+    }
+    return inputs[lineNumber].Level;
+}
+
+void ButtonDebouncer::getStatistics(const uint32_t lineNumber, Statistics* const pStatistics) {
+    if ((lineNumber >= MAX_INPUTS) || (pStatistics == NULL)) {
+        ASSERT_DEBUG(false);
+        return;
+    }
+    *pStatistics = inputs[lineNumber].Counters;
+}
+
+} // namespace blinky
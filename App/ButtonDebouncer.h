@@ -0,0 +1,142 @@
+// (c) IMT - Information Management Technology AG, CH-9470 Buchs, www.imt.ch.
+// SW guideline: Technote Coding Guidelines Ver. 1.5.1
+
+#ifndef BUTTONDEBOUNCER_H
+#define BUTTONDEBOUNCER_H
+
+// Must be very first include
+#include <Imt.Base.Core.Platform/Platform.h>
+
+// Project includes
+#include "Core_Atomic.h"
+
+namespace blinky {
+
+//@{
+// Timestamp-based debouncer for inputs on the EXTI lines 0..15.
+// addInput registers onEdge at the EXTI dispatcher (@see SystemExtiDispatcher.h), on an edge interrupt the edge is timestamped with the tick count, the EXTI line is masked
+// and the input is marked settling (O(1), no loop). The 1ms tick calls onTick, which walks only the settling
+// inputs: when the settle window of an input elapsed without further edges, the pin level is confirmed,
+// the line is unmasked and a change of the level is reported to the callback.
+// Edges during the settle window (bounces) are latched in the EXTI pending register while the line is masked,
+// they restart the window with doubled length (up to MAX_SETTLE_FACTOR times the settle time).
+// So a noisy input causes at most one interrupt per settle window.
+// The callback is called from the tick interrupt.
+//@}
+class ButtonDebouncer {
+
+public:
+
+    // Number of EXTI lines with a GPIO source (EXTI0..EXTI15)
+    static const uint32_t MAX_INPUTS = 16U;
+
+    // Upper limit of the settle window of a bouncing input as factor of its settle time
+    static const uint32_t MAX_SETTLE_FACTOR = 8U;
+
+    //@{
+    // Called when the confirmed level of an input changes.
+    // @param pContext: Context registered with addInput.
+    // @param level: New pin level (true = high).
+    //@}
+    typedef void (*StateChangedCallback)(void* pContext, const bool level);
+
+    //@{
+    // Counters of an input since addInput
+    //@}
+    struct Statistics {
+        // Edge interrupts taken
+        uint32_t Edges;
+        // Settle windows which were restarted by further edges
+        uint32_t Bounces;
+        // Confirmed level changes
+        uint32_t Changes;
+    };
+
+    //@{
+    // Register an input and its EXTI line handler, the line must be configured for both edges by the caller.
+    // @param lineNumber: EXTI line 0..15 of the pin.
+    // @param pPinState: Bit-band read address of the pin (e.g. &R_USER_BUTTON_B1).
+    // @param settleTimeMs: Time without edges until the level is confirmed.
+    // @param callback: Called on a confirmed level change.
+    // @param pContext: Passed unchanged to the callback.
+    // @return bool: false if the line number or a parameter is invalid
+    //@}
+    static bool addInput(const uint32_t lineNumber, const volatile uint32_t* const pPinState, const uint32_t settleTimeMs,
+                         const StateChangedCallback callback, void* const pContext);
+
+    //@{
+    // Edge interrupt of an input, called by the EXTI dispatcher after the pending bit was cleared.
+    // @param pContext: Not used.
+    // @param lineNumber: EXTI line 0..15 which triggered.
+    //@}
+    static void onEdge(void* pContext, const uint32_t lineNumber);
+
+    //@{
+    // Confirm the settled inputs, call it every millisecond (SysTick).
+    //@}
+    static void onTick(void);
+
+    //@{
+    // Returns the last confirmed level of an input.
+    // @param lineNumber: EXTI line 0..15 of the input.
+    //@}
+    static bool getLevel(const uint32_t lineNumber);
+
+    //@{
+    // Returns the counters of an input.
+    // @param lineNumber: EXTI line 0..15 of the input.
+    // @param pStatistics: Pointer to the Statistics structure to fill.
+    //@}
+    static void getStatistics(const uint32_t lineNumber, Statistics* const pStatistics);
+
+private:
+
+    //@{
+    // State of a registered input
+    //@}
+    struct Input {
+        const volatile uint32_t* pPinState;
+        StateChangedCallback Callback;
+        void* pContext;
+        uint32_t SettleTimeMs;
+        uint32_t CurrentSettleTimeMs;
+        // Tick count at which the settle window elapses
+        uint32_t Deadline;
+        bool Level;
+        Statistics Counters;
+    };
+
+    //@{
+    // Constructor.
+    //@}
+    explicit ButtonDebouncer();
+
+    //@{
+    // Destructor.
+    //@}
+    ~ButtonDebouncer();
+
+    //@{
+    // Provide the private copy constructor so the compiler does not generate the default one.
+    //@}
+    ButtonDebouncer(const ButtonDebouncer& other);
+
+    //@{
+    // Provide the private assignment operator so the compiler does not generate the default one.
+    //@}
+    ButtonDebouncer& operator=(const ButtonDebouncer& other);
+
+    // Registered inputs, indexed by the EXTI line number
+    static Input inputs[MAX_INPUTS];
+
+    // Bit n is set while input n is settling, atomic flags (edge and tick run on different interrupt levels)
+    static Atomic_Uint32 settlingMask;
+
+    // Milliseconds since the first tick
+    static volatile uint32_t tickCount;
+};
+
+} // namespace blinky
+using blinky::ButtonDebouncer;
+
+#endif // BUTTONDEBOUNCER_H
@@ -0,0 +1,681 @@
+// (c) IMT - Information Management Technology AG, CH-9470 Buchs, www.imt.ch.
+// SW guideline: Technote Coding Guidelines Ver. 1.5.1
+
+#include "CommandShell.h"
+
+// Project includes
+#include "ApplicationEvents.h"
+#include "ApplicationHardwareConfig.h"
+#include "ApplicationParts.h"
+#include "BenchmarkApp.h"
+#include "TimerApp.h"
+#include "Core_CortexM3.h"
+#include "SystemExtiDispatcher.h"
+#include "SystemFaultRecord.h"
+#include "SystemFraming.h"
+#include "SystemInputCapture.h"
+#include "SystemMemoryCopy.h"
+#include "SystemModbusRtu.h"
+#include "SystemAutoBaud.h"
+#include "UsartApp.h"
+#include "SystemPeripherals_USART.h"
+#include "SystemStackMonitor.h"
+#include "SystemStartupControl.h"
+#include "SystemTimeBase.h"
+#include "SystemUsartLink.h"
+
+// Imt.Base includes
+#include <Imt.Base.Core.Diagnostics/Diagnostics.h>
+
+//@{
+// Perfect hash of a command name into COMMANDSHELL_SLOT_COUNT slots: first and last character and length.
+// The factor is chosen for the command set, a collision fails the ASSERT_COMPILER below.
+//@}
+#define COMMANDSHELL_SLOT_COUNT 8U
+#define COMMANDSHELL_HASH(first, last, length) \
+    (((uint32_t)(first) + ((uint32_t)(last) * 7U) + (uint32_t)(length)) % COMMANDSHELL_SLOT_COUNT)
+
+//@{
+// Commands: name, first and last character of the name (the hash at compile time), handler, help text
+//@}
+#define COMMANDSHELL_COMMANDS(ENTRY) \
+    ENTRY(help,   'h', 'p', runHelp,   "list the commands") \
+    ENTRY(stats,  's', 's', runStats,  "link, frame, event, capture, critical section, stack, modbus, rs485 and baud statistics") \
+    ENTRY(parts,  'p', 's', runParts,  "profiles of the active parts in CPU cycles") \
+    ENTRY(timer,  't', 'r', runTimer,  "time base and LED pattern") \
+    ENTRY(faults, 'f', 's', runFaults, "fault records of the last resets") \
+    ENTRY(clear,  'c', 'r', runClear,  "reset the statistics and profiles, clear the fault records") \
+    ENTRY(bauddetect, 'b', 't', runBaudDetect, "detect the baud rate from the next 0x55 ('U') of the host") \
+    ENTRY(timing, 't', 'g', runTiming, "boot milestones and HAL benchmarks in CPU cycles")
+
+#define COMMANDSHELL_ID(name, first, last, handler, help) CommandShell_##name,
+#define COMMANDSHELL_ENTRY(name, first, last, handler, help) { #name, sizeof(#name) - 1U, &CommandShell::handler, help },
+#define COMMANDSHELL_SLOT_MATCH(name, first, last, handler, help) \
+    + ((COMMANDSHELL_HASH(first, last, sizeof(#name) - 1U) == Slot) ? ((uint32_t)CommandShell_##name + 1U) : 0U)
+#define COMMANDSHELL_SLOT_SUM(name, first, last, handler, help) + (1UL << COMMANDSHELL_HASH(first, last, sizeof(#name) - 1U))
+#define COMMANDSHELL_SLOT_OR(name, first, last, handler, help) | (1UL << COMMANDSHELL_HASH(first, last, sizeof(#name) - 1U))
+
+//@{
+// Command indices
+//@}
+enum CommandShell_Id {
+    COMMANDSHELL_COMMANDS(COMMANDSHELL_ID)
+    CommandShell_Count
+};
+
+// Each command has its own slot: the sum of the slot bits equals their combination
+ASSERT_COMPILER((0UL COMMANDSHELL_COMMANDS(COMMANDSHELL_SLOT_SUM)) == (0UL COMMANDSHELL_COMMANDS(COMMANDSHELL_SLOT_OR)));
+
+//@{
+// Slot of the hash table: index + 1 of the command hashed to the slot, 0 for an empty slot
+//@}
+template<uint32_t Slot>
+struct CommandShell_Slot {
+    static const uint8_t VALUE = (uint8_t)(0U COMMANDSHELL_COMMANDS(COMMANDSHELL_SLOT_MATCH));
+};
+
+// ASCII control characters of the input
+static const uint8_t ASCII_BACKSPACE = 0x08U;
+static const uint8_t ASCII_LF = 0x0AU;
+static const uint8_t ASCII_CR = 0x0DU;
+static const uint8_t ASCII_SPACE = 0x20U;
+static const uint8_t ASCII_TILDE = 0x7EU;
+static const uint8_t ASCII_DELETE = 0x7FU;
+
+// Lines of a fault record in the faults output
+static const uint32_t FAULT_RECORD_LINES = 3U;
+
+// Reserved transmit region: output line, line end, prompt and frame delimiter
+static const uint32_t OUTPUT_REGION_SIZE = CommandShell::MAX_OUTPUT_LENGTH + 5U;
+
+namespace blinky {
+
+const CommandShell::Command CommandShell::COMMANDS[] = {
+    COMMANDSHELL_COMMANDS(COMMANDSHELL_ENTRY)
+};
+
+const uint8_t CommandShell::COMMAND_SLOTS[COMMANDSHELL_SLOT_COUNT] = {
+    CommandShell_Slot<0U>::VALUE, CommandShell_Slot<1U>::VALUE, CommandShell_Slot<2U>::VALUE, CommandShell_Slot<3U>::VALUE,
+    CommandShell_Slot<4U>::VALUE, CommandShell_Slot<5U>::VALUE, CommandShell_Slot<6U>::VALUE, CommandShell_Slot<7U>::VALUE
+};
+ASSERT_COMPILER(COMMANDSHELL_SLOT_COUNT == 8U);
+
+char_t CommandShell::line[CommandShell::MAX_LINE_LENGTH];
+uint32_t CommandShell::lineLength = 0U;
+uint32_t CommandShell::nameLength = 0U;
+uint32_t CommandShell::argumentLength = 0U;
+bool CommandShell::isDiscarding = false;
+uint8_t CommandShell::previousByte = 0U;
+uint32_t CommandShell::runningCommand = CommandShell::COMMAND_IDLE;
+uint32_t CommandShell::runningStep = 0U;
+CommandShell::Statistics CommandShell::statistics = { 0U, 0U, 0U };
+
+CommandShell::Output::Output(uint8_t* const pBuffer, const uint32_t capacity) :
+    pBuffer(pBuffer),
+    capacity(capacity),
+    length(0U) {
+}
+
+void CommandShell::Output::appendByte(const uint8_t value) {
+    if (length < capacity) {
+        pBuffer[length] = value;
+        ++length;
+    }
+}
+
+void CommandShell::Output::appendText(const char_t* pText) {
+    while (*pText != '\0') {
+        appendByte((uint8_t)*pText);
+        ++pText;
+    }
+}
+
+void CommandShell::Output::appendDecimal(const uint32_t value) {
+    // 10 digits of 2^32 - 1, the lowest digit first
+    uint8_t digits[10];
+    uint32_t count = 0U;
+    uint32_t remaining = value;
+    do {
+        digits[count] = (uint8_t)('0' + (remaining % 10U));
+        remaining /= 10U;
+        ++count;
+    } while (remaining != 0U);
+    while (count != 0U) {
+        --count;
+        appendByte(digits[count]);
+    }
+}
+
+void CommandShell::Output::appendHex(const uint32_t value) {
+    static const char_t HEX_DIGITS[] = "0123456789ABCDEF";
+    appendText("0x");
+    for (uint32_t shift = 32U; shift != 0U; shift -= 4U) {
+        appendByte((uint8_t)HEX_DIGITS[(value >> (shift - 4U)) & 0x0FU]);
+    }
+}
+
+void CommandShell::Output::appendField(const char_t* const pName, const uint32_t value) {
+    appendByte(ASCII_SPACE);
+    appendText(pName);
+    appendByte((uint8_t)'=');
+    appendDecimal(value);
+}
+
+void CommandShell::Output::appendSignedField(const char_t* const pName, const int32_t value) {
+    appendByte(ASCII_SPACE);
+    appendText(pName);
+    appendByte((uint8_t)'=');
+    if (value < 0) {
+        appendByte((uint8_t)'-');
+        // two's complement magnitude, also of the most negative value
+        appendDecimal(0U - (uint32_t)value);
+    }
+    else {
+        appendDecimal((uint32_t)value);
+    }
+}
+
+void CommandShell::Output::appendHexField(const char_t* const pName, const uint32_t value) {
+    appendByte(ASCII_SPACE);
+    appendText(pName);
+    appendByte((uint8_t)'=');
+    appendHex(value);
+}
+
+void CommandShell::init(void) {
+    lineLength = 0U;
+    nameLength = 0U;
+    argumentLength = 0U;
+    isDiscarding = false;
+    previousByte = 0U;
+    runningCommand = COMMAND_IDLE;
+    runningStep = 0U;
+    statistics.Lines = 0U;
+    statistics.UnknownCommands = 0U;
+    statistics.DroppedLines = 0U;
+    // the characters of the command table match the names
+    for (uint32_t index = 0U; index < (uint32_t)CommandShell_Count; ++index) {
+        const Command& command = COMMANDS[index];
+        const uint32_t slot = COMMANDSHELL_HASH(command.pName[0], command.pName[command.NameLength - 1U], command.NameLength);
+        ASSERT_DEBUG(COMMAND_SLOTS[slot] == (index + 1U));
+    }
+}
+
+void CommandShell::put(const uint8_t* const pData, const uint32_t size) {
+    if ((pData == NULL) && (size != 0U)) {
+        ASSERT_DEBUG(false);
+        return;
+    }
+    for (uint32_t index = 0U; index < size; ++index) {
+        const uint8_t value = pData[index];
+        if ((value == ASCII_CR) || (value == ASCII_LF)) {
+            // CR LF ends one line
+            if ((value != ASCII_LF) || (previousByte != ASCII_CR)) {
+                endLine();
+            }
+        }
+        else if (value == FRAMING_DELIMITER) {
+            // end of a frame: the next line starts clean
+            lineLength = 0U;
+            nameLength = 0U;
+            argumentLength = 0U;
+            isDiscarding = false;
+        }
+        else if (isDiscarding) {
+            // skip up to the line end
+        }
+        else if ((value == ASCII_BACKSPACE) || (value == ASCII_DELETE)) {
+            if (lineLength != 0U) {
+                --lineLength;
+                if ((nameLength != 0U) && (lineLength == nameLength)) {
+                    // the separator after the name is removed, the name is entered again
+                    nameLength = 0U;
+                }
+                else if ((nameLength != 0U) && (line[lineLength] != ' ')) {
+                    --argumentLength;
+                }
+                else {
+                    // character of the name or a space
+                }
+            }
+        }
+        else if ((value < ASCII_SPACE) || (value > ASCII_TILDE)) {
+            // binary data
+            isDiscarding = true;
+        }
+        else if ((value == ASCII_SPACE) && (lineLength == 0U)) {
+            // leading space
+        }
+        else if (lineLength == MAX_LINE_LENGTH) {
+            isDiscarding = true;
+            ++statistics.DroppedLines;
+        }
+        else {
+            if (value == ASCII_SPACE) {
+                if (nameLength == 0U) {
+                    nameLength = lineLength;
+                }
+            }
+            else if (nameLength != 0U) {
+                ++argumentLength;
+            }
+            else {
+                // character of the name
+            }
+            line[lineLength] = (char_t)value;
+            ++lineLength;
+        }
+        previousByte = value;
+    }
+}
+
+void CommandShell::endLine(void) {
+    if (isDiscarding) {
+        isDiscarding = false;
+    }
+    else if (runningCommand != COMMAND_IDLE) {
+        if (lineLength != 0U) {
+            ++statistics.DroppedLines;
+        }
+    }
+    else {
+        runningCommand = lookUp();
+        runningStep = 0U;
+        if (runningCommand != COMMAND_NONE) {
+            ++statistics.Lines;
+        }
+        if (runningCommand == COMMAND_UNKNOWN) {
+            ++statistics.UnknownCommands;
+        }
+    }
+    lineLength = 0U;
+    nameLength = 0U;
+    argumentLength = 0U;
+}
+
+uint32_t CommandShell::lookUp(void) {
+    if (lineLength == 0U) {
+        return COMMAND_NONE;
+    }
+    if (argumentLength != 0U) {
+        return COMMAND_UNKNOWN;
+    }
+    const uint32_t length = (nameLength != 0U) ? nameLength : lineLength;
+    const uint32_t slot = COMMANDSHELL_HASH(line[0], line[length - 1U], length);
+    const uint32_t entry = COMMAND_SLOTS[slot];
+    if (entry == 0U) {
+        return COMMAND_UNKNOWN;
+    }
+    // a word with the same hash is not the command
+    const Command& command = COMMANDS[entry - 1U];
+    if (command.NameLength != length) {
+        return COMMAND_UNKNOWN;
+    }
+    for (uint32_t index = 0U; index < length; ++index) {
+        if (command.pName[index] != line[index]) {
+            return COMMAND_UNKNOWN;
+        }
+    }
+    return entry - 1U;
+}
+
+void CommandShell::process(void) {
+    if (runningCommand == COMMAND_IDLE) {
+        return;
+    }
+    // waiting for room does not count as a rejection of the link
+    if (!ApplicationLink::canReserveTransmit(OUTPUT_REGION_SIZE)) {
+        return;
+    }
+    uint8_t* const pRegion = ApplicationLink::reserveTransmit(OUTPUT_REGION_SIZE);
+    if (pRegion == NULL) {
+        return;
+    }
+
+    Output output(pRegion, MAX_OUTPUT_LENGTH);
+    bool isMore = false;
+    if (runningCommand == COMMAND_UNKNOWN) {
+        output.appendText("unknown command, try help");
+    }
+    else if (runningCommand != COMMAND_NONE) {
+        isMore = COMMANDS[runningCommand].handler(output, runningStep);
+    }
+    else {
+        // empty line: prompt only
+    }
+
+    Output trailer(&pRegion[output.getLength()], OUTPUT_REGION_SIZE - output.getLength());
+    if (runningCommand != COMMAND_NONE) {
+        trailer.appendText("\r\n");
+    }
+    if (isMore) {
+        ++runningStep;
+    }
+    else {
+        trailer.appendText("> ");
+        runningCommand = COMMAND_IDLE;
+    }
+    trailer.appendByte(FRAMING_DELIMITER);
+    ApplicationLink::commitTransmit(output.getLength() + trailer.getLength());
+}
+
+void CommandShell::getStatistics(Statistics* const pStatistics) {
+    if (pStatistics == NULL) {
+        ASSERT_DEBUG(false);
+        return;
+    }
+    *pStatistics = statistics;
+}
+
+bool CommandShell::runHelp(Output& output, const uint32_t step) {
+    output.appendText(COMMANDS[step].pName);
+    output.appendText(" - ");
+    output.appendText(COMMANDS[step].pHelp);
+    return (step + 1U) < (uint32_t)CommandShell_Count;
+}
+
+bool CommandShell::runStats(Output& output, const uint32_t step) {
+    switch (step) {
+        case 0U: {
+            UsartLink_Statistics link;
+            ApplicationLink::getStatistics(&link);
+            output.appendText("link");
+            output.appendField("rx", link.RxBytes);
+            output.appendField("overruns", link.RxOverruns);
+            output.appendField("tx", link.TxBytes);
+            output.appendField("rejected", link.TxRejected);
+            output.appendField("tx_max", link.TxHighWaterMark);
+            break;
+        }
+        case 1U: {
+            Framing_Statistics frames;
+            ApplicationParts::getFrameStatistics(&frames);
+            output.appendText("frames");
+            output.appendField("ok", frames.Frames);
+            output.appendField("crc", frames.CrcErrors);
+            output.appendField("sequence", frames.SequenceErrors);
+            output.appendField("overflow", frames.Overflows);
+            output.appendField("format", frames.FormatErrors);
+            break;
+        }
+        case 2U: {
+            const EventQueue& queue = ApplicationEvents::getQueue();
+            output.appendText("events");
+            output.appendField("max", EventQueue_GetHighWaterMark(&queue));
+            output.appendField("drops", EventQueue_GetDropCount(&queue));
+            output.appendField("exti_spurious", ExtiDispatcher_GetSpuriousCount());
+            break;
+        }
+        case 3U: {
+            InputCapture_Statistics capture;
+            InputCapture_GetStatistics(&capture);
+            output.appendText("capture");
+            output.appendField("periods", capture.Periods);
+            output.appendField("mhz", capture.FrequencyMilliHz);
+            output.appendField("duty_permille", capture.MeanDutyCyclePermille);
+            output.appendField("jitter", capture.PeakJitterTicks);
+            output.appendField("overruns", capture.Overruns);
+            break;
+        }
+        case 4U: {
+            CriticalSection_Statistics sections;
+            CriticalSection_GetStatistics(&sections);
+            output.appendText("critical");
+            output.appendField("sections", sections.Sections);
+            output.appendField("max_cycles", sections.MaxMaskedCycles);
+            output.appendField("ceiling", sections.MaxMaskedCeiling);
+            break;
+        }
+        case 5U: {
+            StackMonitor_Usage mainStack;
+            StackMonitor_Usage interruptStack;
+            StackMonitor_GetUsage(StackMonitor_Context_Main, &mainStack);
+            StackMonitor_GetUsage(StackMonitor_Context_Interrupt, &interruptStack);
+            output.appendText("stack");
+            output.appendField("main_max", mainStack.HighWaterMark);
+            output.appendField("main_size", mainStack.Size);
+            output.appendField("isr_max", interruptStack.HighWaterMark);
+            output.appendField("isr_size", interruptStack.Size);
+            break;
+        }
+        case 6U: {
+            ModbusRtu_Statistics modbus;
+            ModbusRtu_GetStatistics(&modbus);
+            output.appendText("modbus");
+            output.appendField("frames", modbus.Frames);
+            output.appendField("crc", modbus.CrcErrors);
+            output.appendField("gap", modbus.GapErrors);
+            output.appendField("char", modbus.CharacterErrors);
+            output.appendField("overruns", modbus.Overruns);
+            output.appendField("exceptions", modbus.Exceptions);
+            output.appendField("busy", modbus.TxBusy);
+            output.appendField("max_cycles", modbus.MaxResponseCycles);
+            break;
+        }
+        case 7U: {
+            USART_Rs485Statistics rs485;
+            USART_Rs485GetStatistics(USART_ModuleAddress_USART3, &rs485);
+            output.appendText("rs485");
+            output.appendField("tx", rs485.Transmissions);
+            output.appendField("overlaps", rs485.Overlaps);
+            output.appendField("release_cycles", rs485.LastReleaseCycles);
+            output.appendField("release_max", rs485.MaxReleaseCycles);
+            break;
+        }
+        case 8U: {
+            // actual baud rates of the dividers and their deviation from the configured rates
+            USART_BaudRateSetting link;
+            USART_BaudRateSetting modbus;
+            (void)USART_CalculateBaudRate(USARTLINK_MODULE(APPLICATION_LINK_PORT), APPLICATION_LINK_BAUDRATE, &link);
+            (void)USART_CalculateBaudRate(USART_ModuleAddress_USART3, APPLICATION_MODBUS_BAUDRATE, &modbus);
+            output.appendText("baud");
+            output.appendField("link", link.ActualBaudRate);
+            output.appendSignedField("link_ppm", link.ErrorPpm);
+            output.appendField("modbus", modbus.ActualBaudRate);
+            output.appendSignedField("modbus_ppm", modbus.ErrorPpm);
+            break;
+        }
+        case 9U: {
+            AutoBaud_Statistics autoBaud;
+            AutoBaud_GetStatistics(&autoBaud);
+            const uint32_t cyclesPerMicrosecond = RCC_GetClocksFreq().HCLK_Frequency / 1000000U;
+            output.appendText("autobaud");
+            output.appendField("running", AutoBaud_IsRunning() ? 1U : 0U);
+            output.appendField("locks", autoBaud.Locks);
+            output.appendField("baud", autoBaud.BaudRate);
+            output.appendField("measured", autoBaud.MeasuredBaudRate);
+            output.appendField("lock_us", autoBaud.LockCycles / cyclesPerMicrosecond);
+            output.appendField("skipped", autoBaud.SkippedEdges);
+            break;
+        }
+        case 10U: {
+            // receive flow control of the link: RTS state, pauses at the high watermark, maximum fill of the ring
+            UsartLink_Statistics link;
+            ApplicationLink::getStatistics(&link);
+            output.appendText("flow");
+            output.appendField("enabled", (APPLICATION_LINK_FLOW_CONTROL == 1) ? 1U : 0U);
+            output.appendField("paused", ApplicationLink::isReceivePaused() ? 1U : 0U);
+            output.appendField("pauses", link.RxPauses);
+            output.appendField("rx_max", link.RxHighWaterMark);
+            break;
+        }
+        case 11U: {
+            // memory copies: size from which the DMA copies, requests by DMA and by CPU
+            MemoryCopy_Statistics copies;
+            MemoryCopy_GetStatistics(&copies);
+            output.appendText("copy");
+            output.appendField("threshold", MemoryCopy_GetThreshold());
+            output.appendField("dma", copies.DmaRequests);
+            output.appendField("cpu", copies.CpuRequests);
+            output.appendField("full", copies.QueueFull);
+            output.appendField("errors", copies.TransferErrors);
+            output.appendField("queue_max", copies.MaxQueued);
+            break;
+        }
+        default: {
+            output.appendText("shell");
+            output.appendField("lines", statistics.Lines);
+            output.appendField("unknown", statistics.UnknownCommands);
+            output.appendField("dropped", statistics.DroppedLines);
+            break;
+        }
+    }
+    return step < 12U;
+}
+
+bool CommandShell::runParts(Output& output, const uint32_t step) {
+    // few parts: walking the list per line is cheaper than keeping a position
+    const ActivePart* pPart = RuntimeCore::getFirstPart();
+    for (uint32_t index = 0U; (index < step) && (pPart != NULL); ++index) {
+        pPart = pPart->getNext();
+    }
+    if (pPart == NULL) {
+        output.appendText("no parts");
+        return false;
+    }
+    const ActivePart::Profile& profile = pPart->getProfile();
+    output.appendText(pPart->getName());
+    output.appendField("prio", pPart->getPriority());
+    output.appendField("msgs", profile.Messages);
+    output.appendField("max", profile.MaxTicks);
+    output.appendField("latency", profile.MaxLatencyTicks);
+    output.appendField("drops", profile.Drops);
+    output.appendField("queue", profile.QueueHighWaterMark);
+    return pPart->getNext() != NULL;
+}
+
+bool CommandShell::runTimer(Output& output, const uint32_t step) {
+    if (step == 0U) {
+        output.appendText("timebase");
+        output.appendField("us", TimeBase_GetMicroseconds());
+        return true;
+    }
+    TimerApp::State state;
+    TimerApp::getState(&state);
+    output.appendText("pattern");
+    output.appendField("index", ApplicationParts::getPatternIndex());
+    output.appendField("steps", state.Steps);
+    output.appendField("length_ms", state.LengthMs);
+    output.appendField("position_ms", state.PositionMs);
+    return false;
+}
+
+bool CommandShell::runFaults(Output& output, const uint32_t step) {
+    const uint32_t count = FaultRecord_GetCount();
+    const uint32_t stored = (count < FAULTRECORD_MAX_RECORDS) ? count : FAULTRECORD_MAX_RECORDS;
+    if (step == 0U) {
+        output.appendText("faults");
+        output.appendField("count", count);
+        output.appendField("stored", stored);
+        return stored != 0U;
+    }
+    const uint32_t index = (step - 1U) / FAULT_RECORD_LINES;
+    FaultRecord record;
+    if (!FaultRecord_Get(index, &record)) {
+        // cleared while the output was running
+        output.appendText("cleared");
+        return false;
+    }
+    switch ((step - 1U) % FAULT_RECORD_LINES) {
+        case 0U:
+            output.appendByte((uint8_t)'#');
+            output.appendDecimal(index);
+            output.appendField("exception", record.Exception);
+            output.appendHexField("pc", record.PC);
+            output.appendHexField("lr", record.LR);
+            output.appendHexField("xpsr", record.XPSR);
+            output.appendHexField("exc_return", record.ExcReturn);
+            break;
+        case 1U:
+            output.appendText(" ");
+            output.appendHexField("cfsr", record.CFSR);
+            output.appendHexField("hfsr", record.HFSR);
+            output.appendHexField("mmfar", record.MMFAR);
+            output.appendHexField("bfar", record.BFAR);
+            output.appendField("cycles", record.Cycles);
+            break;
+        default:
+            output.appendText(" ");
+            output.appendHexField("r0", record.R0);
+            output.appendHexField("r1", record.R1);
+            output.appendHexField("r2", record.R2);
+            output.appendHexField("r3", record.R3);
+            output.appendHexField("r12", record.R12);
+            break;
+    }
+    return step < (stored * FAULT_RECORD_LINES);
+}
+
+bool CommandShell::runClear(Output& output, const uint32_t step) {
+    (void)step;
+    ApplicationLink::resetStatistics();
+    ApplicationParts::resetFrameStatistics();
+    InputCapture_ResetStatistics();
+    ModbusRtu_ResetStatistics();
+    AutoBaud_ResetStatistics();
+    MemoryCopy_ResetStatistics();
+    USART_Rs485ResetStatistics(USART_ModuleAddress_USART3);
+    CriticalSection_ResetStatistics();
+    for (ActivePart* pPart = RuntimeCore::getFirstPart(); pPart != NULL; pPart = pPart->getNext()) {
+        pPart->resetProfile();
+    }
+    FaultRecord_Clear();
+    statistics.Lines = 0U;
+    statistics.UnknownCommands = 0U;
+    statistics.DroppedLines = 0U;
+    output.appendText("cleared");
+    return false;
+}
+
+bool CommandShell::runBaudDetect(Output& output, const uint32_t step) {
+    (void)step;
+    // the line goes out at the old rate before the host switches, the lock only changes the divider
+    UsartHandler::startAutoBaud();
+    output.appendText("send 0x55 ('U') at the new baud rate");
+    return false;
+}
+
+bool CommandShell::runTiming(Output& output, const uint32_t step) {
+    BenchmarkApp::Results results;
+    BenchmarkApp::getResults(&results);
+    switch (step) {
+        case 0U:
+            output.appendText("boot");
+            output.appendField("lowlevel", Startup_GetMilestoneCycles(Startup_Milestone_LowLevelInit));
+            output.appendField("main", Startup_GetMilestoneCycles(Startup_Milestone_Main));
+            output.appendField("interrupts", Startup_GetMilestoneCycles(Startup_Milestone_InterruptsEnabled));
+            break;
+        case 1U:
+            output.appendText("dispatch");
+            output.appendField("flash", results.DispatchLatency.FlashCycles);
+            output.appendField("ram", results.DispatchLatency.RamCycles);
+            break;
+        case 2U:
+            output.appendText("ramcode");
+            output.appendField("bytes", RAMCODE_BENCHMARK_MAX_SIZE);
+            output.appendField("flash", results.RamCodeCopy.FlashCycles);
+            output.appendField("ram", results.RamCodeCopy.RamCycles);
+            break;
+        case 3U:
+            output.appendText("crc");
+            output.appendField("bytes", results.CrcFlash.Size);
+            output.appendField("cpu", results.CrcFlash.HardwareCycles);
+            output.appendField("dma", results.CrcFlash.DmaCycles);
+            output.appendField("software", results.CrcFlash.SoftwareCycles);
+            break;
+        case 4U:
+            output.appendText("eventqueue");
+            output.appendField("post", results.EventQueue.PostCycles);
+            output.appendField("drain", results.EventQueue.DrainCycles);
+            break;
+        default:
+            output.appendText("framing");
+            output.appendField("bytes", results.Framing.Size);
+            output.appendField("encode_per_byte", results.Framing.EncodeCyclesPerByte);
+            output.appendField("decode_per_byte", results.Framing.DecodeCyclesPerByte);
+            break;
+    }
+    return step < 5U;
+}
+
+} // namespace blinky
@@ -0,0 +1,235 @@
+// (c) IMT - Information Management Technology AG, CH-9470 Buchs, www.imt.ch.
+// SW guideline: Technote Coding Guidelines Ver. 1.5.1
+
+#ifndef COMMANDSHELL_H
+#define COMMANDSHELL_H
+
+// Must be very first include
+#include <Imt.Base.Core.Platform/Platform.h>
+
+namespace blinky {
+
+//@{
+// Line oriented command shell on the USART link (@see SystemUsartLink.h) to read out a unit in the field.
+// - Input: put parses the received bytes incrementally as they arrive, the USART part passes the same chunks to the frame
+//   decoder (@see ApplicationParts.h). A line ends with CR or LF, backspace removes the last character. A line with any
+//   other non-printable byte is part of a binary frame and is dropped silently up to the next line end or frame delimiter.
+// - Lookup: at the line end the command is found in constant time by a perfect hash of the first and last character and
+//   the length of its name. The slot table is generated at compile time, command names with the same hash do not compile.
+// - Output: a command handler writes one output line per call directly into a region of the transmit ring. process writes
+//   the next line only if the ring has room for it: a long output is spread over many main loop passes and never waits
+//   for the link. Each output ends with the frame delimiter, so a frame receiver on the link drops it as one bad frame.
+//
+// Commands: help, stats (link, frames, events, capture, critical sections, baud rates, flow control, copies),
+// parts (profiles), timer, faults, clear, bauddetect (auto-baud of the link), timing (boot milestones and HAL benchmarks, @see BenchmarkApp.h).
+//@}
+class CommandShell {
+
+public:
+
+    // Maximum length of an input line, longer lines are dropped
+    static const uint32_t MAX_LINE_LENGTH = 32U;
+
+    // Maximum length of an output line, longer output is truncated
+    static const uint32_t MAX_OUTPUT_LENGTH = 96U;
+
+    //@{
+    // Shell statistics since the last reset
+    //@}
+    struct Statistics {
+        // Lines executed, including unknown commands
+        uint32_t Lines;
+        // Lines with an unknown command or with arguments
+        uint32_t UnknownCommands;
+        // Lines received while a command was running or longer than MAX_LINE_LENGTH
+        uint32_t DroppedLines;
+    };
+
+    //@{
+    // Reset the parser and the statistics.
+    //@}
+    static void init(void);
+
+    //@{
+    // Parse received bytes, a complete line starts its command.
+    // @param pData: Received bytes.
+    // @param size: Number of bytes.
+    //@}
+    static void put(const uint8_t* const pData, const uint32_t size);
+
+    //@{
+    // Write the next output line of the running command if the transmit ring has room, call it from the main loop.
+    //@}
+    static void process(void);
+
+    //@{
+    // Copy the statistics.
+    // @param pStatistics: Pointer to the Statistics structure to fill.
+    //@}
+    static void getStatistics(Statistics* const pStatistics);
+
+private:
+
+    //@{
+    // Text output into a region of the transmit ring, truncated at the capacity
+    //@}
+    class Output {
+
+    public:
+
+        //@{
+        // Constructor.
+        // @param pBuffer: Output memory.
+        // @param capacity: Size of the output memory.
+        //@}
+        Output(uint8_t* const pBuffer, const uint32_t capacity);
+
+        //@{
+        // Append a zero terminated text.
+        //@}
+        void appendText(const char_t* pText);
+
+        //@{
+        // Append a number as decimal.
+        //@}
+        void appendDecimal(const uint32_t value);
+
+        //@{
+        // Append a number as 8 hexadecimal digits with the prefix 0x.
+        //@}
+        void appendHex(const uint32_t value);
+
+        //@{
+        // Append " name=value" with the value as decimal.
+        //@}
+        void appendField(const char_t* const pName, const uint32_t value);
+
+        //@{
+        // Append " name=value" with the value as signed decimal.
+        //@}
+        void appendSignedField(const char_t* const pName, const int32_t value);
+
+        //@{
+        // Append " name=0x..." with the value as hexadecimal.
+        //@}
+        void appendHexField(const char_t* const pName, const uint32_t value);
+
+        //@{
+        // Append one byte.
+        //@}
+        void appendByte(const uint8_t value);
+
+        //@{
+        // Returns the number of bytes written.
+        //@}
+        uint32_t getLength(void) const {
+            return length;
+        }
+
+    private:
+
+        //@{
+        // Provide the private copy constructor so the compiler does not generate the default one.
+        //@}
+        Output(const Output& other);
+
+        //@{
+        // Provide the private assignment operator so the compiler does not generate the default one.
+        //@}
+        Output& operator=(const Output& other);
+
+        uint8_t* const pBuffer;
+        const uint32_t capacity;
+        uint32_t length;
+    };
+
+    //@{
+    // Command handler, writes one output line without the line end.
+    // @param output: Output of the line.
+    // @param step: Line number, 0 for the first call of a command.
+    // @return bool: true if more lines follow
+    //@}
+    typedef bool (*Handler)(Output& output, const uint32_t step);
+
+    //@{
+    // Command table entry
+    //@}
+    struct Command {
+        const char_t* pName;
+        uint32_t NameLength;
+        Handler handler;
+        const char_t* pHelp;
+    };
+
+    //@{
+    // Command handlers.
+    //@}
+    static bool runHelp(Output& output, const uint32_t step);
+    static bool runStats(Output& output, const uint32_t step);
+    static bool runParts(Output& output, const uint32_t step);
+    static bool runTimer(Output& output, const uint32_t step);
+    static bool runFaults(Output& output, const uint32_t step);
+    static bool runClear(Output& output, const uint32_t step);
+    static bool runBaudDetect(Output& output, const uint32_t step);
+    static bool runTiming(Output& output, const uint32_t step);
+
+    //@{
+    // Look up the command of the line, called at the line end.
+    // @return uint32_t: Command index, COMMAND_UNKNOWN or COMMAND_NONE for an empty line
+    //@}
+    static uint32_t lookUp(void);
+
+    //@{
+    // Handle the end of a line.
+    //@}
+    static void endLine(void);
+
+    //@{
+    // Constructor.
+    //@}
+    explicit CommandShell();
+
+    //@{
+    // Destructor.
+    //@}
+    ~CommandShell();
+
+    //@{
+    // Provide the private copy constructor so the compiler does not generate the default one.
+    //@}
+    CommandShell(const CommandShell& other);
+
+    //@{
+    // Provide the private assignment operator so the compiler does not generate the default one.
+    //@}
+    CommandShell& operator=(const CommandShell& other);
+
+    // Pseudo command indices: no command running, unknown command, empty line (prompt only)
+    static const uint32_t COMMAND_IDLE = 0xFFFFFFFFU;
+    static const uint32_t COMMAND_UNKNOWN = 0xFFFFFFFEU;
+    static const uint32_t COMMAND_NONE = 0xFFFFFFFDU;
+
+    static const Command COMMANDS[];
+    static const uint8_t COMMAND_SLOTS[];
+
+    // Input line: characters, end of the command name (0 while the name is entered), argument characters after it
+    static char_t line[MAX_LINE_LENGTH];
+    static uint32_t lineLength;
+    static uint32_t nameLength;
+    static uint32_t argumentLength;
+    // Drop the bytes up to the next line end: binary data or line too long
+    static bool isDiscarding;
+    // Last received byte, a LF after CR ends no further line
+    static uint8_t previousByte;
+
+    // Running command and its next output line
+    static uint32_t runningCommand;
+    static uint32_t runningStep;
+
+    static Statistics statistics;
+};
+
+} // namespace blinky
+using blinky::CommandShell;
+
+#endif // COMMANDSHELL_H
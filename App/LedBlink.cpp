@@ -13,8 +13,24 @@
 // Imt.Base
 
 #include "LedBlink.h"
+#include "ButtonDebouncer.h"
 #include <SystemPeripherals_USART.h>
-#include "SystemPeripherals_TIM.h"
+#include "ApplicationEvents.h"
+
+// EXTI line of the user button B1 (PC13)
+static const uint32_t BUTTON_B1_EXTI_LINE = 13U;
+// Contact bounce of the user button B1 settles within this time
+static const uint32_t BUTTON_B1_SETTLE_TIME_MS = 20U;
+
+void LedBlinkHandler::init() {
+    (void)ButtonDebouncer::addInput(BUTTON_B1_EXTI_LINE, &R_USER_BUTTON_B1, BUTTON_B1_SETTLE_TIME_MS,
+                                    &LedBlinkHandler::onButtonChanged, NULL);
+}
+
+void LedBlinkHandler::onButtonChanged(void* pContext, const bool level) {
+    (void)pContext;
+    (void)ApplicationEvents::post(ApplicationEvents::TYPE_BUTTON_CHANGED, (uint16_t)BUTTON_B1_EXTI_LINE, level ? 1U : 0U);
+}
 
 
 void LedBlinkHandler::ledBlink() {
@@ -34,14 +50,8 @@ void LedBlinkHandler::Delay(uint32_t counter) {
     }
 }
 
-extern "C" void EXTI15_10_IRQHandler(void){
-    if(R_USER_BUTTON_B1 == 0x0u) {
-    
-      LedBlinkHandler::ledBlink();
-      //unsigned char txData = 0x04;
-    }
-    // Notify runtime about application ISR entry
-    EXTI_ClearITPendingBit(EXTI_Line13);
+extern "C" void SysTick_Handler(void) {
+    ButtonDebouncer::onTick();
 }
 
 
@@ -16,6 +16,16 @@
     static void ledBlink(void); 
     static void Delay(uint32_t counter) ;
 
+    //@{
+    // Register the user button B1 at the debouncer, call it before the interrupts are enabled
+    //@}
+    static void init(void);
+
+    //@{
+    // Confirmed level change of the user button B1 in the tick interrupt, posts it to the main loop (@see ApplicationParts.h)
+    //@}
+    static void onButtonChanged(void* pContext, const bool level);
+
   private:
     //@{
     // Constructor.
@@ -0,0 +1,65 @@
+// (c) IMT - Information Management Technology AG, CH-9470 Buchs, www.imt.ch.
+// SW guideline: Technote Coding Guidelines Ver. 1.5.1
+
+#include "ModbusApp.h"
+
+// Project includes
+#include "ApplicationEvents.h"
+#include "ApplicationParts.h"
+#include "ApplicationHardwareConfig.h"
+#include "SystemInputCapture.h"
+#include "SystemFaultRecord.h"
+
+namespace blinky {
+
+uint16_t ModbusApp::holdingRegisters[ModbusApp::HOLDING_COUNT];
+uint16_t ModbusApp::inputRegisters[ModbusApp::INPUT_COUNT];
+
+const ModbusRtu_RegisterRange ModbusApp::HOLDING_RANGES[] = {
+    { 0U, (uint16_t)HOLDING_COUNT, holdingRegisters, &ModbusApp::onPatternWrite, NULL }
+};
+
+const ModbusRtu_RegisterRange ModbusApp::INPUT_RANGES[] = {
+    { 0U, (uint16_t)INPUT_COUNT, inputRegisters, NULL, NULL }
+};
+
+const ModbusRtu_RegisterMap ModbusApp::REGISTER_MAP = {
+    HOLDING_RANGES, sizeof(HOLDING_RANGES) / sizeof(HOLDING_RANGES[0]),
+    INPUT_RANGES, sizeof(INPUT_RANGES) / sizeof(INPUT_RANGES[0])
+};
+
+void ModbusApp::init(void) {
+    process();
+    ModbusRtu_Config config;
+    config.SlaveAddress = SLAVE_ADDRESS;
+    config.BaudRate = APPLICATION_MODBUS_BAUDRATE;
+    config.CharacterBits = APPLICATION_MODBUS_CHARACTER_BITS;
+    config.pRegisterMap = &REGISTER_MAP;
+    ModbusRtu_Init(&config);
+}
+
+void ModbusApp::process(void) {
+    InputCapture_Statistics capture;
+    InputCapture_GetStatistics(&capture);
+    const uint32_t frequencyHz = capture.FrequencyMilliHz / 1000U;
+    const uint16_t patternIndex = (uint16_t)ApplicationParts::getPatternIndex();
+
+    // 16-bit stores, the slave reads each register consistently
+    holdingRegisters[HOLDING_PATTERN] = patternIndex;
+    inputRegisters[INPUT_PATTERN] = patternIndex;
+    inputRegisters[INPUT_CAPTURE_FREQUENCY_HZ] = (frequencyHz > 0xFFFFU) ? (uint16_t)0xFFFFU : (uint16_t)frequencyHz;
+    inputRegisters[INPUT_CAPTURE_DUTY_PERMILLE] = (uint16_t)capture.MeanDutyCyclePermille;
+    inputRegisters[INPUT_FAULT_COUNT] = (uint16_t)FaultRecord_GetCount();
+}
+
+bool ModbusApp::onPatternWrite(void* pContext, const uint16_t address, const uint16_t value) {
+    (void)pContext;
+    (void)address;
+    if (value >= TimerPart::PATTERN_COUNT) {
+        return false;
+    }
+    // a full queue rejects the write, the master sees the exception
+    return ApplicationEvents::post(ApplicationEvents::TYPE_PATTERN_SELECTED, 0U, value);
+}
+
+} // namespace blinky
@@ -0,0 +1,90 @@
+// (c) IMT - Information Management Technology AG, CH-9470 Buchs, www.imt.ch.
+// SW guideline: Technote Coding Guidelines Ver. 1.5.1
+
+#ifndef MODBUSAPP_H
+#define MODBUSAPP_H
+
+// Must be very first include
+#include <Imt.Base.Core.Platform/Platform.h>
+
+// Project includes
+#include "SystemModbusRtu.h"
+
+namespace blinky {
+
+//@{
+// Register map of the Modbus RTU slave on USART3 (@see SystemModbusRtu.h), slave address 1, 8E1.
+// Holding register 0: LED pattern, a write selects the pattern (posted to the timer part, @see ApplicationParts.h).
+// Input registers 0..3: running LED pattern, frequency of the input capture in Hz, mean duty cycle in 1/1000,
+// number of fault records. The main loop copies the values into the registers, the slave reads them in the interrupt.
+//@}
+class ModbusApp {
+
+public:
+
+    // Slave address
+    static const uint8_t SLAVE_ADDRESS = 1U;
+
+    //@{
+    // Register addresses
+    //@}
+    enum HoldingRegister {
+        HOLDING_PATTERN,
+        HOLDING_COUNT
+    };
+    enum InputRegister {
+        INPUT_PATTERN,
+        INPUT_CAPTURE_FREQUENCY_HZ,
+        INPUT_CAPTURE_DUTY_PERMILLE,
+        INPUT_FAULT_COUNT,
+        INPUT_COUNT
+    };
+
+    //@{
+    // Start the slave, call it before the interrupts are enabled.
+    //@}
+    static void init(void);
+
+    //@{
+    // Update the register values, call it from the main loop.
+    //@}
+    static void process(void);
+
+private:
+
+    //@{
+    // Write handler of the pattern register: posts the selection to the main loop.
+    //@}
+    static bool onPatternWrite(void* pContext, const uint16_t address, const uint16_t value);
+
+    //@{
+    // Constructor.
+    //@}
+    explicit ModbusApp();
+
+    //@{
+    // Destructor.
+    //@}
+    ~ModbusApp();
+
+    //@{
+    // Provide the private copy constructor so the compiler does not generate the default one.
+    //@}
+    ModbusApp(const ModbusApp& other);
+
+    //@{
+    // Provide the private assignment operator so the compiler does not generate the default one.
+    //@}
+    ModbusApp& operator=(const ModbusApp& other);
+
+    static uint16_t holdingRegisters[HOLDING_COUNT];
+    static uint16_t inputRegisters[INPUT_COUNT];
+    static const ModbusRtu_RegisterRange HOLDING_RANGES[];
+    static const ModbusRtu_RegisterRange INPUT_RANGES[];
+    static const ModbusRtu_RegisterMap REGISTER_MAP;
+};
+
+} // namespace blinky
+using blinky::ModbusApp;
+
+#endif // MODBUSAPP_H
@@ -1,26 +1,124 @@
-// (c) IMT - Information Management Technology AG, CH-9470 Buchs, www.imt.ch. 
-// Dev. System:  Microsoft Visual 2008
-// SW guideline: SOP-Coding Guidelines Ver. 1.1
-// $Author:  $
-// $Revision:  $
-// $Modtime:  $
-// $Archive:  $
-#include "SystemPeripherals_TIM.h"
+// (c) IMT - Information Management Technology AG, CH-9470 Buchs, www.imt.ch.
+// SW guideline: Technote Coding Guidelines Ver. 1.4
+
 #include "TimerApp.h"
 
+// Project includes
+#include "SystemPeripherals_TIM.h"
+#include "SystemPeripherals_DMA.h"
+
+// Imt.Base includes
+#include <Imt.Base.Core.Diagnostics/Diagnostics.h>
+
+// Timer and channel of the LED pin PA5
+static const TIM_ModuleAddress LED_TIMER = TIM_ModuleAddress_TIM2;
+static const TIM_Channel LED_TIMER_CHANNEL = TIM_Channel1;
 
+namespace blinky {
+
+uint16_t TimerApp::compareTable[TimerApp::MAX_PATTERN_STEPS];
+uint32_t TimerApp::patternSteps = 0U;
+uint32_t TimerApp::patternLengthMs = 0U;
+
+bool TimerApp::startPattern(const uint16_t* const pDurationsMs, const uint32_t count) {
+    if ((pDurationsMs == NULL) || (count == 0U) || (count > MAX_PATTERN_STEPS)) {
+        ASSERT_DEBUG(false);
+        return false;
+    }
+    uint32_t lengthMs = 0U;
+    for (uint32_t i = 0U; i < count; ++i) {
+        if (pDurationsMs[i] == 0U) {
+            ASSERT_DEBUG(false);
+            return false;
+        }
+        lengthMs += pDurationsMs[i];
+    }
+    if (lengthMs > MAX_PATTERN_LENGTH_MS) {
+        ASSERT_DEBUG(false);
+        return false;
+    }
 
+    stop();
 
-extern "C" void TIM2_IRQHandler(void) {
-  TIM_ClearPendingInterrupt(TIM_ModuleAddress_TIM2,TIM_IrqFlag_UpdateInterrupt);
-  if(R_LED_STAT) {
-        W_LED_STAT = 0;
-      //  LedBlinkHandler::Delay(850000);
+    // The toggle of step i is at the end of its duration. The last toggle is at the end of the period,
+    // which is the compare value 0 of the next round. CCR1 holds the compare value of step 0,
+    // each match loads the following one: the table starts with step 1 and ends with step 0.
+    const uint32_t periodTicks = lengthMs * TICKS_PER_MS;
+    uint32_t endTicks = 0U;
+    uint16_t firstCompareValue = 0U;
+    for (uint32_t i = 0U; i < count; ++i) {
+        endTicks += (uint32_t)pDurationsMs[i] * TICKS_PER_MS;
+        const uint16_t compareValue = (uint16_t)(endTicks % periodTicks);
+        if (i == 0U) {
+            firstCompareValue = compareValue;
+        }
+        else {
+            compareTable[i - 1U] = compareValue;
+        }
     }
-    else {
-        W_LED_STAT = 1;
-      // LedBlinkHandler::Delay(500000);
+    compareTable[count - 1U] = firstCompareValue;
+
+    // Time base: counter restarts at the end of the pattern
+    TIM_TimeBaseInitStruct timeBase;
+    timeBase.Prescaler = (uint16_t)((TIM_GetInputClockFrequency(LED_TIMER) / (1000U * TICKS_PER_MS)) - 1U);
+    timeBase.CounterMode = TIM_CounterModeUp;
+    timeBase.Period = (uint16_t)(periodTicks - 1U);
+    TIM_TimeBaseInit(LED_TIMER, &timeBase);
+
+    // LED on at the start, then toggle on every match
+    TIM_OCInitStruct outputCompare;
+    outputCompare.OCMode = TIM_OCMode_ForceActive;
+    outputCompare.CaptureCompareEnable = true;
+    outputCompare.CaptureCompareValue = firstCompareValue;
+    outputCompare.OutputPolarity = TIM_OCPolarity_ActiveHigh;
+    TIM_OCInit(LED_TIMER, LED_TIMER_CHANNEL, &outputCompare);
+    outputCompare.OCMode = TIM_OCMode_Toggle;
+    TIM_OCInit(LED_TIMER, LED_TIMER_CHANNEL, &outputCompare);
+    // The value written by the DMA is the next compare value immediately
+    TIM_OCPreloadConfig(LED_TIMER, LED_TIMER_CHANNEL, TIM_OCPreloadState_Disable);
+
+    DMA_InitStruct dmaInit;
+    dmaInit.PeripheralBaseAddr = TIM_GetCompareRegisterAddress(LED_TIMER, LED_TIMER_CHANNEL);
+    dmaInit.MemoryBaseAddr = (uint32_t)&compareTable[0]; //lint !e923 cast from pointer to int [MISRA C++ Rule 5-2-9]. Justification: DMA address register
+    dmaInit.DIR = DMA_DIR_PeripheralDST;
+    dmaInit.BufferSize = count;
+    dmaInit.PeripheralInc = DMA_PeripheralInc_Disable;
+    dmaInit.MemoryInc = DMA_MemoryInc_Enable;
+    dmaInit.PeripheralDataSize = DMA_PeripheralDataSize_HalfWord;
+    dmaInit.MemoryDataSize = DMA_MemoryDataSize_HalfWord;
+    dmaInit.Mode = DMA_Mode_Circular;
+    dmaInit.Priority = DMA_Priority_Low;
+    dmaInit.M2M = DMA_M2M_Disable;
+    DMA_Init(LED_DMA_CHANNEL, &dmaInit);
+    DMA_Enable(LED_DMA_CHANNEL, true);
+
+    TIM_EnableDmaRequest(LED_TIMER, TIM_DmaRequest_CaptureCompare1, true);
+    TIM_Enable(LED_TIMER, true);
+    patternSteps = count;
+    patternLengthMs = lengthMs;
+    return true;
+}
+
+bool TimerApp::startBlink(const uint16_t onTimeMs, const uint16_t offTimeMs) {
+    const uint16_t durationsMs[2] = { onTimeMs, offTimeMs };
+    return startPattern(durationsMs, 2U);
+}
+
+void TimerApp::stop(void) {
+    TIM_Enable(LED_TIMER, false);
+    TIM_EnableDmaRequest(LED_TIMER, TIM_DmaRequest_CaptureCompare1, false);
+    DMA_Enable(LED_DMA_CHANNEL, false);
+    patternSteps = 0U;
+}
+
+void TimerApp::getState(State* const pState) {
+    if (pState == NULL) {
+        ASSERT_DEBUG(false);
+        return;
     }
- } 
- 
-    
\ No newline at end of file
+    pState->Steps = patternSteps;
+    pState->LengthMs = (patternSteps != 0U) ? patternLengthMs : 0U;
+    pState->PositionMs = (patternSteps != 0U) ? ((uint32_t)TIM_GetCounter(LED_TIMER) / TICKS_PER_MS) : 0U;
+}
+
+} // namespace blinky
@@ -1,37 +1,111 @@
-// (c) IMT - Information Management Technology AG, CH-9470 Buchs, www.imt.ch. 
+// (c) IMT - Information Management Technology AG, CH-9470 Buchs, www.imt.ch.
 // SW guideline: Technote Coding Guidelines Ver. 1.4
 
 #ifndef TIMERAPP_H
 #define TIMERAPP_H
 
+// Must be very first include
+#include <Imt.Base.Core.Platform/Platform.h>
 
-#include "types.h"
-#include "ApplicationHardwareConfig.h"
-#include "SystemPeripherals_EXTI.h"
+// Project includes
+#include "SystemPeripherals_DMA.h"
 
-//namespace blinky {
-  
-  class LedBlinkHandler {
-  public:  
-    static void ledBlink(void); 
-    static void Delay(uint32_t counter) ;
+namespace blinky {
+
+//@{
+// LED pattern on PA5 (LD2) generated by the output compare of TIM2 channel 1, without any interrupt.
+// The channel runs in toggle mode, the counter period is the pattern length. On every compare match the pin toggles
+// and the CC1 DMA request (DMA1 Channel5, circular) loads the next compare value from a table into CCR1.
+// So the CPU only writes the table and configures the timer once, the pattern repeats by hardware.
+// PA5 must be configured as alternate function output and the clocks of TIM2 and DMA1 must be enabled.
+//@}
+class TimerApp {
+
+public:
+
+    // Maximum number of steps (toggles) of a pattern
+    static const uint32_t MAX_PATTERN_STEPS = 32U;
+
+    // Counter ticks per millisecond: keeps the prescaler within 16 bits up to a 72MHz timer clock
+    static const uint32_t TICKS_PER_MS = 2U;
+
+    // Maximum length of a pattern (sum of the step durations): one counter period
+    static const uint32_t MAX_PATTERN_LENGTH_MS = 0xFFFFU / TICKS_PER_MS;
+
+    // DMA channel of the TIM2_CH1 request, also the receive channel of USART1
+    static const DMA_ChannelAddress LED_DMA_CHANNEL = DMA_ChannelAddress_DMA1_Channel5;
+
+    //@{
+    // State of the pattern
+    //@}
+    struct State {
+        // Number of steps, 0 if stopped
+        uint32_t Steps;
+        // Length of the pattern
+        uint32_t LengthMs;
+        // Time since the start of the current round
+        uint32_t PositionMs;
+    };
+
+    //@{
+    // Start a pattern, a running pattern is replaced.
+    // The LED is switched on at the start, each step toggles it after its duration: the durations
+    // are on, off, on, ... times. With an odd number of steps the levels are inverted every second round.
+    // @param pDurationsMs: Step durations in milliseconds, each at least 1ms.
+    // @param count: Number of steps, 1..MAX_PATTERN_STEPS.
+    // @return bool: false if a parameter is invalid or the pattern is longer than MAX_PATTERN_LENGTH_MS
+    //@}
+    static bool startPattern(const uint16_t* const pDurationsMs, const uint32_t count);
+
+    //@{
+    // Start a symmetric or asymmetric blinking, a running pattern is replaced.
+    // @param onTimeMs: LED on time in milliseconds.
+    // @param offTimeMs: LED off time in milliseconds.
+    // @return bool: false if a time is invalid
+    //@}
+    static bool startBlink(const uint16_t onTimeMs, const uint16_t offTimeMs);
+
+    //@{
+    // Stop the pattern, the LED keeps its current level.
+    //@}
+    static void stop(void);
+
+    //@{
+    // Copy the state of the pattern.
+    // @param pState: Pointer to the State structure to fill.
+    //@}
+    static void getState(State* const pState);
+
+private:
 
-  private:
     //@{
     // Constructor.
     //@}
-//    explicit LedBlinkHandler();
+    explicit TimerApp();
 
     //@{
     // Destructor.
     //@}
-  //  virtual ~LedBlinkHandler();
-    
-  };
-//}
-//using blinky::LedBlinkHandler;
+    ~TimerApp();
+
+    //@{
+    // Provide the private copy constructor so the compiler does not generate the default one.
+    //@}
+    TimerApp(const TimerApp& other);
 
+    //@{
+    // Provide the private assignment operator so the compiler does not generate the default one.
+    //@}
+    TimerApp& operator=(const TimerApp& other);
 
+    // Compare values of the steps 1..n-1 and 0, read by the DMA in a circle
+    static uint16_t compareTable[MAX_PATTERN_STEPS];
+    // Steps and length of the running pattern
+    static uint32_t patternSteps;
+    static uint32_t patternLengthMs;
+};
 
-#endif // #ifndef TIMERAPP
+} // namespace blinky
+using blinky::TimerApp;
 
+#endif // #ifndef TIMERAPP_H
@@ -8,32 +8,49 @@
 
 
 
-#include <SystemPeripherals_USART.h>
 #include "UsartApp.h"
+#include "ApplicationEvents.h"
+#include "SystemAutoBaud.h"
+#include "SystemRamCode.h"
+
+// standard baud rates of the hosts, the detected rate snaps to them
+static const uint32_t AUTOBAUD_RATES[] = { 9600U, 19200U, 38400U, 57600U, 115200U };
+
+// the received bytes are written by DMA into the ring of the link and decoded by the USART part (@see ApplicationParts.h)
+
+void UsartHandler::init(void) {
+    ApplicationLink::init(&UsartHandler::onReceived);
+#if (APPLICATION_LINK_FLOW_CONTROL == 1)
+    ApplicationLink::enableFlowControl(APPLICATION_LINK_RX_HIGH_WATERMARK, APPLICATION_LINK_RX_LOW_WATERMARK);
+#endif
+#if (APPLICATION_LINK_AUTOBAUD == 1)
+    startAutoBaud();
+#endif
+}
 
-static uint8_t rxData[20],rxIndex = 0;
-
-
-
+void UsartHandler::startAutoBaud(void) {
+    AutoBaud_Config config;
+    config.Usart = USARTLINK_MODULE(APPLICATION_LINK_PORT);
+    config.RxPortSource = ApplicationLink::Port::RX_PORT_SOURCE;
+    config.RxPinSource = ApplicationLink::Port::RX_PIN_SOURCE;
+    config.pBaudRates = AUTOBAUD_RATES;
+    config.BaudRateCount = sizeof(AUTOBAUD_RATES) / sizeof(AUTOBAUD_RATES[0]);
+    config.Notification = NULL;
+    AutoBaud_Start(&config);
+}
 
+void UsartHandler::onReceived(void) {
+    (void)ApplicationEvents::post(ApplicationEvents::TYPE_USART_RECEIVED, 0U, 0U);
+}
 
-extern "C" void USART2_IRQHandler(void) {
-    uint8_t data;
-   // RuntimeInterrupts::applicationIsrEntry();
-   /*
-    while(!USART_IsTransmitDataRegisterEmpty(USART_ModuleAddress_USART2)){};
-     USART_SendData(USART_ModuleAddress_USART2, 0x55); */
-    if(USART_IsReadDataRegisterNotEmpty(USART_ModuleAddress_USART2)) {
-        data = USART_ReceiveData(USART_ModuleAddress_USART2);
-        
-            rxData[rxIndex++]= data;
-        if(rxIndex==20) { 
-          rxIndex = 0; 
-          
-        }
+// interrupt handlers of the link port (overwrite the weak definitions of vector_table_M.s): idle line after received bytes,
+// receive ring half/full and transmit complete, the bytes themselves are copied by DMA. The handlers run from SRAM with
+// the inlined link functions (@see SystemRamCode.h).
+#define USARTAPP_HANDLER(Link, irqNumber, handler, function) \
+    extern "C" SYSTEM_RAMFUNC void handler(void) {          \
+        Link::function();                                   \
     }
-   // RuntimeInterrupts::applicationIsrExit();
-}
+USARTLINK_INTERRUPTS(APPLICATION_LINK_PORT, USARTAPP_HANDLER, ApplicationLink)
 
 
     
\ No newline at end of file
@@ -13,8 +13,21 @@
   
   class UsartHandler {
   public:  
-   // static void ledBlink(void); 
-   // static void Delay(uint32_t counter) ;
+    //@{
+    // Start the DMA link of the link port (@see ApplicationHardwareConfig.h), call it before the interrupts are enabled
+    //@}
+    static void init(void);
+
+    //@{
+    // Detect the baud rate of the host from the sync character 0x55 (@see SystemAutoBaud.h), the link receives again after
+    // the lock. Call it from the main loop.
+    //@}
+    static void startAutoBaud(void);
+
+    //@{
+    // Received bytes pending on the link in the interrupt context, posts it to the main loop (@see ApplicationParts.h)
+    //@}
+    static void onReceived(void);
 
   private:
     //@{
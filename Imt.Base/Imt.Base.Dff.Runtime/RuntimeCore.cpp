@@ -0,0 +1,198 @@
+// (c) IMT - Information Management Technology AG, CH-9470 Buchs, www.imt.ch.
+// SW guideline: Technote Coding Guidelines Ver. 1.5.1
+//
+// ActiveParts (AP) and the corresponding Data Flow Framework (DFF) is invented and designed by Jakob Dscher.
+// ANY USE OF THIS CODE CONSTITUTES ACCEPTANCE OF THE TERMS OF THE COPYRIGHT NOTICE.
+// ===================================================================================================
+// COPYRIGHT NOTICE
+// ===================================================================================================
+// Copyright  2005-2075, IMT Information Management Technology AG, 9470 Buchs, Switzerland
+// All rights reserved.
+// This code is proprietary software of IMT Information Management Technology AG (hereinafter: "IMT").
+// Proprietary software is computer software licensed under exclusive legal right of IMT.
+//
+// The licensee is given the irrevocable, perpetual, worldwide, non-exclusive right and license to use,
+// execute and reproduce the software in binary form within the licensed products.
+//
+// Redistribution and use in source forms, without modification, are permitted provided that the following conditions are met:
+// (1) Copying of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+// (2) Copying of source code is only allowed for regulatory documentation and archiving purposes
+// (3) Redistributions in binary form must reproduce the above copyright notice,
+//     this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+//
+// IMT provide no reassurances that the source code provided does not infringe
+// any patent, copyright, or any other intellectual property rights of third parties.
+// IMT disclaim any liability to any recipient for claims brought against
+// recipient by any third party for infringement of that parties intellectual property rights.
+//
+// THIS SOFTWARE IS PROVIDED BY IMT AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+// INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+// IN NO EVENT SHALL IMT OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+// OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCURE-MENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+// IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// ===================================================================================================
+
+// main include
+#include "RuntimeCore.h"
+
+// Imt.Base includes
+#include <Imt.Base.Core.Diagnostics/Diagnostics.h>
+
+namespace imt {
+namespace base {
+namespace dff {
+namespace runtime {
+
+//lint -esym(956, imt::base::dff::runtime::RuntimeCore::*) // Justification: the runtime is executed by a single context
+ActivePart* RuntimeCore::pFirstPart = NULL;
+RuntimeCore::Clock RuntimeCore::clock = NULL;
+uint32_t RuntimeCore::currentOriginTime = 0U;
+
+InputPort::InputPort(ActivePart& owner, const uint16_t portId) :
+    owner(owner),
+    portId(portId) {
+}
+
+ActivePart::ActivePart(const char_t* const pName, const uint32_t priority, Message* const pQueue, const uint32_t queueSize) :
+    pName(pName),
+    priority(priority),
+    pQueue(pQueue),
+    queueSize(queueSize),
+    readIndex(0U),
+    count(0U),
+    pNext(NULL) {
+    ASSERT_DEBUG((pQueue != NULL) && (queueSize != 0U));
+    resetProfile();
+    RuntimeCore::registerPart(*this);
+}
+
+ActivePart::~ActivePart() {
+}
+
+void ActivePart::onStart(void) {
+}
+
+void ActivePart::resetProfile(void) {
+    profile.Messages = 0U;
+    profile.TotalTicks = 0U;
+    profile.MaxTicks = 0U;
+    profile.MaxLatencyTicks = 0U;
+    profile.Drops = 0U;
+    profile.QueueHighWaterMark = count;
+}
+
+bool ActivePart::send(const OutputPort& port, const uint16_t id, const uint32_t data) {
+    return RuntimeCore::deliver(port.getTarget(), id, data, RuntimeCore::currentOriginTime);
+}
+
+bool ActivePart::enqueue(const Message& message) {
+    if (count >= queueSize) {
+        ++profile.Drops;
+        return false;
+    }
+    uint32_t writeIndex = readIndex + count;
+    if (writeIndex >= queueSize) {
+        writeIndex -= queueSize;
+    }
+    pQueue[writeIndex] = message;
+    ++count;
+    if (count > profile.QueueHighWaterMark) {
+        profile.QueueHighWaterMark = count;
+    }
+    return true;
+}
+
+bool ActivePart::dequeue(Message& message) {
+    if (count == 0U) {
+        return false;
+    }
+    message = pQueue[readIndex];
+    ++readIndex;
+    if (readIndex >= queueSize) {
+        readIndex = 0U;
+    }
+    --count;
+    return true;
+}
+
+void RuntimeCore::init(const Clock clock) {
+    RuntimeCore::clock = clock;
+}
+
+void RuntimeCore::registerPart(ActivePart& part) {
+    // insert behind all parts of higher or equal priority
+    ActivePart** ppLink = &pFirstPart;
+    while ((*ppLink != NULL) && ((*ppLink)->priority <= part.priority)) {
+        ppLink = &(*ppLink)->pNext;
+    }
+    part.pNext = *ppLink;
+    *ppLink = &part;
+}
+
+void RuntimeCore::start(void) {
+    for (ActivePart* pPart = pFirstPart; pPart != NULL; pPart = pPart->pNext) {
+        currentOriginTime = now();
+        pPart->onStart();
+    }
+}
+
+bool RuntimeCore::post(InputPort& port, const uint16_t id, const uint32_t data) {
+    return deliver(port, id, data, now());
+}
+
+bool RuntimeCore::post(InputPort& port, const uint16_t id, const uint32_t data, const uint32_t originTime) {
+    return deliver(port, id, data, originTime);
+}
+
+bool RuntimeCore::deliver(InputPort& port, const uint16_t id, const uint32_t data, const uint32_t originTime) {
+    Message message;
+    message.PortId = port.getPortId();
+    message.Id = id;
+    message.Data = data;
+    message.OriginTime = originTime;
+    return port.getOwner().enqueue(message);
+}
+
+bool RuntimeCore::runOnce(void) {
+    for (ActivePart* pPart = pFirstPart; pPart != NULL; pPart = pPart->pNext) {
+        Message message;
+        if (pPart->dequeue(message)) {
+            const uint32_t startTime = now();
+            currentOriginTime = message.OriginTime;
+            pPart->onMessage(message);
+            const uint32_t executionTicks = now() - startTime;
+
+            ActivePart::Profile& profile = pPart->profile;
+            ++profile.Messages;
+            profile.TotalTicks += executionTicks;
+            if (executionTicks > profile.MaxTicks) {
+                profile.MaxTicks = executionTicks;
+            }
+            const uint32_t latencyTicks = startTime - message.OriginTime;
+            if (latencyTicks > profile.MaxLatencyTicks) {
+                profile.MaxLatencyTicks = latencyTicks;
+            }
+            return true;
+        }
+    }
+    return false;
+}
+
+uint32_t RuntimeCore::runUntilIdle(const uint32_t maxMessages) {
+    uint32_t handled = 0U;
+    while ((handled < maxMessages) && runOnce()) {
+        ++handled;
+    }
+    return handled;
+}
+
+uint32_t RuntimeCore::now(void) {
+    return (clock != NULL) ? clock() : 0U;
+}
+
+} // namespace runtime
+} // namespace dff
+} // namespace base
+} // namespace imt
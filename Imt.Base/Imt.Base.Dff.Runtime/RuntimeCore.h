@@ -0,0 +1,402 @@
+// (c) IMT - Information Management Technology AG, CH-9470 Buchs, www.imt.ch.
+// SW guideline: Technote Coding Guidelines Ver. 1.5.1
+//
+// ActiveParts (AP) and the corresponding Data Flow Framework (DFF) is invented and designed by Jakob Dscher.
+// ANY USE OF THIS CODE CONSTITUTES ACCEPTANCE OF THE TERMS OF THE COPYRIGHT NOTICE.
+// ===================================================================================================
+// COPYRIGHT NOTICE
+// ===================================================================================================
+// Copyright  2005-2075, IMT Information Management Technology AG, 9470 Buchs, Switzerland
+// All rights reserved.
+// This code is proprietary software of IMT Information Management Technology AG (hereinafter: "IMT").
+// Proprietary software is computer software licensed under exclusive legal right of IMT.
+//
+// The licensee is given the irrevocable, perpetual, worldwide, non-exclusive right and license to use,
+// execute and reproduce the software in binary form within the licensed products.
+//
+// Redistribution and use in source forms, without modification, are permitted provided that the following conditions are met:
+// (1) Copying of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+// (2) Copying of source code is only allowed for regulatory documentation and archiving purposes
+// (3) Redistributions in binary form must reproduce the above copyright notice,
+//     this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+//
+// IMT provide no reassurances that the source code provided does not infringe
+// any patent, copyright, or any other intellectual property rights of third parties.
+// IMT disclaim any liability to any recipient for claims brought against
+// recipient by any third party for infringement of that parties intellectual property rights.
+//
+// THIS SOFTWARE IS PROVIDED BY IMT AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+// INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+// IN NO EVENT SHALL IMT OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+// OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCURE-MENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+// IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// ===================================================================================================
+
+#ifndef RUNTIMECORE_H
+#define RUNTIMECORE_H
+
+// Imt.Base includes
+#include <Imt.Base.Core.Platform/Platform.h>
+
+namespace imt {
+namespace base {
+namespace dff {
+namespace runtime {
+
+class ActivePart;
+
+//@{
+// Message between active parts, copied by value into the queue of the receiving part.
+//@}
+struct Message {
+    // Input port of the receiving part
+    uint16_t PortId;
+    // Message id, defined by the receiving part
+    uint16_t Id;
+    // Message data
+    uint32_t Data;
+    // Clock when the data flow started (RuntimeCore::post), inherited by all messages sent in reaction
+    uint32_t OriginTime;
+};
+
+//@{
+// Input port of an active part, a member of the part.
+//@}
+class InputPort {
+
+public:
+
+    //@{
+    // Constructor.
+    // @param owner: Part receiving the messages of the port.
+    // @param portId: Id of the port passed in Message::PortId, unique within the part.
+    //@}
+    InputPort(ActivePart& owner, const uint16_t portId);
+
+    //@{
+    // Returns the part receiving the messages of the port.
+    //@}
+    ActivePart& getOwner(void) const {
+        return owner;
+    }
+
+    //@{
+    // Returns the id of the port.
+    //@}
+    uint16_t getPortId(void) const {
+        return portId;
+    }
+
+private:
+
+    //@{
+    // Provide the private copy constructor so the compiler does not generate the default one.
+    //@}
+    InputPort(const InputPort& other);
+
+    //@{
+    // Provide the private assignment operator so the compiler does not generate the default one.
+    //@}
+    InputPort& operator=(const InputPort& other);
+
+    ActivePart& owner;
+    const uint16_t portId;
+};
+
+//@{
+// Output port of an active part, a member of the part.
+// The port is wired to its input port when the parts are defined and is never rewired.
+//@}
+class OutputPort {
+
+public:
+
+    //@{
+    // Constructor.
+    // @param target: Input port receiving the messages sent to this port.
+    //@}
+    explicit OutputPort(InputPort& target) : target(target) {
+    }
+
+    //@{
+    // Returns the input port receiving the messages sent to this port.
+    //@}
+    InputPort& getTarget(void) const {
+        return target;
+    }
+
+private:
+
+    //@{
+    // Provide the private copy constructor so the compiler does not generate the default one.
+    //@}
+    OutputPort(const OutputPort& other);
+
+    //@{
+    // Provide the private assignment operator so the compiler does not generate the default one.
+    //@}
+    OutputPort& operator=(const OutputPort& other);
+
+    InputPort& target;
+};
+
+//@{
+// Active part: a unit of the application which reacts on messages of its input ports and sends messages to its
+// output ports. A part owns a message queue and is only executed by the RuntimeCore scheduler.
+// Parts are statically allocated objects (no dynamic allocation), they register themselves at construction.
+//@}
+class ActivePart {
+
+public:
+
+    //@{
+    // Execution profile of a part, times in ticks of the RuntimeCore clock
+    //@}
+    struct Profile {
+        // Messages handled
+        uint32_t Messages;
+        // Sum and maximum of the execution time of onMessage
+        uint32_t TotalTicks;
+        uint32_t MaxTicks;
+        // Maximum time from the origin of the data flow to the start of onMessage (end-to-end latency)
+        uint32_t MaxLatencyTicks;
+        // Messages dropped because the queue was full
+        uint32_t Drops;
+        // Maximum number of queued messages
+        uint32_t QueueHighWaterMark;
+    };
+
+    //@{
+    // Returns the name of the part.
+    //@}
+    const char_t* getName(void) const {
+        return pName;
+    }
+
+    //@{
+    // Returns the scheduling priority, 0 is the highest.
+    //@}
+    uint32_t getPriority(void) const {
+        return priority;
+    }
+
+    //@{
+    // Returns the execution profile.
+    //@}
+    const Profile& getProfile(void) const {
+        return profile;
+    }
+
+    //@{
+    // Reset the execution profile.
+    //@}
+    void resetProfile(void);
+
+    //@{
+    // Returns the next part in priority order, NULL after the last part.
+    //@}
+    ActivePart* getNext(void) const {
+        return pNext;
+    }
+
+protected:
+
+    //@{
+    // Constructor, registers the part at the RuntimeCore.
+    // @param pName: Name of the part for the profile.
+    // @param priority: Scheduling priority, 0 is the highest. Parts of equal priority are served in definition order.
+    // @param pQueue: Storage of the message queue, owned by the derived part.
+    // @param queueSize: Number of messages of the queue storage.
+    //@}
+    ActivePart(const char_t* const pName, const uint32_t priority, Message* const pQueue, const uint32_t queueSize);
+
+    //@{
+    // Destructor.
+    //@}
+    virtual ~ActivePart();
+
+    //@{
+    // Called once by RuntimeCore::start before any message is handled.
+    //@}
+    virtual void onStart(void);
+
+    //@{
+    // Handle a message of an input port, runs to completion.
+    // @param message: Message, PortId identifies the input port.
+    //@}
+    virtual void onMessage(const Message& message) = 0;
+
+    //@{
+    // Send a message to an output port, call it from onStart or onMessage only.
+    // The message inherits the origin time of the message being handled.
+    // @param port: Output port of this part.
+    // @param id: Message id.
+    // @param data: Message data.
+    // @return bool: false if the queue of the receiving part was full
+    //@}
+    bool send(const OutputPort& port, const uint16_t id, const uint32_t data);
+
+private:
+
+    friend class RuntimeCore;
+
+    //@{
+    // Provide the private copy constructor so the compiler does not generate the default one.
+    //@}
+    ActivePart(const ActivePart& other);
+
+    //@{
+    // Provide the private assignment operator so the compiler does not generate the default one.
+    //@}
+    ActivePart& operator=(const ActivePart& other);
+
+    //@{
+    // Append a message to the queue.
+    // @return bool: false if the queue is full
+    //@}
+    bool enqueue(const Message& message);
+
+    //@{
+    // Take the oldest message of the queue.
+    // @return bool: false if the queue is empty
+    //@}
+    bool dequeue(Message& message);
+
+    const char_t* const pName;
+    const uint32_t priority;
+    Message* const pQueue;
+    const uint32_t queueSize;
+    uint32_t readIndex;
+    uint32_t count;
+    Profile profile;
+    // Next part in priority order
+    ActivePart* pNext;
+};
+
+//@{
+// Run-to-completion scheduler of the active parts.
+// runOnce takes one message of the highest priority part with a queued message and calls its onMessage, which runs
+// to completion: messages sent meanwhile are only queued. All parts are executed by the same context (main loop),
+// interrupts hand their data over to that context (e.g. by an event queue) which posts it with RuntimeCore::post.
+// The execution time of each message and its end-to-end latency (from the origin time of the data flow) are
+// measured with the clock set by init, e.g. the cycle counter on the target or a monotonic clock on the host.
+// Data handed over from an interrupt is posted with the time taken in the interrupt, so the latency includes the
+// handover.
+//@}
+class RuntimeCore {
+
+public:
+
+    //@{
+    // Clock for the profile, returns free running ticks.
+    //@}
+    typedef uint32_t (*Clock)(void);
+
+    //@{
+    // Set the clock for the profiles, call it before start.
+    // @param clock: Clock function, NULL disables the time measurement.
+    //@}
+    static void init(const Clock clock);
+
+    //@{
+    // Call onStart of all parts in priority order.
+    //@}
+    static void start(void);
+
+    //@{
+    // Post a message from outside the parts, starts a new data flow (origin time is now).
+    // @param port: Input port of a part.
+    // @param id: Message id.
+    // @param data: Message data.
+    // @return bool: false if the queue of the part was full
+    //@}
+    static bool post(InputPort& port, const uint16_t id, const uint32_t data);
+
+    //@{
+    // Post a message from outside the parts, starts a new data flow which began at originTime (e.g. in an interrupt).
+    // @param port: Input port of a part.
+    // @param id: Message id.
+    // @param data: Message data.
+    // @param originTime: Time of the clock set by init when the data flow began.
+    // @return bool: false if the queue of the part was full
+    //@}
+    static bool post(InputPort& port, const uint16_t id, const uint32_t data, const uint32_t originTime);
+
+    //@{
+    // Handle one message of the highest priority part with a queued message.
+    // @return bool: false if no message was queued
+    //@}
+    static bool runOnce(void);
+
+    //@{
+    // Handle messages until no message is queued or maxMessages were handled.
+    // @param maxMessages: Limit, bounds the time spent in the call.
+    // @return uint32_t: Number of messages handled
+    //@}
+    static uint32_t runUntilIdle(const uint32_t maxMessages);
+
+    //@{
+    // Returns the highest priority part, walk the parts with ActivePart::getNext.
+    //@}
+    static ActivePart* getFirstPart(void) {
+        return pFirstPart;
+    }
+
+private:
+
+    friend class ActivePart;
+
+    //@{
+    // Insert a part into the priority ordered list.
+    //@}
+    static void registerPart(ActivePart& part);
+
+    //@{
+    // Queue a message at the part of an input port.
+    //@}
+    static bool deliver(InputPort& port, const uint16_t id, const uint32_t data, const uint32_t originTime);
+
+    //@{
+    // Returns the clock ticks, 0 without clock.
+    //@}
+    static uint32_t now(void);
+
+    //@{
+    // Constructor.
+    //@}
+    RuntimeCore(void);
+
+    //@{
+    // Provide the private copy constructor so the compiler does not generate the default one.
+    //@}
+    RuntimeCore(const RuntimeCore& other);
+
+    //@{
+    // Provide the private assignment operator so the compiler does not generate the default one.
+    //@}
+    RuntimeCore& operator=(const RuntimeCore& other);
+
+    //@{
+    // Destructor.
+    //@}
+    ~RuntimeCore(void);
+
+    static ActivePart* pFirstPart;
+    static Clock clock;
+    // Origin time of the message being handled, inherited by the messages sent by the part
+    static uint32_t currentOriginTime;
+};
+
+} // namespace runtime
+} // namespace dff
+} // namespace base
+} // namespace imt
+using imt::base::dff::runtime::Message;
+using imt::base::dff::runtime::InputPort;
+using imt::base::dff::runtime::OutputPort;
+using imt::base::dff::runtime::ActivePart;
+using imt::base::dff::runtime::RuntimeCore;
+
+#endif // #ifndef RUNTIMECORE_H
@@ -0,0 +1,183 @@
+// (c) IMT - Information Management Technology AG, CH-9470 Buchs, www.imt.ch.
+// SW guideline: Technote Coding Guidelines Ver. 1.5.1
+
+#ifndef CORE_ATOMIC_H
+#define CORE_ATOMIC_H
+
+// Must be very first include
+#include <Imt.Base.Core.Platform/Platform.h>
+
+#if defined(__IAR_SYSTEMS_ICC__)
+// Project includes
+#include "SystemMemoryMap.h"
+
+// IAR includes
+#include <intrinsics.h>
+#elif (__cplusplus >= 201103L)
+// STL includes
+#include <atomic>
+#else
+#error "The host build of Core_Atomic.h requires C++11 (std::atomic), compile with -std=c++11 or later"
+#endif // __IAR_SYSTEMS_ICC__
+
+//@{
+// Lock-free atomic operations on 8, 16 and 32-bit values shared between interrupts and the main loop.
+// The operations are built on the exclusive load/store instructions (LDREX/STREX): the store fails if an interrupt
+// (or any exclusive access) came between load and store, then the operation is retried. No interrupt is masked.
+// Operations per width N (8, 16, 32) on the type Atomic_UintN:
+// - Atomic_LoadN / Atomic_StoreN
+// - Atomic_CompareExchangeN: store desired if the value equals *pExpected, else update *pExpected to the value
+// - Atomic_ExchangeN, Atomic_FetchAddN, Atomic_FetchSubN, Atomic_FetchOrN, Atomic_FetchAndN, Atomic_FetchXorN:
+//   return the previous value
+// Atomic flag arrays (AtomicFlags_*) address single bits of Atomic_Uint32 words: set, clear and test are a single
+// bit-band access (BITBAND_SRAM), test-and-set / test-and-clear use the exclusive access. The words must be in SRAM.
+//
+// The atomic variables need static storage (zero initialized) or an Atomic_StoreN before they are shared.
+// On the host build (C++11 or later) the types are std::atomic with identical semantics, so the users of these
+// operations compile and run unchanged. The target build does not need C++11.
+//
+// Reference: Cortex-M3 Devices Generic User Guide DUI0552A Chapter 3.4.8 LDREX and STREX, Chapter 2.2.5 Bit-banding
+//@}
+
+#if defined(__IAR_SYSTEMS_ICC__)
+//@{
+// Operations of one width on the exclusive access intrinsics.
+// The intrinsics take non volatile pointers, the accesses are volatile by definition.
+//@}
+//lint -emacro(923 926 928, ATOMIC_DEFINE_OPERATIONS, ATOMIC_DEFINE_FETCH) cast from pointer to pointer [MISRA C++ Rule 5-2-7]. Justification: exclusive access intrinsics
+#define ATOMIC_DEFINE_OPERATIONS(Bits, Type, ExclusiveType, LoadExclusive, StoreExclusive)                                   \
+    typedef volatile Type Atomic_Uint##Bits;                                                                                \
+    static inline Type Atomic_Load##Bits(const Atomic_Uint##Bits* const pValue) {                                           \
+        return *pValue;                                                                                                     \
+    }                                                                                                                       \
+    static inline void Atomic_Store##Bits(Atomic_Uint##Bits* const pValue, const Type value) {                              \
+        *pValue = value;                                                                                                    \
+    }                                                                                                                       \
+    static inline bool Atomic_CompareExchange##Bits(Atomic_Uint##Bits* const pValue, Type* const pExpected, const Type desired) { \
+        ExclusiveType* const pExclusive = (ExclusiveType*)pValue;                                                           \
+        do {                                                                                                                \
+            const Type current = (Type)LoadExclusive(pExclusive);                                                           \
+            if (current != *pExpected) {                                                                                    \
+                __CLREX();                                                                                                  \
+                *pExpected = current;                                                                                       \
+                return false;                                                                                               \
+            }                                                                                                               \
+        } while (StoreExclusive((ExclusiveType)desired, pExclusive) != 0U);                                                 \
+        return true;                                                                                                        \
+    }                                                                                                                       \
+    ATOMIC_DEFINE_FETCH(Bits, Type, ExclusiveType, LoadExclusive, StoreExclusive, Exchange, operand)                        \
+    ATOMIC_DEFINE_FETCH(Bits, Type, ExclusiveType, LoadExclusive, StoreExclusive, FetchAdd, previous + operand)             \
+    ATOMIC_DEFINE_FETCH(Bits, Type, ExclusiveType, LoadExclusive, StoreExclusive, FetchSub, previous - operand)             \
+    ATOMIC_DEFINE_FETCH(Bits, Type, ExclusiveType, LoadExclusive, StoreExclusive, FetchOr, previous | operand)              \
+    ATOMIC_DEFINE_FETCH(Bits, Type, ExclusiveType, LoadExclusive, StoreExclusive, FetchAnd, previous & operand)             \
+    ATOMIC_DEFINE_FETCH(Bits, Type, ExclusiveType, LoadExclusive, StoreExclusive, FetchXor, previous ^ operand)
+
+// Read-modify-write operation: the new value is an expression of previous and operand
+#define ATOMIC_DEFINE_FETCH(Bits, Type, ExclusiveType, LoadExclusive, StoreExclusive, Name, newValue)                        \
+    static inline Type Atomic_##Name##Bits(Atomic_Uint##Bits* const pValue, const Type operand) {                           \
+        ExclusiveType* const pExclusive = (ExclusiveType*)pValue;                                                           \
+        Type previous;                                                                                                      \
+        do {                                                                                                                \
+            previous = (Type)LoadExclusive(pExclusive);                                                                     \
+        } while (StoreExclusive((ExclusiveType)(Type)(newValue), pExclusive) != 0U);                                        \
+        return previous;                                                                                                    \
+    }
+
+ATOMIC_DEFINE_OPERATIONS(8, uint8_t, unsigned char, __LDREXB, __STREXB)
+ATOMIC_DEFINE_OPERATIONS(16, uint16_t, unsigned short, __LDREXH, __STREXH)
+ATOMIC_DEFINE_OPERATIONS(32, uint32_t, unsigned long, __LDREX, __STREX)
+#else
+//@{
+// Operations of one width on std::atomic (host build).
+//@}
+#define ATOMIC_DEFINE_OPERATIONS(Bits, Type)                                                                                \
+    typedef std::atomic<Type> Atomic_Uint##Bits;                                                                            \
+    static inline Type Atomic_Load##Bits(const Atomic_Uint##Bits* const pValue) {                                           \
+        return pValue->load();                                                                                              \
+    }                                                                                                                       \
+    static inline void Atomic_Store##Bits(Atomic_Uint##Bits* const pValue, const Type value) {                              \
+        pValue->store(value);                                                                                               \
+    }                                                                                                                       \
+    static inline bool Atomic_CompareExchange##Bits(Atomic_Uint##Bits* const pValue, Type* const pExpected, const Type desired) { \
+        return pValue->compare_exchange_strong(*pExpected, desired);                                                        \
+    }                                                                                                                       \
+    ATOMIC_DEFINE_FETCH(Bits, Type, Exchange, exchange)                                                                     \
+    ATOMIC_DEFINE_FETCH(Bits, Type, FetchAdd, fetch_add)                                                                    \
+    ATOMIC_DEFINE_FETCH(Bits, Type, FetchSub, fetch_sub)                                                                    \
+    ATOMIC_DEFINE_FETCH(Bits, Type, FetchOr, fetch_or)                                                                      \
+    ATOMIC_DEFINE_FETCH(Bits, Type, FetchAnd, fetch_and)                                                                    \
+    ATOMIC_DEFINE_FETCH(Bits, Type, FetchXor, fetch_xor)
+
+// Read-modify-write operation on the std::atomic member function
+#define ATOMIC_DEFINE_FETCH(Bits, Type, Name, function)                                                                     \
+    static inline Type Atomic_##Name##Bits(Atomic_Uint##Bits* const pValue, const Type operand) {                           \
+        return pValue->function(operand);                                                                                   \
+    }
+
+ATOMIC_DEFINE_OPERATIONS(8, uint8_t)
+ATOMIC_DEFINE_OPERATIONS(16, uint16_t)
+ATOMIC_DEFINE_OPERATIONS(32, uint32_t)
+#endif // __IAR_SYSTEMS_ICC__
+
+//------------------------------------------------------------------------------
+// Atomic flag arrays
+//------------------------------------------------------------------------------
+// Number of Atomic_Uint32 words of a flag array
+#define ATOMICFLAGS_WORDS(flagCount) (((flagCount) + 31U) / 32U)
+
+//@{
+// Set a flag.
+// @param pFlags: Flag array of ATOMICFLAGS_WORDS(flagCount) words in SRAM.
+// @param index: Flag number.
+//@}
+static inline void AtomicFlags_Set(Atomic_Uint32* const pFlags, const uint32_t index) {
+#if defined(__IAR_SYSTEMS_ICC__)
+    BITBAND_SRAM((uint32_t)&pFlags[index >> 5U], index & 31U) = 1U; //lint !e923 cast from pointer to int [MISRA C++ Rule 5-2-9]. Justification: bit-band alias address
+#else
+    (void)pFlags[index >> 5U].fetch_or((uint32_t)1U << (index & 31U));
+#endif // __IAR_SYSTEMS_ICC__
+}
+
+//@{
+// Clear a flag.
+// @param pFlags: Flag array in SRAM.
+// @param index: Flag number.
+//@}
+static inline void AtomicFlags_Clear(Atomic_Uint32* const pFlags, const uint32_t index) {
+#if defined(__IAR_SYSTEMS_ICC__)
+    BITBAND_SRAM((uint32_t)&pFlags[index >> 5U], index & 31U) = 0U; //lint !e923 cast from pointer to int [MISRA C++ Rule 5-2-9]. Justification: bit-band alias address
+#else
+    (void)pFlags[index >> 5U].fetch_and(~((uint32_t)1U << (index & 31U)));
+#endif // __IAR_SYSTEMS_ICC__
+}
+
+//@{
+// Returns true if a flag is set.
+// @param pFlags: Flag array in SRAM.
+// @param index: Flag number.
+//@}
+static inline bool AtomicFlags_Test(const Atomic_Uint32* const pFlags, const uint32_t index) {
+    return ((Atomic_Load32(&pFlags[index >> 5U]) >> (index & 31U)) & 1U) != 0U;
+}
+
+//@{
+// Set a flag and return its previous state (e.g. to claim a resource exactly once).
+// @param pFlags: Flag array in SRAM.
+// @param index: Flag number.
+//@}
+static inline bool AtomicFlags_TestAndSet(Atomic_Uint32* const pFlags, const uint32_t index) {
+    const uint32_t mask = (uint32_t)1U << (index & 31U);
+    return (Atomic_FetchOr32(&pFlags[index >> 5U], mask) & mask) != 0U;
+}
+
+//@{
+// Clear a flag and return its previous state (e.g. to consume a request exactly once).
+// @param pFlags: Flag array in SRAM.
+// @param index: Flag number.
+//@}
+static inline bool AtomicFlags_TestAndClear(Atomic_Uint32* const pFlags, const uint32_t index) {
+    const uint32_t mask = (uint32_t)1U << (index & 31U);
+    return (Atomic_FetchAnd32(&pFlags[index >> 5U], ~mask) & mask) != 0U;
+}
+
+#endif // CORE_ATOMIC_H
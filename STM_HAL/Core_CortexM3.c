@@ -0,0 +1,43 @@
+// (c) IMT - Information Management Technology AG, CH-9470 Buchs, www.imt.ch.
+// SW guideline: Technote Coding Guidelines Ver. 1.5.1
+
+#include "Core_CortexM3.h"
+
+// Cycle counter at the entry of the outermost section. Only one outermost section exists at a time: while BASEPRI
+// is raised a nested section of a higher interrupt does not see BASEPRI 0.
+static uint32_t criticalSectionMaskedStart = 0U;
+
+// Statistics, written with raised BASEPRI only
+static CriticalSection_Statistics criticalSectionStatistics = { 0U, 0U, 0U };
+
+void CriticalSection_OnMasked(void) {
+    criticalSectionMaskedStart = DWT->CYCCNT;
+}
+
+void CriticalSection_OnUnmasked(const uint32_t basePriority) {
+    const uint32_t maskedCycles = DWT->CYCCNT - criticalSectionMaskedStart;
+    ++criticalSectionStatistics.Sections;
+    if (maskedCycles > criticalSectionStatistics.MaxMaskedCycles) {
+        criticalSectionStatistics.MaxMaskedCycles = maskedCycles;
+        criticalSectionStatistics.MaxMaskedCeiling = basePriority >> CORE_BASEPRI_SHIFT;
+    }
+}
+
+void CriticalSection_GetStatistics(CriticalSection_Statistics* const pStatistics) {
+    if (pStatistics == NULL) {
+        ASSERT_DEBUG(false);
+        return;
+    }
+    // masks all writers, the section itself is counted
+    const uint32_t previousBasePriority = CriticalSection_Enter(CORE_CRITICALSECTION_HIGHEST_CEILING);
+    *pStatistics = criticalSectionStatistics;
+    CriticalSection_Exit(previousBasePriority);
+}
+
+void CriticalSection_ResetStatistics(void) {
+    const uint32_t previousBasePriority = CriticalSection_Enter(CORE_CRITICALSECTION_HIGHEST_CEILING);
+    criticalSectionStatistics.Sections = 0U;
+    criticalSectionStatistics.MaxMaskedCycles = 0U;
+    criticalSectionStatistics.MaxMaskedCeiling = 0U;
+    CriticalSection_Exit(previousBasePriority);
+}
@@ -10,6 +10,14 @@
 // Project includes
 #include "SystemMemoryMap.h"
 
+// Imt.Base includes
+#include <Imt.Base.Core.Diagnostics/Diagnostics.h>
+
+#if defined(__IAR_SYSTEMS_ICC__)
+// IAR includes
+#include <intrinsics.h>
+#endif // __IAR_SYSTEMS_ICC__
+
 //------------------------------------------------------------------------------
 // System Control Block (SCB) register structure
 // Reference: Cortex-M3 Devices Generic User Guide DUI0552A Table 4-12
@@ -86,5 +94,203 @@ typedef struct {
 #define SCB_AIRCR_PRIGROUP_Pos             8
 // SCB AIRCR: PRIGROUP Mask
 #define SCB_AIRCR_PRIGROUP_Mask            (7UL << SCB_AIRCR_PRIGROUP_Pos)
+// SCB AIRCR: VECTKEY value of a write
+#define SCB_AIRCR_VECTKEY                  (0x5FAUL << SCB_AIRCR_VECTKEY_Pos)
+// SCB AIRCR: System reset request
+#define SCB_AIRCR_SYSRESETREQ              ((uint32_t)0x00000004)
+
+//------------------------------------------------------------------------------
+// Bit definition for SCB_CCR and SCB_SHCSR registers
+//------------------------------------------------------------------------------
+// Trap on a division by zero (usage fault)
+#define  SCB_CCR_DIV_0_TRP                   ((uint32_t)0x00000010)
+// Enable the memory management, bus and usage fault handlers, disabled they escalate to the hard fault
+#define  SCB_SHCSR_MEMFAULTENA               ((uint32_t)0x00010000)
+#define  SCB_SHCSR_BUSFAULTENA               ((uint32_t)0x00020000)
+#define  SCB_SHCSR_USGFAULTENA               ((uint32_t)0x00040000)
+
+//------------------------------------------------------------------------------
+// Core debug register structure (only the registers used by the application)
+// Reference: ARMv7-M Architecture Reference Manual ARM DDI 0403 Chapter C1.6
+//------------------------------------------------------------------------------
+typedef struct {
+    // Offset: 0x00 Debug Halting Control and Status Register
+    volatile uint32_t DHCSR;
+    // Offset: 0x04 Debug Core Register Selector Register
+    volatile uint32_t DCRSR;
+    // Offset: 0x08 Debug Core Register Data Register
+    volatile uint32_t DCRDR;
+    // Offset: 0x0C Debug Exception and Monitor Control Register
+    volatile uint32_t DEMCR;
+} CoreDebug_Type;
+// CoreDebug configuration struct
+#define CoreDebug ((CoreDebug_Type*)CoreDebug_BASE)
+
+// DEMCR: Global enable for the DWT and ITM units
+#define CoreDebug_DEMCR_TRCENA              ((uint32_t)0x01000000)
+
+//------------------------------------------------------------------------------
+// Data Watchpoint and Trace (DWT) register structure (cycle and event counters)
+// Reference: ARMv7-M Architecture Reference Manual ARM DDI 0403 Chapter C1.8
+//------------------------------------------------------------------------------
+typedef struct {
+    // Offset: 0x00 Control Register
+    volatile uint32_t CTRL;
+    // Offset: 0x04 Cycle Count Register
+    volatile uint32_t CYCCNT;
+    // Offset: 0x08 CPI Count Register
+    volatile uint32_t CPICNT;
+    // Offset: 0x0C Exception Overhead Count Register
+    volatile uint32_t EXCCNT;
+    // Offset: 0x10 Sleep Count Register
+    volatile uint32_t SLEEPCNT;
+    // Offset: 0x14 LSU Count Register
+    volatile uint32_t LSUCNT;
+    // Offset: 0x18 Folded-instruction Count Register
+    volatile uint32_t FOLDCNT;
+} DWT_Type;
+// DWT configuration struct
+#define DWT ((DWT_Type*)DWT_BASE)
+
+// DWT CTRL: Enable the cycle counter
+#define DWT_CTRL_CYCCNTENA                  ((uint32_t)0x00000001)
+
+//------------------------------------------------------------------------------
+// Critical sections by BASEPRI
+// A critical section raises BASEPRI to the ceiling of the protected resource: the highest preemption priority
+// (lowest value) of the interrupts accessing it. Only the interrupts up to the ceiling are masked, interrupts with
+// a higher priority run unaffected. Nested sections only raise BASEPRI and restore the previous value on exit.
+// The longest interval with raised BASEPRI is measured with the DWT cycle counter.
+// On the host build the sections do not mask anything.
+// Reference: Cortex-M3 Devices Generic User Guide DUI0552A Chapter 2.1.3 Priority mask registers
+//------------------------------------------------------------------------------
+// Priority bits implemented by the STM32F103: the upper 4 bits of BASEPRI
+#define CORE_PRIORITY_BITS                  4U
+#define CORE_BASEPRI_SHIFT                  (8U - CORE_PRIORITY_BITS)
+
+// Highest ceiling (lowest priority value) of a critical section: priority 0 is never masked
+#define CORE_CRITICALSECTION_HIGHEST_CEILING 1U
+
+// 1: measure the longest interval with raised BASEPRI
+#define CORE_CRITICALSECTION_INSTRUMENTATION 1
+
+//@{
+// Masked intervals since the last reset, measured from the outermost section entry to its exit
+//@}
+typedef struct {
+    // Outermost sections
+    uint32_t Sections;
+    // Longest masked interval in CPU cycles
+    uint32_t MaxMaskedCycles;
+    // Ceiling of the longest masked interval
+    uint32_t MaxMaskedCeiling;
+} CriticalSection_Statistics;
+
+#ifdef __cplusplus
+extern "C" {
+#endif // __cplusplus
+
+//@{
+// Instrumentation of the outermost section, called by CriticalSection_Enter / CriticalSection_Exit.
+//@}
+void CriticalSection_OnMasked(void);
+void CriticalSection_OnUnmasked(const uint32_t basePriority);
+
+//@{
+// Copy the statistics of the masked intervals.
+// @param pStatistics: Pointer to the CriticalSection_Statistics structure to fill.
+//@}
+void CriticalSection_GetStatistics(CriticalSection_Statistics* const pStatistics);
+
+//@{
+// Reset the statistics of the masked intervals.
+//@}
+void CriticalSection_ResetStatistics(void);
+
+//@{
+// Enter a critical section: mask all interrupts with a priority value >= ceiling.
+// @param ceiling: Ceiling priority CORE_CRITICALSECTION_HIGHEST_CEILING..15.
+// @return uint32_t: BASEPRI before the section, pass it to CriticalSection_Exit
+//@}
+static inline uint32_t CriticalSection_Enter(const uint32_t ceiling) {
+#if defined(__IAR_SYSTEMS_ICC__)
+    const uint32_t previousBasePriority = __get_BASEPRI();
+    const uint32_t basePriority = ceiling << CORE_BASEPRI_SHIFT;
+    if ((previousBasePriority == 0U) || (previousBasePriority > basePriority)) {
+        __set_BASEPRI(basePriority);
+#if (CORE_CRITICALSECTION_INSTRUMENTATION == 1)
+        if (previousBasePriority == 0U) {
+            CriticalSection_OnMasked();
+        }
+#endif
+    }
+    return previousBasePriority;
+#else
+    (void)ceiling;
+    return 0U;
+#endif // __IAR_SYSTEMS_ICC__
+}
+
+//@{
+// Leave a critical section: restore BASEPRI.
+// @param previousBasePriority: Return value of the matching CriticalSection_Enter.
+//@}
+static inline void CriticalSection_Exit(const uint32_t previousBasePriority) {
+#if defined(__IAR_SYSTEMS_ICC__)
+#if (CORE_CRITICALSECTION_INSTRUMENTATION == 1)
+    if (previousBasePriority == 0U) {
+        CriticalSection_OnUnmasked(__get_BASEPRI());
+    }
+#endif
+    __set_BASEPRI(previousBasePriority);
+#else
+    (void)previousBasePriority;
+#endif // __IAR_SYSTEMS_ICC__
+}
+
+#ifdef __cplusplus
+}
+
+//@{
+// Scoped critical section (RAII) with the ceiling checked at compile time.
+// Usage: { const CriticalSectionGuard<IRQ_Priority4> guard; ... }
+//@}
+template <uint32_t Ceiling>
+class CriticalSectionGuard {
+
+public:
+
+    //@{
+    // Constructor, enters the critical section.
+    //@}
+    CriticalSectionGuard() : previousBasePriority(CriticalSection_Enter(Ceiling)) {
+    }
+
+    //@{
+    // Destructor, leaves the critical section.
+    //@}
+    ~CriticalSectionGuard() {
+        CriticalSection_Exit(previousBasePriority);
+    }
+
+private:
+
+    // A ceiling of 0 would leave BASEPRI unchanged (0 disables the masking) and violate the never masked priority
+    ASSERT_COMPILER((Ceiling >= CORE_CRITICALSECTION_HIGHEST_CEILING) && (Ceiling < (1U << CORE_PRIORITY_BITS)));
+
+    //@{
+    // Provide the private copy constructor so the compiler does not generate the default one.
+    //@}
+    CriticalSectionGuard(const CriticalSectionGuard& other);
+
+    //@{
+    // Provide the private assignment operator so the compiler does not generate the default one.
+    //@}
+    CriticalSectionGuard& operator=(const CriticalSectionGuard& other);
+
+    // BASEPRI before the section
+    const uint32_t previousBasePriority;
+};
+#endif // __cplusplus
 
 #endif // CORE_CORTEXM3_H
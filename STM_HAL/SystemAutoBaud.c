@@ -0,0 +1,161 @@
+// (c) IMT - Information Management Technology AG, CH-9470 Buchs, www.imt.ch.
+// SW guideline: Technote Coding Guidelines Ver. 1.5.1
+
+#include "SystemAutoBaud.h"
+
+// Project includes
+#include "SystemPeripherals_EXTI.h"
+#include "SystemPeripherals_RCC.h"
+#include "SystemExtiDispatcher.h"
+#include "Core_CortexM3.h"
+
+// Imt.Base includes
+#include <Imt.Base.Core.Diagnostics/Diagnostics.h>
+
+// Falling edges of the sync character: start bit, data bits 1, 3, 5 and 7, 8 bit times from the first to the last
+#define AUTOBAUD_EDGE_COUNT 5U
+#define AUTOBAUD_WINDOW_BITS 8U
+
+// Deviation of an edge interval from the mean of the window, as divisor of the mean (1/8 = 12.5%)
+#define AUTOBAUD_INTERVAL_TOLERANCE_DIVISOR 8U
+
+// Deviation of the measured from a standard baud rate which snaps to it
+#define AUTOBAUD_SNAP_TOLERANCE_PPM 30000U
+
+static AutoBaud_Config autoBaudConfig;
+static volatile bool autoBaudIsRunning = false;
+static AutoBaud_Statistics autoBaudStatistics;
+
+//@{
+// Timestamps of the last falling edges (ring, the oldest at edgeCount % AUTOBAUD_EDGE_COUNT) and the number of edges
+//@}
+static uint32_t autoBaudEdgeCycles[AUTOBAUD_EDGE_COUNT];
+static uint32_t autoBaudEdgeCount = 0U;
+
+//@{
+// Returns the standard baud rate within AUTOBAUD_SNAP_TOLERANCE_PPM of the measured rate, else the measured rate.
+//@}
+static uint32_t AutoBaud_Snap(const uint32_t measuredBaudRate) {
+    for (uint32_t index = 0U; index < autoBaudConfig.BaudRateCount; ++index) {
+        const uint32_t baudRate = autoBaudConfig.pBaudRates[index];
+        const uint32_t deviation = (measuredBaudRate > baudRate) ? (measuredBaudRate - baudRate) : (baudRate - measuredBaudRate);
+        // deviation / baud rate <= tolerance, in 32 bits: the rates are below 4.5 Mbaud
+        if ((deviation * (1000000U / AUTOBAUD_SNAP_TOLERANCE_PPM)) <= baudRate) {
+            return baudRate;
+        }
+    }
+    return measuredBaudRate;
+}
+
+//@{
+// Set the baud rate of a sync character which spans windowCycles for AUTOBAUD_WINDOW_BITS.
+// @return bool: false if the baud rate is out of the range of the USART
+//@}
+static bool AutoBaud_Lock(const uint32_t windowCycles, const uint32_t firstEdgeCycles) {
+    const RCC_Clocks rccClock = RCC_GetClocksFreq();
+    // cycles per bit = window / 8: baud rate = CPU clock * 8 / window, 32 bits up to 536MHz
+    const uint32_t measuredBaudRate = ((rccClock.HCLK_Frequency * AUTOBAUD_WINDOW_BITS) + (windowCycles / 2U)) / windowCycles;
+    const uint32_t baudRate = AutoBaud_Snap(measuredBaudRate);
+    USART_BaudRateSetting setting;
+    if (!USART_CalculateBaudRate(autoBaudConfig.Usart, baudRate, &setting)) {
+        return false;
+    }
+    USART_SetBaudRateDivider(autoBaudConfig.Usart, setting.Divider);
+    USART_EnableReceiver(autoBaudConfig.Usart, true);
+    EXTI_EnableInterrupt(1UL << (uint32_t)autoBaudConfig.RxPinSource, false);
+    autoBaudIsRunning = false;
+
+    ++autoBaudStatistics.Locks;
+    autoBaudStatistics.BaudRate = baudRate;
+    autoBaudStatistics.MeasuredBaudRate = measuredBaudRate;
+    autoBaudStatistics.LockCycles = DWT->CYCCNT - firstEdgeCycles;
+    if (autoBaudConfig.Notification != NULL) {
+        autoBaudConfig.Notification(baudRate);
+    }
+    return true;
+}
+
+//@{
+// EXTI line handler of the Rx pin: timestamp of a falling edge, lock on a window of evenly spaced edges.
+//@}
+static void AutoBaud_HandleEdge(void* pContext, const uint32_t lineNumber) {
+    // first: the interval of the timestamps must not contain the work of this handler
+    const uint32_t cycles = DWT->CYCCNT;
+    (void)pContext;
+    (void)lineNumber;
+    if (!autoBaudIsRunning) {
+        return;
+    }
+    autoBaudEdgeCycles[autoBaudEdgeCount % AUTOBAUD_EDGE_COUNT] = cycles;
+    ++autoBaudEdgeCount;
+    if (autoBaudEdgeCount < AUTOBAUD_EDGE_COUNT) {
+        return;
+    }
+
+    const uint32_t firstEdgeCycles = autoBaudEdgeCycles[autoBaudEdgeCount % AUTOBAUD_EDGE_COUNT];
+    const uint32_t windowCycles = cycles - firstEdgeCycles;
+    const uint32_t meanInterval = windowCycles / (AUTOBAUD_EDGE_COUNT - 1U);
+    const uint32_t tolerance = meanInterval / AUTOBAUD_INTERVAL_TOLERANCE_DIVISOR;
+    uint32_t previousCycles = firstEdgeCycles;
+    for (uint32_t index = 1U; index < AUTOBAUD_EDGE_COUNT; ++index) {
+        const uint32_t edgeCycles = autoBaudEdgeCycles[(autoBaudEdgeCount + index) % AUTOBAUD_EDGE_COUNT];
+        const uint32_t interval = edgeCycles - previousCycles;
+        if (((interval + tolerance) < meanInterval) || (interval > (meanInterval + tolerance))) {
+            // not a sync character (yet): the next edge shifts the window
+            ++autoBaudStatistics.SkippedEdges;
+            return;
+        }
+        previousCycles = edgeCycles;
+    }
+    if (!AutoBaud_Lock(windowCycles, firstEdgeCycles)) {
+        ++autoBaudStatistics.SkippedEdges;
+    }
+}
+
+void AutoBaud_Start(const AutoBaud_Config* const pConfig) {
+    if ((pConfig == NULL) || ((pConfig->pBaudRates == NULL) && (pConfig->BaudRateCount != 0U))) {
+        ASSERT_DEBUG(false);
+        return;
+    }
+    const uint32_t lineMask = 1UL << (uint32_t)pConfig->RxPinSource;
+    EXTI_EnableInterrupt(lineMask, false);
+    autoBaudConfig = *pConfig;
+    autoBaudEdgeCount = 0U;
+    autoBaudIsRunning = true;
+    USART_EnableReceiver(pConfig->Usart, false);
+
+    ExtiDispatcher_RegisterHandler((uint32_t)pConfig->RxPinSource, &AutoBaud_HandleEdge, NULL);
+    GPIO_EXTILineConfig(pConfig->RxPortSource, pConfig->RxPinSource);
+    EXTI_InitStruct extiInit;
+    extiInit.Line = (EXTI_Line)lineMask;
+    extiInit.Mode = EXTI_Mode_Interrupt;
+    extiInit.Trigger = EXTI_Trigger_Falling;
+    extiInit.EXTI_Enabled = true;
+    // edges before the start are ignored, the init unmasks the line
+    EXTI_ClearPendingInterrupts(lineMask);
+    EXTI_Init(&extiInit);
+}
+
+bool AutoBaud_IsRunning(void) {
+    return autoBaudIsRunning;
+}
+
+void AutoBaud_GetStatistics(AutoBaud_Statistics* const pStatistics) {
+    if (pStatistics == NULL) {
+        ASSERT_DEBUG(false);
+        return;
+    }
+    const uint32_t previousBasePriority = CriticalSection_Enter(AUTOBAUD_CEILING);
+    *pStatistics = autoBaudStatistics;
+    CriticalSection_Exit(previousBasePriority);
+}
+
+void AutoBaud_ResetStatistics(void) {
+    const uint32_t previousBasePriority = CriticalSection_Enter(AUTOBAUD_CEILING);
+    autoBaudStatistics.Locks = 0U;
+    autoBaudStatistics.SkippedEdges = 0U;
+    autoBaudStatistics.BaudRate = 0U;
+    autoBaudStatistics.MeasuredBaudRate = 0U;
+    autoBaudStatistics.LockCycles = 0U;
+    CriticalSection_Exit(previousBasePriority);
+}
@@ -0,0 +1,109 @@
+// (c) IMT - Information Management Technology AG, CH-9470 Buchs, www.imt.ch.
+// SW guideline: Technote Coding Guidelines Ver. 1.5.1
+
+#ifndef SYSTEMAUTOBAUD_H
+#define SYSTEMAUTOBAUD_H
+
+// Must be very first include
+#include <Imt.Base.Core.Platform/Platform.h>
+
+// Project includes
+#include "SystemPeripherals_USART.h"
+#include "SystemPeripherals_GPIO.h"
+
+// Determine if a C++ compiler is being used.  If so, ensure that standard C is used to process the API information.
+#ifdef __cplusplus
+extern "C" {
+#endif // __cplusplus
+
+//@{
+// Automatic baud rate detection on the Rx pin of a USART from the sync character 0x55 ('U').
+// - Measure: the receiver is disabled and the falling edges of the Rx pin are timestamped with the DWT cycle counter by an
+//   EXTI line handler (@see SystemExtiDispatcher.h). The sync character has five falling edges two bits apart: the start
+//   bit and the data bits 1, 3, 5 and 7. A window of five evenly spaced edges spans 8 bit times, other characters and
+//   noise are skipped edge by edge.
+// - Lock: the baud rate of the window snaps to the nearest standard rate of the configuration within 3%, otherwise the
+//   measured rate is used. Only the divider (BRR) is written and the receiver is enabled again, the frame format and the
+//   DMA of the USART are kept. The sync character itself is not received.
+// - Lock time: from the first edge of the sync character to the enabled receiver in CPU cycles.
+//
+// The interval of two bits must exceed the time of the EXTI interrupt, e.g. up to 115200 baud at 8MHz. The EXTI vector
+// of the Rx line must be enabled in the NVIC at a priority above the interrupts which would delay the timestamps
+// (@see AUTOBAUD_CEILING). One detection at a time.
+//@}
+
+// Sync character sent by the master
+#define AUTOBAUD_SYNC_CHARACTER 0x55U
+
+// Ceiling of the state shared with the EXTI interrupt of the Rx line
+#define AUTOBAUD_CEILING 1U
+
+//@{
+// Called from the interrupt context when the baud rate is locked.
+// @param baudRate: New baud rate of the USART.
+//@}
+typedef void (*AutoBaud_Notification)(const uint32_t baudRate);
+
+//@{
+// Detection configuration
+//@}
+typedef struct {
+    // USART and the port and pin (= EXTI line) of its Rx input
+    USART_ModuleAddress Usart;
+    GPIO_PortSource RxPortSource;
+    GPIO_PinSource RxPinSource;
+
+    // Standard baud rates, NULL for the measured rate only
+    const uint32_t* pBaudRates;
+    uint32_t BaudRateCount;
+
+    // Called on the lock, NULL for polling
+    AutoBaud_Notification Notification;
+} AutoBaud_Config;
+
+//@{
+// Detection statistics since the last reset
+//@}
+typedef struct {
+    // Completed detections
+    uint32_t Locks;
+
+    // Windows of five falling edges which were not evenly spaced or out of the baud rate range
+    uint32_t SkippedEdges;
+
+    // Last detected baud rate and the measured rate before it snapped to a standard rate
+    uint32_t BaudRate;
+    uint32_t MeasuredBaudRate;
+
+    // Last lock time in CPU cycles: first edge of the sync character to the enabled receiver
+    uint32_t LockCycles;
+} AutoBaud_Statistics;
+
+//@{
+// Disable the receiver of the USART and start the detection on its Rx pin. A running detection restarts.
+// The USART keeps transmitting at its current baud rate until the lock.
+// @param pConfig: Detection configuration, the standard baud rates are kept by reference.
+//@}
+void AutoBaud_Start(const AutoBaud_Config* const pConfig);
+
+//@{
+// Returns true while the detection waits for the sync character.
+//@}
+bool AutoBaud_IsRunning(void);
+
+//@{
+// Copy the statistics.
+// @param pStatistics: Pointer to the AutoBaud_Statistics structure to fill.
+//@}
+void AutoBaud_GetStatistics(AutoBaud_Statistics* const pStatistics);
+
+//@{
+// Reset the statistics.
+//@}
+void AutoBaud_ResetStatistics(void);
+
+#ifdef __cplusplus
+}
+#endif // __cplusplus
+
+#endif // SYSTEMAUTOBAUD_H
@@ -0,0 +1,161 @@
+// (c) IMT - Information Management Technology AG, CH-9470 Buchs, www.imt.ch.
+// SW guideline: Technote Coding Guidelines Ver. 1.5.1
+
+#include "SystemEventQueue.h"
+
+// Project includes
+#include "SystemRamCode.h"
+#if defined(__IAR_SYSTEMS_ICC__)
+#include "Core_CortexM3.h"
+#endif // __IAR_SYSTEMS_ICC__
+
+// Imt.Base includes
+#include <Imt.Base.Core.Diagnostics/Diagnostics.h>
+
+void EventQueue_Init(EventQueue* const pQueue, EventQueue_Slot* const pSlots, const uint32_t capacity) {
+    if ((pQueue == NULL) || (pSlots == NULL) || (capacity < 2U) || (capacity > 0x10000U) || ((capacity & (capacity - 1U)) != 0U)) {
+        ASSERT_DEBUG(false);
+        return;
+    }
+    for (uint32_t index = 0U; index < capacity; ++index) {
+        Atomic_Store32(&pSlots[index].Sequence, index);
+    }
+    pQueue->pSlots = pSlots;
+    pQueue->Mask = capacity - 1U;
+    Atomic_Store32(&pQueue->WritePosition, 0U);
+    Atomic_Store32(&pQueue->ReadPosition, 0U);
+    Atomic_Store32(&pQueue->HighWaterMark, 0U);
+    Atomic_Store32(&pQueue->Drops, 0U);
+}
+
+// executed from SRAM, posted from the interrupt handlers; the atomic operations are inline
+SYSTEM_RAMFUNC bool EventQueue_Post(EventQueue* const pQueue, const uint16_t type, const uint16_t parameter, const uint32_t data) {
+    // timestamp before the reservation, a preempting producer does not shift it
+#if defined(__IAR_SYSTEMS_ICC__)
+    const uint32_t cycles = DWT->CYCCNT;
+#else
+    const uint32_t cycles = 0U;
+#endif // __IAR_SYSTEMS_ICC__
+    uint32_t position = Atomic_Load32(&pQueue->WritePosition);
+    EventQueue_Slot* pSlot = NULL;
+    for (;;) {
+        pSlot = &pQueue->pSlots[position & pQueue->Mask];
+        const int32_t difference = (int32_t)(Atomic_Load32(&pSlot->Sequence) - position);
+        if (difference == 0) {
+            // free for this round: reserve it, on failure position is updated to the current write position
+            if (Atomic_CompareExchange32(&pQueue->WritePosition, &position, position + 1U)) {
+                break;
+            }
+        }
+        else if (difference < 0) {
+            // not yet taken by the consumer: full
+            (void)Atomic_FetchAdd32(&pQueue->Drops, 1U);
+            return false;
+        }
+        else {
+            // reserved by a preempting producer
+            position = Atomic_Load32(&pQueue->WritePosition);
+        }
+    }
+
+    pSlot->Event.Type = type;
+    pSlot->Event.Parameter = parameter;
+    pSlot->Event.Data = data;
+    pSlot->Event.Cycles = cycles;
+    Atomic_Store32(&pSlot->Sequence, position + 1U);
+
+    // a consumer running concurrently with the producer may have taken later events meanwhile, then the depth is
+    // negative and not counted
+    const int32_t depth = (int32_t)((position + 1U) - Atomic_Load32(&pQueue->ReadPosition));
+    uint32_t highWaterMark = Atomic_Load32(&pQueue->HighWaterMark);
+    while ((depth > (int32_t)highWaterMark) && !Atomic_CompareExchange32(&pQueue->HighWaterMark, &highWaterMark, (uint32_t)depth)) {
+    }
+    return true;
+}
+
+uint32_t EventQueue_Drain(EventQueue* const pQueue, const EventQueue_Handler handler, void* const pContext, const uint32_t maxEvents) {
+    if ((pQueue == NULL) || (handler == NULL)) {
+        ASSERT_DEBUG(false);
+        return 0U;
+    }
+    uint32_t position = Atomic_Load32(&pQueue->ReadPosition);
+    uint32_t count = 0U;
+    while (count < maxEvents) {
+        EventQueue_Slot* const pSlot = &pQueue->pSlots[position & pQueue->Mask];
+        if (Atomic_Load32(&pSlot->Sequence) != (position + 1U)) {
+            // empty, or reserved by an interrupted producer and not yet committed
+            break;
+        }
+        const EventQueue_Event event = pSlot->Event;
+        // free the slot for the next round before the handler runs, the handler may post again
+        Atomic_Store32(&pSlot->Sequence, position + pQueue->Mask + 1U);
+        ++position;
+        Atomic_Store32(&pQueue->ReadPosition, position);
+        ++count;
+        handler(pContext, &event);
+    }
+    return count;
+}
+
+uint32_t EventQueue_GetHighWaterMark(const EventQueue* const pQueue) {
+    if (pQueue == NULL) {
+        ASSERT_DEBUG(false);
+        return 0U;
+    }
+    return Atomic_Load32(&pQueue->HighWaterMark);
+}
+
+uint32_t EventQueue_GetDropCount(const EventQueue* const pQueue) {
+    if (pQueue == NULL) {
+        ASSERT_DEBUG(false);
+        return 0U;
+    }
+    return Atomic_Load32(&pQueue->Drops);
+}
+
+void EventQueue_ResetStatistics(EventQueue* const pQueue) {
+    if (pQueue == NULL) {
+        ASSERT_DEBUG(false);
+        return;
+    }
+    Atomic_Store32(&pQueue->HighWaterMark, 0U);
+    Atomic_Store32(&pQueue->Drops, 0U);
+}
+
+#if defined(__IAR_SYSTEMS_ICC__)
+// Events posted and drained per benchmark run
+#define EVENTQUEUE_BENCHMARK_EVENTS 16U
+
+// Private queue of the benchmark
+static EventQueue_Slot eventQueueBenchmarkSlots[EVENTQUEUE_BENCHMARK_EVENTS];
+static EventQueue eventQueueBenchmark;
+
+//@{
+// Handler without work for the benchmark.
+//@}
+static void EventQueue_BenchmarkHandler(void* pContext, const EventQueue_Event* const pEvent) {
+    (void)pContext;
+    (void)pEvent;
+}
+
+void EventQueue_MeasureCost(EventQueue_Benchmark* const pBenchmark) {
+    if (pBenchmark == NULL) {
+        ASSERT_DEBUG(false);
+        return;
+    }
+    EventQueue_Init(&eventQueueBenchmark, eventQueueBenchmarkSlots, EVENTQUEUE_BENCHMARK_EVENTS);
+
+    // the first run loads the prefetch buffer, measure the second run
+    for (uint32_t run = 0U; run < 2U; ++run) {
+        uint32_t startCycles = DWT->CYCCNT;
+        for (uint32_t event = 0U; event < EVENTQUEUE_BENCHMARK_EVENTS; ++event) {
+            (void)EventQueue_Post(&eventQueueBenchmark, (uint16_t)event, 0U, event);
+        }
+        pBenchmark->PostCycles = (DWT->CYCCNT - startCycles) / EVENTQUEUE_BENCHMARK_EVENTS;
+
+        startCycles = DWT->CYCCNT;
+        (void)EventQueue_Drain(&eventQueueBenchmark, &EventQueue_BenchmarkHandler, NULL, EVENTQUEUE_BENCHMARK_EVENTS);
+        pBenchmark->DrainCycles = (DWT->CYCCNT - startCycles) / EVENTQUEUE_BENCHMARK_EVENTS;
+    }
+}
+#endif // __IAR_SYSTEMS_ICC__
@@ -0,0 +1,146 @@
+// (c) IMT - Information Management Technology AG, CH-9470 Buchs, www.imt.ch.
+// SW guideline: Technote Coding Guidelines Ver. 1.5.1
+
+#ifndef SYSTEMEVENTQUEUE_H
+#define SYSTEMEVENTQUEUE_H
+
+// Must be very first include
+#include <Imt.Base.Core.Platform/Platform.h>
+
+// Project includes
+#include "Core_Atomic.h"
+
+// Determine if a C++ compiler is being used.  If so, ensure that standard C is used to process the API information.
+#ifdef __cplusplus
+extern "C" {
+#endif // __cplusplus
+
+//@{
+// Bounded lock-free event queue from interrupts (multiple producers) to the main loop (single consumer).
+// Interrupts of any priority post typed events with EventQueue_Post, also while preempting each other: a producer
+// reserves a slot by compare-and-swap of the write position, copies the event and commits the slot by its sequence
+// number. The consumer takes the committed events in order with EventQueue_Drain; a slot reserved by a preempted
+// producer ends the batch until it is committed. No interrupt is masked on either side.
+// A full queue drops the posted event and counts it, the depth high-water mark shows the needed capacity.
+// EventQueue_Post timestamps the event with the DWT cycle counter in the posting context, so the consumer can measure
+// the latency from the interrupt, including the time in the queue.
+// EventQueue_Post is executed from SRAM (@see SystemRamCode.h).
+//
+// Reference: D. Vyukov, Bounded MPMC queue (per slot sequence numbers)
+//@}
+
+//@{
+// Event, the meaning of Type, Parameter and Data is defined by the application
+//@}
+typedef struct {
+    uint16_t Type;
+    uint16_t Parameter;
+    uint32_t Data;
+    // DWT cycle counter when the event was posted (0 on the host)
+    uint32_t Cycles;
+} EventQueue_Event;
+
+//@{
+// Slot of the queue storage
+//@}
+typedef struct {
+    // Position + 1 when committed, position + capacity when free for the next round
+    Atomic_Uint32 Sequence;
+    EventQueue_Event Event;
+} EventQueue_Slot;
+
+//@{
+// Queue, initialize it with EventQueue_Init
+//@}
+typedef struct {
+    EventQueue_Slot* pSlots;
+    // Capacity - 1, the capacity is a power of two
+    uint32_t Mask;
+    // Next position to reserve (producers)
+    Atomic_Uint32 WritePosition;
+    // Next position to take (consumer)
+    Atomic_Uint32 ReadPosition;
+    // Maximum number of events in the queue since the last reset
+    Atomic_Uint32 HighWaterMark;
+    // Events dropped because the queue was full since the last reset
+    Atomic_Uint32 Drops;
+} EventQueue;
+
+//@{
+// Called by EventQueue_Drain for each event in the main loop context.
+// @param pContext: Context passed to EventQueue_Drain.
+// @param pEvent: Event, valid during the call.
+//@}
+typedef void (*EventQueue_Handler)(void* pContext, const EventQueue_Event* const pEvent);
+
+//@{
+// Cycles of the queue operations
+//@}
+typedef struct {
+    // EventQueue_Post per event
+    uint32_t PostCycles;
+
+    // EventQueue_Drain per event (handler without work)
+    uint32_t DrainCycles;
+} EventQueue_Benchmark;
+
+//@{
+// Initialize an empty queue, call it before the producing interrupts are enabled.
+// @param pQueue: Queue.
+// @param pSlots: Storage of capacity slots.
+// @param capacity: Number of slots, a power of two 2..65536.
+//@}
+void EventQueue_Init(EventQueue* const pQueue, EventQueue_Slot* const pSlots, const uint32_t capacity);
+
+//@{
+// Post an event, callable from any interrupt priority and the main loop. The event is timestamped here.
+// @param pQueue: Queue.
+// @param type: Application event type.
+// @param parameter: Application event parameter.
+// @param data: Application event data.
+// @return bool: false if the queue was full, the event is dropped and counted
+//@}
+bool EventQueue_Post(EventQueue* const pQueue, const uint16_t type, const uint16_t parameter, const uint32_t data);
+
+//@{
+// Take up to maxEvents committed events in order and pass each to the handler. Call it from the consumer only.
+// @param pQueue: Queue.
+// @param handler: Event handler.
+// @param pContext: Passed unchanged to the handler.
+// @param maxEvents: Limit of the batch, bounds the time spent in the call.
+// @return uint32_t: Number of events handled
+//@}
+uint32_t EventQueue_Drain(EventQueue* const pQueue, const EventQueue_Handler handler, void* const pContext, const uint32_t maxEvents);
+
+//@{
+// Returns the maximum number of events in the queue since init or the last reset.
+// @param pQueue: Queue.
+//@}
+uint32_t EventQueue_GetHighWaterMark(const EventQueue* const pQueue);
+
+//@{
+// Returns the number of dropped events since init or the last reset.
+// @param pQueue: Queue.
+//@}
+uint32_t EventQueue_GetDropCount(const EventQueue* const pQueue);
+
+//@{
+// Reset the high-water mark and the drop counter.
+// @param pQueue: Queue.
+//@}
+void EventQueue_ResetStatistics(EventQueue* const pQueue);
+
+#if defined(__IAR_SYSTEMS_ICC__)
+//@{
+// Measure the cycles to post and to drain an event on a private queue.
+// Note: Requires the running DWT cycle counter (@see SystemStartupControl.h), call it with interrupts disabled for stable results.
+// @param pBenchmark: Pointer to the EventQueue_Benchmark structure to fill.
+//@}
+void EventQueue_MeasureCost(EventQueue_Benchmark* const pBenchmark);
+#endif // __IAR_SYSTEMS_ICC__
+
+#ifdef __cplusplus
+}
+#endif // __cplusplus
+
+#endif // SYSTEMEVENTQUEUE_H
@@ -0,0 +1,116 @@
+// (c) IMT - Information Management Technology AG, CH-9470 Buchs, www.imt.ch.
+// SW guideline: Technote Coding Guidelines Ver. 1.5.1
+
+#include "SystemExtiDispatcher.h"
+
+// Project includes
+#include "SystemPeripherals_EXTI.h"
+#include "Core_Atomic.h"
+
+// Imt.Base includes
+#include <Imt.Base.Core.Diagnostics/Diagnostics.h>
+
+// IAR includes
+#include <intrinsics.h>
+
+//@{
+// Lines served by each EXTI interrupt vector
+//@}
+#define EXTIDISPATCHER_LINES_9_5    ((uint32_t)0x000003E0)
+#define EXTIDISPATCHER_LINES_15_10  ((uint32_t)0x0000FC00)
+
+//@{
+// Registered line handler
+//@}
+typedef struct {
+    ExtiDispatcher_Handler Handler;
+    void* pContext;
+} ExtiDispatcher_Entry;
+
+// Line handlers indexed by the line number
+static ExtiDispatcher_Entry extiDispatcherEntries[EXTIDISPATCHER_LINE_COUNT];
+
+// Pending lines without a handler, counted by the vectors of all priorities
+static Atomic_Uint32 extiDispatcherSpuriousCount;
+
+//@{
+// Serve all pending lines of a vector.
+// @param vectorLines: Lines of the interrupt vector.
+//@}
+static void ExtiDispatcher_Dispatch(const uint32_t vectorLines) {
+    uint32_t pending = EXTI_GetPendingInterrupts(vectorLines);
+    // an edge during the handlers is latched again and served by the next interrupt
+    EXTI_ClearPendingInterrupts(pending);
+
+    while (pending != 0U) {
+        const uint32_t lineNumber = 31U - (uint32_t)__CLZ(pending);
+        pending &= ~((uint32_t)1U << lineNumber);
+
+        const ExtiDispatcher_Entry* const pEntry = &extiDispatcherEntries[lineNumber];
+        if (pEntry->Handler != NULL) {
+            pEntry->Handler(pEntry->pContext, lineNumber);
+        }
+        else {
+            (void)Atomic_FetchAdd32(&extiDispatcherSpuriousCount, 1U);
+        }
+    }
+}
+
+void ExtiDispatcher_RegisterHandler(const uint32_t lineNumber, const ExtiDispatcher_Handler handler, void* const pContext) {
+    if (lineNumber >= EXTIDISPATCHER_LINE_COUNT) {
+        ASSERT_DEBUG(false);
+        return;
+    }
+    extiDispatcherEntries[lineNumber].Handler = NULL;
+    extiDispatcherEntries[lineNumber].pContext = pContext;
+    extiDispatcherEntries[lineNumber].Handler = handler;
+}
+
+uint32_t ExtiDispatcher_GetSpuriousCount(void) {
+    return Atomic_Load32(&extiDispatcherSpuriousCount);
+}
+
+//------------------------------------------------------------------------------
+// EXTI interrupt handlers (overwrite the weak definitions of vector_table_M.s)
+//------------------------------------------------------------------------------
+#ifdef __cplusplus
+extern "C" {
+#endif // __cplusplus
+void EXTI0_IRQHandler(void);
+void EXTI1_IRQHandler(void);
+void EXTI2_IRQHandler(void);
+void EXTI3_IRQHandler(void);
+void EXTI4_IRQHandler(void);
+void EXTI9_5_IRQHandler(void);
+void EXTI15_10_IRQHandler(void);
+#ifdef __cplusplus
+}
+#endif // __cplusplus
+
+void EXTI0_IRQHandler(void) {
+    ExtiDispatcher_Dispatch((uint32_t)EXTI_Line0);
+}
+
+void EXTI1_IRQHandler(void) {
+    ExtiDispatcher_Dispatch((uint32_t)EXTI_Line1);
+}
+
+void EXTI2_IRQHandler(void) {
+    ExtiDispatcher_Dispatch((uint32_t)EXTI_Line2);
+}
+
+void EXTI3_IRQHandler(void) {
+    ExtiDispatcher_Dispatch((uint32_t)EXTI_Line3);
+}
+
+void EXTI4_IRQHandler(void) {
+    ExtiDispatcher_Dispatch((uint32_t)EXTI_Line4);
+}
+
+void EXTI9_5_IRQHandler(void) {
+    ExtiDispatcher_Dispatch(EXTIDISPATCHER_LINES_9_5);
+}
+
+void EXTI15_10_IRQHandler(void) {
+    ExtiDispatcher_Dispatch(EXTIDISPATCHER_LINES_15_10);
+}
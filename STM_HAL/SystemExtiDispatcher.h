@@ -0,0 +1,55 @@
+// (c) IMT - Information Management Technology AG, CH-9470 Buchs, www.imt.ch.
+// SW guideline: Technote Coding Guidelines Ver. 1.5.1
+
+#ifndef SYSTEMEXTIDISPATCHER_H
+#define SYSTEMEXTIDISPATCHER_H
+
+// Must be very first include
+#include <Imt.Base.Core.Platform/Platform.h>
+
+// Determine if a C++ compiler is being used.  If so, ensure that standard C is used to process the API information.
+#ifdef __cplusplus
+extern "C" {
+#endif // __cplusplus
+
+//@{
+// Demultiplexer of the EXTI interrupt vectors to per-line handlers.
+// The lines 0..4 have a vector each, the lines 5..9 and 10..15 share one vector.
+// This module defines the interrupt handlers EXTI0_IRQHandler .. EXTI4_IRQHandler, EXTI9_5_IRQHandler and
+// EXTI15_10_IRQHandler: each reads the pending register once, clears the pending lines of its vector with one write
+// and calls the registered handler of every pending line, highest line first (count leading zeros).
+// Adding an input means registering a handler, the interrupt handlers are not edited.
+// Pending lines without a handler are cleared and counted as spurious.
+//
+// Reference: ST_CortexM3_STM32F103_TRM_Rev15.pdf Chapter 8.2 External interrupt/event controller
+//@}
+
+// Number of EXTI lines with a GPIO source (EXTI0..EXTI15)
+#define EXTIDISPATCHER_LINE_COUNT 16U
+
+//@{
+// Handler of an EXTI line, called in the interrupt context after the pending bit was cleared.
+// @param pContext: Context registered with ExtiDispatcher_RegisterHandler.
+// @param lineNumber: EXTI line 0..15 which triggered.
+//@}
+typedef void (*ExtiDispatcher_Handler)(void* pContext, const uint32_t lineNumber);
+
+//@{
+// Register the handler of a line, replaces a previous registration.
+// Register before the line and its NVIC interrupt are enabled.
+// @param lineNumber: EXTI line 0..15.
+// @param handler: Line handler, NULL removes the registration.
+// @param pContext: Passed unchanged to the handler.
+//@}
+void ExtiDispatcher_RegisterHandler(const uint32_t lineNumber, const ExtiDispatcher_Handler handler, void* const pContext);
+
+//@{
+// Returns the number of pending lines which had no handler since reset.
+//@}
+uint32_t ExtiDispatcher_GetSpuriousCount(void);
+
+#ifdef __cplusplus
+}
+#endif // __cplusplus
+
+#endif // SYSTEMEXTIDISPATCHER_H
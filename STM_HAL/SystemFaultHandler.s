@@ -0,0 +1,40 @@
+// (c) IMT - Information Management Technology AG, CH-9470 Buchs, www.imt.ch.
+// SW guideline: Technote Coding Guidelines Ver. 1.5.1
+
+//------------------------------------------------------------------------------
+// Fault handlers (overwrite the weak definitions of vector_table_M.s)
+// The processor stacks R0-R3, R12, LR, PC and xPSR of the faulting context on its stack pointer: the process stack
+// in thread mode (main context), the main stack in handler mode (interrupts). Bit 2 of EXC_RETURN in LR tells which.
+// This assembler module performs:
+// - Pass the exception frame and EXC_RETURN to FaultRecord_Capture (@see SystemFaultRecord.h)
+// The capture does not return, it resets the system.
+//------------------------------------------------------------------------------
+
+        MODULE  ?systemFaultHandler
+
+        EXTERN  FaultRecord_Capture
+
+; EXC_RETURN: the exception frame is on the process stack
+EXC_RETURN_PROCESS_STACK EQU     0x04
+
+THUMB
+        PUBLIC  HardFault_Handler
+        PUBLIC  MemManage_Handler
+        PUBLIC  BusFault_Handler
+        PUBLIC  UsageFault_Handler
+        SECTION .text:CODE:REORDER:NOROOT(2)
+HardFault_Handler
+MemManage_Handler
+BusFault_Handler
+UsageFault_Handler
+        ; R0: exception frame of the faulting context
+        TST     LR, #EXC_RETURN_PROCESS_STACK
+        ITE     EQ
+        MRSEQ   R0, MSP
+        MRSNE   R0, PSP
+        ; R1: EXC_RETURN
+        MOV     R1, LR
+        LDR     R2, =FaultRecord_Capture
+        BX      R2
+
+        END
@@ -0,0 +1,111 @@
+// (c) IMT - Information Management Technology AG, CH-9470 Buchs, www.imt.ch.
+// SW guideline: Technote Coding Guidelines Ver. 1.5.1
+
+#include "SystemFaultRecord.h"
+
+// Project includes
+#include "Core_CortexM3.h"
+#include "SystemMemoryMap.h"
+#include "SystemStartupControl.h"
+
+// Imt.Base includes
+#include <Imt.Base.Core.Diagnostics/Diagnostics.h>
+
+// IAR includes
+#include <intrinsics.h>
+
+// Marks valid records, random after a power on
+#define FAULTRECORD_MAGIC 0x46524543U
+// Size of the exception frame of the Cortex-M3 (R0, R1, R2, R3, R12, LR, PC, xPSR)
+#define FAULTRECORD_FRAME_SIZE 32U
+
+//@{
+// Records in .noinit, not touched by the startup: written before the fault reset, read after it
+//@}
+typedef struct {
+    uint32_t Magic;
+    // Faults since the records were cleared, the last record is at (Count - 1) % FAULTRECORD_MAX_RECORDS
+    uint32_t Count;
+    FaultRecord Records[FAULTRECORD_MAX_RECORDS];
+} FaultRecord_Store;
+
+static STARTUP_NOINIT FaultRecord_Store faultRecordStore;
+
+void FaultRecord_Init(void) {
+    if (faultRecordStore.Magic != FAULTRECORD_MAGIC) {
+        FaultRecord_Clear();
+    }
+    // separate handlers instead of the escalation to the hard fault, the status shows the cause
+    SCB->CCR |= SCB_CCR_DIV_0_TRP;
+    SCB->SHCRS |= (SCB_SHCSR_MEMFAULTENA | SCB_SHCSR_BUSFAULTENA | SCB_SHCSR_USGFAULTENA);
+}
+
+uint32_t FaultRecord_GetCount(void) {
+    return faultRecordStore.Count;
+}
+
+bool FaultRecord_Get(const uint32_t index, FaultRecord* const pRecord) {
+    if (pRecord == NULL) {
+        ASSERT_DEBUG(false);
+        return false;
+    }
+    if ((index >= faultRecordStore.Count) || (index >= FAULTRECORD_MAX_RECORDS)) {
+        return false;
+    }
+    *pRecord = faultRecordStore.Records[(faultRecordStore.Count - 1U - index) % FAULTRECORD_MAX_RECORDS];
+    return true;
+}
+
+void FaultRecord_Clear(void) {
+    faultRecordStore.Count = 0U;
+    faultRecordStore.Magic = FAULTRECORD_MAGIC;
+}
+
+void FaultRecord_Capture(const uint32_t* const pStackFrame, const uint32_t excReturn) {
+    if (faultRecordStore.Magic != FAULTRECORD_MAGIC) {
+        // fault before FaultRecord_Init
+        FaultRecord_Clear();
+    }
+    FaultRecord* const pRecord = &faultRecordStore.Records[faultRecordStore.Count % FAULTRECORD_MAX_RECORDS];
+    pRecord->Exception = SCB->ICSR & SCB_ICSR_VECTACTIVE;
+    pRecord->ExcReturn = excReturn;
+    pRecord->CFSR = SCB->CFSR;
+    pRecord->HFSR = SCB->HFSR;
+    pRecord->MMFAR = SCB->MMAR;
+    pRecord->BFAR = SCB->BFAR;
+    pRecord->Cycles = DWT->CYCCNT;
+
+    // a stack overflow may leave the stack pointer outside of the RAM, reading the frame would fault again (lockup)
+    const uint32_t frameAddress = (uint32_t)pStackFrame; //lint !e923 cast from pointer to int [MISRA C++ Rule 5-2-9]. Justification: address range check
+    if ((frameAddress >= SRAM_BASE) && (frameAddress <= ((SRAM_BASE + SRAM_SIZE) - FAULTRECORD_FRAME_SIZE)) && ((frameAddress % 4U) == 0U)) {
+        pRecord->R0 = pStackFrame[0];
+        pRecord->R1 = pStackFrame[1];
+        pRecord->R2 = pStackFrame[2];
+        pRecord->R3 = pStackFrame[3];
+        pRecord->R12 = pStackFrame[4];
+        pRecord->LR = pStackFrame[5];
+        pRecord->PC = pStackFrame[6];
+        pRecord->XPSR = pStackFrame[7];
+    }
+    else {
+        pRecord->R0 = 0U;
+        pRecord->R1 = 0U;
+        pRecord->R2 = 0U;
+        pRecord->R3 = 0U;
+        pRecord->R12 = 0U;
+        pRecord->LR = 0U;
+        pRecord->PC = 0U;
+        pRecord->XPSR = 0U;
+    }
+    ++faultRecordStore.Count;
+
+#if defined(__IAR_SYSTEMS_ICC__)
+    // the records are in RAM, a system reset keeps them
+    __DSB();
+    SCB->AIRCR = SCB_AIRCR_VECTKEY | (SCB->AIRCR & SCB_AIRCR_PRIGROUP_Mask) | SCB_AIRCR_SYSRESETREQ;
+    __DSB();
+    for (;;) {
+        // wait for the reset
+    }
+#endif // __IAR_SYSTEMS_ICC__
+}
@@ -0,0 +1,89 @@
+// (c) IMT - Information Management Technology AG, CH-9470 Buchs, www.imt.ch.
+// SW guideline: Technote Coding Guidelines Ver. 1.5.1
+
+#ifndef SYSTEMFAULTRECORD_H
+#define SYSTEMFAULTRECORD_H
+
+// Must be very first include
+#include <Imt.Base.Core.Platform/Platform.h>
+
+// Determine if a C++ compiler is being used.  If so, ensure that standard C is used to process the API information.
+#ifdef __cplusplus
+extern "C" {
+#endif // __cplusplus
+
+//@{
+// Records of the CPU faults which survive the reset, read out in the field (e.g. by the command shell).
+// The fault handlers of SystemFaultHandler.s (HardFault, MemManage, BusFault and UsageFault) pass the exception frame of
+// the faulting context to FaultRecord_Capture. It stores the stacked registers and the fault status registers in a ring
+// of records in .noinit and resets the system. FaultRecord_Init validates the records after the reset: after a power on
+// the .noinit content is random and the records are cleared.
+//
+// Reference: Cortex-M3 Devices Generic User Guide DUI0552A Chapter 2.3.7 Exception entry and return, Chapter 4.3.10
+//@}
+
+// Number of stored records, the oldest record is overwritten
+#define FAULTRECORD_MAX_RECORDS 4U
+
+//@{
+// Fault record: the registers stacked on exception entry and the fault status registers
+//@}
+typedef struct {
+    // Exception number: 3 HardFault, 4 MemManage, 5 BusFault, 6 UsageFault
+    uint32_t Exception;
+    // Stacked registers of the faulting context, PC is the faulting instruction (or the next one of an imprecise bus fault)
+    uint32_t R0;
+    uint32_t R1;
+    uint32_t R2;
+    uint32_t R3;
+    uint32_t R12;
+    uint32_t LR;
+    uint32_t PC;
+    uint32_t XPSR;
+    // LR on exception entry: thread or handler mode, process or main stack
+    uint32_t ExcReturn;
+    // Configurable, hard fault status and fault address registers (valid if flagged in CFSR)
+    uint32_t CFSR;
+    uint32_t HFSR;
+    uint32_t MMFAR;
+    uint32_t BFAR;
+    // DWT cycle counter at the fault, cycles since the reset
+    uint32_t Cycles;
+} FaultRecord;
+
+//@{
+// Validate the records after the reset and enable the MemManage, BusFault and UsageFault handlers and the trap on a
+// division by zero. Call it first in main.
+//@}
+void FaultRecord_Init(void);
+
+//@{
+// Returns the number of faults since the records were cleared, the last FAULTRECORD_MAX_RECORDS are stored.
+//@}
+uint32_t FaultRecord_GetCount(void);
+
+//@{
+// Copy a stored record.
+// @param index: 0 is the last fault.
+// @param pRecord: Pointer to the FaultRecord structure to fill.
+// @return bool: false if no record is stored at the index
+//@}
+bool FaultRecord_Get(const uint32_t index, FaultRecord* const pRecord);
+
+//@{
+// Clear the records.
+//@}
+void FaultRecord_Clear(void);
+
+//@{
+// Store the record of a fault and reset the system, called by the fault handlers of SystemFaultHandler.s.
+// @param pStackFrame: Exception frame of the faulting context (R0, R1, R2, R3, R12, LR, PC, xPSR).
+// @param excReturn: LR on exception entry.
+//@}
+void FaultRecord_Capture(const uint32_t* const pStackFrame, const uint32_t excReturn);
+
+#ifdef __cplusplus
+}
+#endif // __cplusplus
+
+#endif // SYSTEMFAULTRECORD_H
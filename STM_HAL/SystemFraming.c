@@ -0,0 +1,359 @@
+// (c) IMT - Information Management Technology AG, CH-9470 Buchs, www.imt.ch.
+// SW guideline: Technote Coding Guidelines Ver. 1.5.1
+
+#include "SystemFraming.h"
+
+// Project includes
+#include "SystemPeripherals_CRC.h"
+
+// Imt.Base includes
+#include <Imt.Base.Core.Diagnostics/Diagnostics.h>
+
+// COBS code of a block of 254 data bytes without a following zero
+#define FRAMING_COBS_MAX_CODE 0xFFU
+
+//@{
+// Encoder state: the code byte of the current block is written when the block ends
+//@}
+typedef struct {
+    uint8_t* pOutput;
+    uint8_t* pCode;
+    uint32_t Code;
+} Framing_Encoder;
+
+//@{
+// Append bytes to the encoded frame.
+//@}
+static void Framing_EncodeBytes(Framing_Encoder* const pEncoder, const uint8_t* const pBytes, const uint32_t size) {
+    uint8_t* pOutput = pEncoder->pOutput;
+    uint8_t* pCode = pEncoder->pCode;
+    uint32_t code = pEncoder->Code;
+    for (uint32_t index = 0U; index < size; ++index) {
+        const uint8_t value = pBytes[index];
+        if (value == FRAMING_DELIMITER) {
+            *pCode = (uint8_t)code;
+            pCode = pOutput;
+            ++pOutput;
+            code = 1U;
+        }
+        else {
+            *pOutput = value;
+            ++pOutput;
+            ++code;
+            if (code == FRAMING_COBS_MAX_CODE) {
+                *pCode = (uint8_t)code;
+                pCode = pOutput;
+                ++pOutput;
+                code = 1U;
+            }
+        }
+    }
+    pEncoder->pOutput = pOutput;
+    pEncoder->pCode = pCode;
+    pEncoder->Code = code;
+}
+
+uint32_t Framing_Encode(uint8_t* const pDestination, const uint32_t capacity, const uint8_t sequence, const void* const pPayload, const uint32_t size) {
+    if ((pDestination == NULL) || ((pPayload == NULL) && (size != 0U))) {
+        ASSERT_DEBUG(false);
+        return 0U;
+    }
+    if (capacity < FRAMING_MAX_ENCODED_SIZE(size)) {
+        return 0U;
+    }
+
+    CRC_Context crc;
+    CRC_Begin(&crc);
+    CRC_Update(&crc, &sequence, FRAMING_HEADER_SIZE);
+    CRC_Update(&crc, pPayload, size);
+    const uint32_t crcValue = CRC_GetValue(&crc);
+    const uint8_t trailer[FRAMING_TRAILER_SIZE] = {
+        (uint8_t)crcValue, (uint8_t)(crcValue >> 8), (uint8_t)(crcValue >> 16), (uint8_t)(crcValue >> 24)
+    };
+
+    Framing_Encoder encoder;
+    encoder.pCode = pDestination;
+    encoder.pOutput = pDestination + 1;
+    encoder.Code = 1U;
+    Framing_EncodeBytes(&encoder, &sequence, FRAMING_HEADER_SIZE);
+    Framing_EncodeBytes(&encoder, (const uint8_t*)pPayload, size);
+    Framing_EncodeBytes(&encoder, trailer, FRAMING_TRAILER_SIZE);
+    *encoder.pCode = (uint8_t)encoder.Code;
+    *encoder.pOutput = FRAMING_DELIMITER;
+    return (uint32_t)(encoder.pOutput - pDestination) + 1U;
+}
+
+//@{
+// Forget the frame being decoded, the next non-delimiter byte starts a new frame.
+//@}
+static void Framing_RestartFrame(Framing_Decoder* const pDecoder) {
+    pDecoder->SegmentCount = 0U;
+    pDecoder->pWrite = NULL;
+    pDecoder->Size = 0U;
+    pDecoder->EncodedSize = 0U;
+    pDecoder->BlockRemaining = 0U;
+    pDecoder->IsZeroPending = false;
+    pDecoder->IsDiscarding = false;
+}
+
+//@{
+// Drop the frame being decoded as overflow, the bytes up to the next delimiter are skipped.
+//@}
+static void Framing_DiscardOverflow(Framing_Decoder* const pDecoder) {
+    ++pDecoder->Statistics.Overflows;
+    pDecoder->IsDiscarding = true;
+}
+
+//@{
+// Start a segment at the current input position, an empty last segment is moved.
+// @return bool: false if the frame has no segment left (it is discarded)
+//@}
+static bool Framing_StartSegment(Framing_Decoder* const pDecoder, uint8_t* const pInput) {
+    if ((pDecoder->SegmentCount != 0U) && (pDecoder->SegmentSizes[pDecoder->SegmentCount - 1U] == 0U)) {
+        --pDecoder->SegmentCount;
+    }
+    if (pDecoder->SegmentCount == FRAMING_MAX_SEGMENTS) {
+        Framing_DiscardOverflow(pDecoder);
+        return false;
+    }
+    pDecoder->pSegments[pDecoder->SegmentCount] = pInput;
+    pDecoder->SegmentSizes[pDecoder->SegmentCount] = 0U;
+    ++pDecoder->SegmentCount;
+    pDecoder->pWrite = pInput;
+    return true;
+}
+
+//@{
+// Returns a decoded byte of the frame.
+// @param index: Index 0..Size-1 in the decoded frame.
+//@}
+static uint8_t Framing_GetDecodedByte(const Framing_Decoder* const pDecoder, uint32_t index) {
+    uint32_t segment = 0U;
+    while (index >= pDecoder->SegmentSizes[segment]) {
+        index -= pDecoder->SegmentSizes[segment];
+        ++segment;
+    }
+    return pDecoder->pSegments[segment][index];
+}
+
+//@{
+// Check the frame ended by a delimiter and pass it to the handler.
+//@}
+static void Framing_CompleteFrame(Framing_Decoder* const pDecoder) {
+    Framing_Statistics* const pStatistics = &pDecoder->Statistics;
+    if ((pDecoder->BlockRemaining != 0U) || (pDecoder->Size < (FRAMING_HEADER_SIZE + FRAMING_TRAILER_SIZE))) {
+        ++pStatistics->FormatErrors;
+        return;
+    }
+
+    // CRC of sequence number and payload, the segments in stream order
+    const uint32_t checkedSize = pDecoder->Size - FRAMING_TRAILER_SIZE;
+    CRC_Context crc;
+    CRC_Begin(&crc);
+    uint32_t remaining = checkedSize;
+    for (uint32_t segment = 0U; segment < pDecoder->SegmentCount; ++segment) {
+        const uint32_t size = (pDecoder->SegmentSizes[segment] < remaining) ? pDecoder->SegmentSizes[segment] : remaining;
+        CRC_Update(&crc, pDecoder->pSegments[segment], size);
+        remaining -= size;
+    }
+    uint32_t receivedCrc = 0U;
+    for (uint32_t index = 0U; index < FRAMING_TRAILER_SIZE; ++index) {
+        receivedCrc |= (uint32_t)Framing_GetDecodedByte(pDecoder, checkedSize + index) << (8U * index);
+    }
+    if (receivedCrc != CRC_GetValue(&crc)) {
+        ++pStatistics->CrcErrors;
+        return;
+    }
+
+    // payload segments without sequence number and CRC
+    Framing_Frame frame;
+    frame.Sequence = Framing_GetDecodedByte(pDecoder, 0U);
+    frame.Size = checkedSize - FRAMING_HEADER_SIZE;
+    frame.SegmentCount = 0U;
+    uint32_t skip = FRAMING_HEADER_SIZE;
+    remaining = frame.Size;
+    for (uint32_t segment = 0U; segment < pDecoder->SegmentCount; ++segment) {
+        const uint8_t* pBytes = pDecoder->pSegments[segment];
+        uint32_t size = pDecoder->SegmentSizes[segment];
+        const uint32_t skipped = (skip < size) ? skip : size;
+        pBytes += skipped;
+        size -= skipped;
+        skip -= skipped;
+        if (size > remaining) {
+            size = remaining;
+        }
+        if (size != 0U) {
+            frame.pSegments[frame.SegmentCount] = pBytes;
+            frame.SegmentSizes[frame.SegmentCount] = size;
+            ++frame.SegmentCount;
+            remaining -= size;
+        }
+    }
+
+    if (pDecoder->IsSequenceValid && (frame.Sequence != pDecoder->NextSequence)) {
+        ++pStatistics->SequenceErrors;
+    }
+    pDecoder->NextSequence = (uint8_t)(frame.Sequence + 1U);
+    pDecoder->IsSequenceValid = true;
+    ++pStatistics->Frames;
+    pDecoder->Handler(pDecoder->pContext, &frame);
+}
+
+void Framing_DecoderInit(Framing_Decoder* const pDecoder, const uint32_t maxPayloadSize, const Framing_FrameHandler handler, void* const pContext) {
+    if ((pDecoder == NULL) || (handler == NULL)) {
+        ASSERT_DEBUG(false);
+        return;
+    }
+    pDecoder->Handler = handler;
+    pDecoder->pContext = pContext;
+    pDecoder->MaxFrameSize = maxPayloadSize + FRAMING_HEADER_SIZE + FRAMING_TRAILER_SIZE;
+    pDecoder->pChunkEnd = NULL;
+    pDecoder->NextSequence = 0U;
+    pDecoder->IsSequenceValid = false;
+    Framing_RestartFrame(pDecoder);
+    Framing_ResetStatistics(pDecoder);
+}
+
+void Framing_DecoderPut(Framing_Decoder* const pDecoder, uint8_t* const pChunk, const uint32_t size) {
+    if ((pDecoder == NULL) || ((pChunk == NULL) && (size != 0U))) {
+        ASSERT_DEBUG(false);
+        return;
+    }
+    if (size == 0U) {
+        return;
+    }
+    uint8_t* pInput = pChunk;
+    uint8_t* const pEnd = pChunk + size;
+
+    // a frame continued in memory which is not adjacent to the last chunk
+    if ((pDecoder->SegmentCount != 0U) && !pDecoder->IsDiscarding && (pChunk != pDecoder->pChunkEnd)) {
+        (void)Framing_StartSegment(pDecoder, pChunk);
+    }
+
+    while (pInput < pEnd) {
+        const uint8_t value = *pInput;
+        if (value == FRAMING_DELIMITER) {
+            if ((pDecoder->SegmentCount != 0U) && !pDecoder->IsDiscarding) {
+                Framing_CompleteFrame(pDecoder);
+            }
+            Framing_RestartFrame(pDecoder);
+            ++pInput;
+        }
+        else if (pDecoder->IsDiscarding) {
+            ++pInput;
+        }
+        else if (pDecoder->BlockRemaining == 0U) {
+            // code byte: the zero ending the previous block, the length of the next block
+            if ((pDecoder->SegmentCount == 0U) && !Framing_StartSegment(pDecoder, pInput)) {
+                continue;
+            }
+            if (pDecoder->IsZeroPending) {
+                if (pDecoder->Size >= pDecoder->MaxFrameSize) {
+                    Framing_DiscardOverflow(pDecoder);
+                    continue;
+                }
+                *pDecoder->pWrite = 0U;
+                ++pDecoder->pWrite;
+                ++pDecoder->SegmentSizes[pDecoder->SegmentCount - 1U];
+                ++pDecoder->Size;
+            }
+            pDecoder->BlockRemaining = (uint32_t)value - 1U;
+            pDecoder->IsZeroPending = (value != FRAMING_COBS_MAX_CODE);
+            ++pDecoder->EncodedSize;
+            ++pInput;
+        }
+        else {
+            // data bytes of the block up to the end of the chunk, a delimiter ends the run (truncated block)
+            uint32_t run = (uint32_t)(pEnd - pInput);
+            if (run > pDecoder->BlockRemaining) {
+                run = pDecoder->BlockRemaining;
+            }
+            if ((pDecoder->Size + run) > pDecoder->MaxFrameSize) {
+                Framing_DiscardOverflow(pDecoder);
+                continue;
+            }
+            uint8_t* pWrite = pDecoder->pWrite;
+            uint32_t count = 0U;
+            while ((count < run) && (pInput[count] != FRAMING_DELIMITER)) {
+                pWrite[count] = pInput[count];
+                ++count;
+            }
+            pInput += count;
+            pDecoder->pWrite = pWrite + count;
+            pDecoder->SegmentSizes[pDecoder->SegmentCount - 1U] += count;
+            pDecoder->Size += count;
+            pDecoder->EncodedSize += count;
+            pDecoder->BlockRemaining -= count;
+        }
+    }
+    pDecoder->pChunkEnd = pEnd;
+}
+
+void Framing_DecoderReset(Framing_Decoder* const pDecoder) {
+    if (pDecoder == NULL) {
+        ASSERT_DEBUG(false);
+        return;
+    }
+    Framing_RestartFrame(pDecoder);
+    pDecoder->IsDiscarding = true;
+}
+
+void Framing_GetStatistics(const Framing_Decoder* const pDecoder, Framing_Statistics* const pStatistics) {
+    if ((pDecoder == NULL) || (pStatistics == NULL)) {
+        ASSERT_DEBUG(false);
+        return;
+    }
+    *pStatistics = pDecoder->Statistics;
+}
+
+void Framing_ResetStatistics(Framing_Decoder* const pDecoder) {
+    if (pDecoder == NULL) {
+        ASSERT_DEBUG(false);
+        return;
+    }
+    pDecoder->Statistics.Frames = 0U;
+    pDecoder->Statistics.CrcErrors = 0U;
+    pDecoder->Statistics.SequenceErrors = 0U;
+    pDecoder->Statistics.Overflows = 0U;
+    pDecoder->Statistics.FormatErrors = 0U;
+}
+
+//@{
+// Buffers of the benchmark: generated payload and the encoded frame, decoded in place
+//@}
+static uint8_t framingBenchmarkPayload[FRAMING_BENCHMARK_MAX_SIZE];
+static uint8_t framingBenchmarkEncoded[FRAMING_MAX_ENCODED_SIZE(FRAMING_BENCHMARK_MAX_SIZE)];
+static Framing_Decoder framingBenchmarkDecoder;
+
+//@{
+// Handler without work for the benchmark.
+//@}
+static void Framing_BenchmarkHandler(void* pContext, const Framing_Frame* const pFrame) {
+    (void)pContext;
+    (void)pFrame;
+}
+
+void Framing_MeasureCost(const Framing_Clock clock, const uint32_t size, Framing_Benchmark* const pBenchmark) {
+    if ((clock == NULL) || (size == 0U) || (size > FRAMING_BENCHMARK_MAX_SIZE) || (pBenchmark == NULL)) {
+        ASSERT_DEBUG(false);
+        return;
+    }
+    // every 16th byte is zero: typical binary data with some stuffing
+    for (uint32_t index = 0U; index < size; ++index) {
+        framingBenchmarkPayload[index] = ((index % 16U) == 0U) ? 0U : (uint8_t)(index * 7U);
+    }
+    Framing_DecoderInit(&framingBenchmarkDecoder, size, &Framing_BenchmarkHandler, NULL);
+    pBenchmark->Size = size;
+
+    // the first run loads the flash prefetch buffer, measure the second run
+    for (uint32_t run = 0U; run < 2U; ++run) {
+        uint32_t startCycles = clock();
+        const uint32_t encodedSize = Framing_Encode(framingBenchmarkEncoded, sizeof(framingBenchmarkEncoded), (uint8_t)run,
+                                                    framingBenchmarkPayload, size);
+        pBenchmark->EncodeCyclesPerByte = (clock() - startCycles) / size;
+
+        startCycles = clock();
+        Framing_DecoderPut(&framingBenchmarkDecoder, framingBenchmarkEncoded, encodedSize);
+        pBenchmark->DecodeCyclesPerByte = (clock() - startCycles) / size;
+    }
+}
@@ -0,0 +1,201 @@
+// (c) IMT - Information Management Technology AG, CH-9470 Buchs, www.imt.ch.
+// SW guideline: Technote Coding Guidelines Ver. 1.5.1
+
+#ifndef SYSTEMFRAMING_H
+#define SYSTEMFRAMING_H
+
+// Must be very first include
+#include <Imt.Base.Core.Platform/Platform.h>
+
+// Determine if a C++ compiler is being used.  If so, ensure that standard C is used to process the API information.
+#ifdef __cplusplus
+extern "C" {
+#endif // __cplusplus
+
+//@{
+// Framed binary protocol over a byte stream (USART).
+// A frame is [sequence][payload...][CRC32 of sequence and payload, little endian], COBS encoded and terminated by 0x00:
+// the encoded frame contains no zero byte, a receiver synchronizes on the next 0x00 after any error.
+//
+// Framing_Encode writes the encoded frame in one pass directly into the destination, e.g. a reserved region of the
+// transmit DMA buffer (@see SystemUsartLink.h).
+// Framing_Decoder decodes incrementally chunk by chunk in place: the decoded bytes are written back into the chunk
+// memory (COBS output never overtakes its input), no temporary frame buffer exists. Chunks which are not adjacent in
+// memory (the wrap of a receive ring) start a new segment, a frame is passed to the handler as at most two segments.
+// The memory of a frame must stay untouched until the frame is handled: a receive ring must hold FRAMING_MAX_ENCODED_SIZE
+// of the longest frame plus the bytes received while it is decoded.
+// The CRC is calculated with the CRC unit (@see SystemPeripherals_CRC.h), from the execution level of the decoder.
+//
+// Reference: S. Cheshire, M. Baker, Consistent Overhead Byte Stuffing, IEEE/ACM Transactions on Networking, 1999
+//@}
+
+// Frame delimiter
+#define FRAMING_DELIMITER 0x00U
+
+// Bytes added to the payload before encoding: sequence number and CRC32
+#define FRAMING_HEADER_SIZE  1U
+#define FRAMING_TRAILER_SIZE 4U
+
+// Maximum encoded size of a payload including the COBS code bytes and the delimiter
+#define FRAMING_MAX_ENCODED_SIZE(payloadSize) \
+    ((payloadSize) + FRAMING_HEADER_SIZE + FRAMING_TRAILER_SIZE + (((payloadSize) + FRAMING_HEADER_SIZE + FRAMING_TRAILER_SIZE) / 254U) + 2U)
+
+// Maximum number of memory segments of a decoded frame
+#define FRAMING_MAX_SEGMENTS 2U
+
+// Maximum payload size of Framing_MeasureCost
+#define FRAMING_BENCHMARK_MAX_SIZE 256U
+
+//@{
+// Decoded frame passed to the Framing_FrameHandler, the payload without sequence number and CRC
+//@}
+typedef struct {
+    uint8_t Sequence;
+    // Payload size, sum of the segment sizes
+    uint32_t Size;
+    uint32_t SegmentCount;
+    const uint8_t* pSegments[FRAMING_MAX_SEGMENTS];
+    uint32_t SegmentSizes[FRAMING_MAX_SEGMENTS];
+} Framing_Frame;
+
+//@{
+// Called for each received frame with a valid CRC.
+// @param pContext: Context of the decoder.
+// @param pFrame: Frame, the payload memory is valid during the call.
+//@}
+typedef void (*Framing_FrameHandler)(void* pContext, const Framing_Frame* const pFrame);
+
+//@{
+// Decoder statistics since init or the last reset
+//@}
+typedef struct {
+    // Frames passed to the handler
+    uint32_t Frames;
+
+    // Frames with a wrong CRC
+    uint32_t CrcErrors;
+
+    // Frames whose sequence number is not the previous one + 1 (lost or repeated frames), they are passed to the handler
+    uint32_t SequenceErrors;
+
+    // Frames longer than the maximum size or spread over more than FRAMING_MAX_SEGMENTS segments
+    uint32_t Overflows;
+
+    // Frames shorter than sequence number and CRC or truncated by the delimiter inside a COBS block
+    uint32_t FormatErrors;
+} Framing_Statistics;
+
+//@{
+// Incremental decoder, initialize it with Framing_DecoderInit
+//@}
+typedef struct {
+    Framing_FrameHandler Handler;
+    void* pContext;
+    // Maximum decoded size of a frame (sequence number, payload and CRC)
+    uint32_t MaxFrameSize;
+
+    // Segments of the frame being decoded, the decoded bytes are written at pWrite in the last segment
+    uint8_t* pSegments[FRAMING_MAX_SEGMENTS];
+    uint32_t SegmentSizes[FRAMING_MAX_SEGMENTS];
+    uint32_t SegmentCount;
+    uint8_t* pWrite;
+    // End of the last chunk, a chunk starting there continues the last segment
+    const uint8_t* pChunkEnd;
+    // Decoded bytes of the frame
+    uint32_t Size;
+    // Encoded bytes of the frame received so far
+    uint32_t EncodedSize;
+
+    // COBS state: data bytes left in the current block, a zero follows the block, skip until the delimiter
+    uint32_t BlockRemaining;
+    bool IsZeroPending;
+    bool IsDiscarding;
+
+    // Sequence number expected next, invalid before the first frame
+    uint8_t NextSequence;
+    bool IsSequenceValid;
+
+    Framing_Statistics Statistics;
+} Framing_Decoder;
+
+//@{
+// Cycles per byte of encoding and decoding (including the CRC)
+//@}
+typedef struct {
+    // Payload size of the measured frame
+    uint32_t Size;
+
+    // Framing_Encode, cycles per payload byte
+    uint32_t EncodeCyclesPerByte;
+
+    // Framing_DecoderPut of the encoded frame, cycles per payload byte
+    uint32_t DecodeCyclesPerByte;
+} Framing_Benchmark;
+
+//@{
+// Returns a cycle counter, the clock of Framing_MeasureCost.
+//@}
+typedef uint32_t (*Framing_Clock)(void);
+
+//@{
+// Encode a frame into the destination.
+// @param pDestination: Destination, e.g. reserved transmit DMA memory, must not overlap the payload.
+// @param capacity: Size of the destination, at least FRAMING_MAX_ENCODED_SIZE(size).
+// @param sequence: Sequence number of the frame.
+// @param pPayload: Payload, NULL if size is 0.
+// @param size: Payload size in bytes.
+// @return uint32_t: Encoded size including the delimiter, 0 if the capacity is too small
+//@}
+uint32_t Framing_Encode(uint8_t* const pDestination, const uint32_t capacity, const uint8_t sequence, const void* const pPayload, const uint32_t size);
+
+//@{
+// Initialize a decoder. A frame received partially (start of the link) fails and the decoder synchronizes on its delimiter.
+// @param pDecoder: Decoder.
+// @param maxPayloadSize: Longer frames are dropped and counted as overflow.
+// @param handler: Called for each valid frame.
+// @param pContext: Passed unchanged to the handler.
+//@}
+void Framing_DecoderInit(Framing_Decoder* const pDecoder, const uint32_t maxPayloadSize, const Framing_FrameHandler handler, void* const pContext);
+
+//@{
+// Decode the next chunk of the received byte stream in place, calls the handler for each complete valid frame.
+// @param pDecoder: Decoder.
+// @param pChunk: Received bytes, they are overwritten by the decoded bytes.
+// @param size: Number of received bytes.
+//@}
+void Framing_DecoderPut(Framing_Decoder* const pDecoder, uint8_t* const pChunk, const uint32_t size);
+
+//@{
+// Drop the frame being decoded and synchronize on the next delimiter, e.g. after a receive overrun.
+// @param pDecoder: Decoder.
+//@}
+void Framing_DecoderReset(Framing_Decoder* const pDecoder);
+
+//@{
+// Copy the statistics.
+// @param pDecoder: Decoder.
+// @param pStatistics: Pointer to the Framing_Statistics structure to fill.
+//@}
+void Framing_GetStatistics(const Framing_Decoder* const pDecoder, Framing_Statistics* const pStatistics);
+
+//@{
+// Reset the statistics.
+// @param pDecoder: Decoder.
+//@}
+void Framing_ResetStatistics(Framing_Decoder* const pDecoder);
+
+//@{
+// Measure the cycles per byte to encode and decode a frame of size bytes (the payload is generated).
+// Runs on the target only, the clock is the DWT cycle counter of BenchmarkApp (@see BenchmarkApp.h) at startup.
+// The result is printed by the shell command "timing".
+// @param clock: Cycle counter.
+// @param size: Payload size 1..FRAMING_BENCHMARK_MAX_SIZE.
+// @param pBenchmark: Pointer to the Framing_Benchmark structure to fill.
+//@}
+void Framing_MeasureCost(const Framing_Clock clock, const uint32_t size, Framing_Benchmark* const pBenchmark);
+
+#ifdef __cplusplus
+}
+#endif // __cplusplus
+
+#endif // SYSTEMFRAMING_H
@@ -0,0 +1,342 @@
+// (c) IMT - Information Management Technology AG, CH-9470 Buchs, www.imt.ch.
+// SW guideline: Technote Coding Guidelines Ver. 1.5.1
+
+#include "SystemInputCapture.h"
+
+// Project includes
+#include "SystemPeripherals_TIM.h"
+#include "SystemPeripherals_DMA.h"
+#include "SystemTimeBase.h"
+#include "SystemStartupControl.h"
+#include "Core_CortexM3.h"
+
+// Imt.Base includes
+#include <Imt.Base.Core.Diagnostics/Diagnostics.h>
+
+//@{
+// Capture timer and channels of the input PB0 (TIM3_CH3), the DMA channels are in the header
+//@}
+#define INPUTCAPTURE_TIMER              TIM_ModuleAddress_TIM3
+#define INPUTCAPTURE_RISING_CHANNEL     TIM_Channel3
+#define INPUTCAPTURE_FALLING_CHANNEL    TIM_Channel4
+
+//@{
+// Edge sequence of one input and the sums the statistics are derived from
+//@}
+typedef struct {
+    uint32_t LastRising;
+    uint32_t LastFalling;
+    uint32_t LastPeriod;
+    bool RisingValid;
+    bool FallingValid;
+    bool PeriodValid;
+
+    uint64_t SumPeriods;
+    // Periods with a falling edge and the sum of their high times
+    uint32_t DutyPeriods;
+    uint64_t SumDutyPeriods;
+    uint64_t SumHighTimes;
+    // Consecutive period pairs and the sum of their differences
+    uint32_t CycleJitterCount;
+    uint64_t SumCycleJitter;
+
+    // Counters and the values of the last period, the derived values are calculated by InputCapture_GetStatistics
+    InputCapture_Statistics Statistics;
+} InputCapture_State;
+
+static InputCapture_State inputCaptureState;
+static InputCapture_Mode inputCaptureMode = InputCapture_Mode_Interrupt;
+
+//@{
+// DMA mode: capture buffers, the next index to evaluate, the last evaluated capture and the time of the last evaluation.
+// The buffers are zeroed on the first start of the DMA mode: the interrupt mode does not pay for them at boot.
+//@}
+STARTUP_LAZY_BUFFER(inputCaptureRising, uint16_t, INPUTCAPTURE_BUFFER_SIZE, 0x00U);
+STARTUP_LAZY_BUFFER(inputCaptureFalling, uint16_t, INPUTCAPTURE_BUFFER_SIZE, 0x00U);
+static uint32_t inputCaptureRisingIndex = 0U;
+static uint32_t inputCaptureFallingIndex = 0U;
+static uint16_t inputCaptureLastRisingCapture = 0U;
+static uint16_t inputCaptureLastFallingCapture = 0U;
+static uint32_t inputCaptureLastProcessTime = 0U;
+
+//@{
+// Forget the edge sequence, the next rising edge starts a new period (statistics are kept).
+//@}
+static void InputCapture_RestartSequence(void) {
+    inputCaptureState.RisingValid = false;
+    inputCaptureState.FallingValid = false;
+    inputCaptureState.PeriodValid = false;
+}
+
+//@{
+// Add an edge to the statistics, edges must be added in the order of the timestamps.
+// @param timestamp: Extended capture time.
+// @param rising: true for a rising edge.
+//@}
+static void InputCapture_AddEdge(const uint32_t timestamp, const bool rising) {
+    InputCapture_State* const pState = &inputCaptureState;
+    if (!rising) {
+        pState->LastFalling = timestamp;
+        pState->FallingValid = true;
+        return;
+    }
+
+    if (pState->RisingValid) {
+        InputCapture_Statistics* const pStatistics = &pState->Statistics;
+        const uint32_t period = timestamp - pState->LastRising;
+        ++pStatistics->Periods;
+        pStatistics->LastPeriodTicks = period;
+        if (period < pStatistics->MinPeriodTicks) {
+            pStatistics->MinPeriodTicks = period;
+        }
+        if (period > pStatistics->MaxPeriodTicks) {
+            pStatistics->MaxPeriodTicks = period;
+        }
+        pState->SumPeriods += period;
+
+        if (pState->PeriodValid) {
+            pState->SumCycleJitter += (period > pState->LastPeriod) ? (period - pState->LastPeriod) : (pState->LastPeriod - period);
+            ++pState->CycleJitterCount;
+        }
+        pState->LastPeriod = period;
+        pState->PeriodValid = true;
+
+        // the last falling edge belongs to this period if it is after the period start
+        const uint32_t highTime = pState->LastFalling - pState->LastRising;
+        if (pState->FallingValid && (highTime < period)) {
+            pStatistics->LastDutyCyclePermille = (uint32_t)(((uint64_t)highTime * 1000U) / period);
+            ++pState->DutyPeriods;
+            pState->SumDutyPeriods += period;
+            pState->SumHighTimes += highTime;
+        }
+    }
+    pState->LastRising = timestamp;
+    pState->RisingValid = true;
+}
+
+//@{
+// Extend a capture to the timestamp before a time base value, the capture is at most one counter period older.
+// @param now: Time base value read after the capture.
+// @param captureValue: Captured low half of the time base.
+//@}
+static uint32_t InputCapture_ExtendCapture(const uint32_t now, const uint16_t captureValue) {
+    return now - (uint16_t)((uint16_t)now - captureValue);
+}
+
+//@{
+// DMA mode: returns the number of captures written since the last evaluation and detects a lapped buffer.
+// @param dmaChannel: DMA channel of the buffer.
+// @param pBuffer: Capture buffer.
+// @param readIndex: Next index to evaluate.
+// @param lastCapture: Last evaluated capture, still in the buffer before readIndex unless the DMA lapped the buffer.
+// @param pIsLapped: Set to true if the DMA overwrote captures which were not evaluated.
+//@}
+static uint32_t InputCapture_GetPendingCaptures(const DMA_ChannelAddress dmaChannel, const uint16_t* const pBuffer, const uint32_t readIndex,
+                                                const uint16_t lastCapture, bool* const pIsLapped) {
+    const uint32_t writeIndex = (INPUTCAPTURE_BUFFER_SIZE - (uint32_t)DMA_GetCurrDataCounter(dmaChannel)) % INPUTCAPTURE_BUFFER_SIZE;
+    const uint32_t lastIndex = (readIndex + INPUTCAPTURE_BUFFER_SIZE - 1U) % INPUTCAPTURE_BUFFER_SIZE;
+    if (pBuffer[lastIndex] != lastCapture) {
+        *pIsLapped = true;
+    }
+    return (writeIndex + INPUTCAPTURE_BUFFER_SIZE - readIndex) % INPUTCAPTURE_BUFFER_SIZE;
+}
+
+//@{
+// DMA mode: configure a channel to copy the captures of a timer channel into a circular buffer.
+//@}
+static void InputCapture_StartDma(const DMA_ChannelAddress dmaChannel, const TIM_Channel timerChannel, uint16_t* const pBuffer) {
+    DMA_InitStruct dmaInit;
+    dmaInit.PeripheralBaseAddr = TIM_GetCompareRegisterAddress(INPUTCAPTURE_TIMER, timerChannel);
+    dmaInit.MemoryBaseAddr = (uint32_t)pBuffer; //lint !e923 cast from pointer to int [MISRA C++ Rule 5-2-9]. Justification: DMA address register
+    dmaInit.DIR = DMA_DIR_PeripheralSRC;
+    dmaInit.BufferSize = INPUTCAPTURE_BUFFER_SIZE;
+    dmaInit.PeripheralInc = DMA_PeripheralInc_Disable;
+    dmaInit.MemoryInc = DMA_MemoryInc_Enable;
+    dmaInit.PeripheralDataSize = DMA_PeripheralDataSize_HalfWord;
+    dmaInit.MemoryDataSize = DMA_MemoryDataSize_HalfWord;
+    dmaInit.Mode = DMA_Mode_Circular;
+    dmaInit.Priority = DMA_Priority_High;
+    dmaInit.M2M = DMA_M2M_Disable;
+    DMA_Enable(dmaChannel, false);
+    DMA_Init(dmaChannel, &dmaInit);
+    DMA_Enable(dmaChannel, true);
+}
+
+void InputCapture_Init(const InputCapture_Mode mode, const uint16_t filter) {
+    // the timer keeps running: it is the time base
+    TIM_EnableInterrupt(INPUTCAPTURE_TIMER, (TIM_Irq)(TIM_Irq_CaptureCompare3Interrupt | TIM_Irq_CaptureCompare4Interrupt), false);
+    TIM_EnableDmaRequest(INPUTCAPTURE_TIMER, (TIM_DmaRequest)(TIM_DmaRequest_CaptureCompare3 | TIM_DmaRequest_CaptureCompare4), false);
+
+    inputCaptureMode = mode;
+    InputCapture_ResetStatistics();
+
+    // PWM input mode: both channels capture TI3
+    TIM_ICInitStruct captureInit;
+    captureInit.Polarity = TIM_ICPolarity_Rising;
+    captureInit.Selection = TIM_ICSelection_DirectTI;
+    captureInit.Prescaler = TIM_ICPrescaler_Div1;
+    captureInit.Filter = filter;
+    TIM_ICInit(INPUTCAPTURE_TIMER, INPUTCAPTURE_RISING_CHANNEL, &captureInit);
+    captureInit.Polarity = TIM_ICPolarity_Falling;
+    captureInit.Selection = TIM_ICSelection_IndirectTI;
+    TIM_ICInit(INPUTCAPTURE_TIMER, INPUTCAPTURE_FALLING_CHANNEL, &captureInit);
+
+    if (mode == InputCapture_Mode_Dma) {
+        (void)Startup_GetLazyBuffer(&inputCaptureRising);
+        (void)Startup_GetLazyBuffer(&inputCaptureFalling);
+        inputCaptureRisingIndex = 0U;
+        inputCaptureFallingIndex = 0U;
+        // the slot before the first index is the last evaluated capture
+        inputCaptureRisingData[INPUTCAPTURE_BUFFER_SIZE - 1U] = 0U;
+        inputCaptureFallingData[INPUTCAPTURE_BUFFER_SIZE - 1U] = 0U;
+        inputCaptureLastRisingCapture = 0U;
+        inputCaptureLastFallingCapture = 0U;
+        inputCaptureLastProcessTime = TimeBase_GetMicroseconds();
+        InputCapture_StartDma(INPUTCAPTURE_RISING_DMA_CHANNEL, INPUTCAPTURE_RISING_CHANNEL, inputCaptureRisingData);
+        InputCapture_StartDma(INPUTCAPTURE_FALLING_DMA_CHANNEL, INPUTCAPTURE_FALLING_CHANNEL, inputCaptureFallingData);
+        TIM_EnableDmaRequest(INPUTCAPTURE_TIMER, (TIM_DmaRequest)(TIM_DmaRequest_CaptureCompare3 | TIM_DmaRequest_CaptureCompare4), true);
+    }
+    else {
+        TIM_EnableInterrupt(INPUTCAPTURE_TIMER, (TIM_Irq)(TIM_Irq_CaptureCompare3Interrupt | TIM_Irq_CaptureCompare4Interrupt), true);
+    }
+}
+
+void InputCapture_Process(void) {
+    if (inputCaptureMode != InputCapture_Mode_Dma) {
+        return;
+    }
+
+    // the write positions first: every capture before them was taken before the time read below
+    bool isLapped = false;
+    uint32_t risingCount = InputCapture_GetPendingCaptures(INPUTCAPTURE_RISING_DMA_CHANNEL, inputCaptureRisingData, inputCaptureRisingIndex,
+                                                           inputCaptureLastRisingCapture, &isLapped);
+    uint32_t fallingCount = InputCapture_GetPendingCaptures(INPUTCAPTURE_FALLING_DMA_CHANNEL, inputCaptureFallingData, inputCaptureFallingIndex,
+                                                            inputCaptureLastFallingCapture, &isLapped);
+    const uint32_t now = TimeBase_GetMicroseconds();
+    // a capture older than one counter period cannot be extended
+    if ((now - inputCaptureLastProcessTime) > 0xFFFFU) {
+        isLapped = true;
+    }
+    inputCaptureLastProcessTime = now;
+
+    if (isLapped) {
+        ++inputCaptureState.Statistics.Overruns;
+        InputCapture_RestartSequence();
+        inputCaptureRisingIndex = (inputCaptureRisingIndex + risingCount) % INPUTCAPTURE_BUFFER_SIZE;
+        inputCaptureFallingIndex = (inputCaptureFallingIndex + fallingCount) % INPUTCAPTURE_BUFFER_SIZE;
+        inputCaptureLastRisingCapture = inputCaptureRisingData[(inputCaptureRisingIndex + INPUTCAPTURE_BUFFER_SIZE - 1U) % INPUTCAPTURE_BUFFER_SIZE];
+        inputCaptureLastFallingCapture = inputCaptureFallingData[(inputCaptureFallingIndex + INPUTCAPTURE_BUFFER_SIZE - 1U) % INPUTCAPTURE_BUFFER_SIZE];
+        return;
+    }
+
+    // merge both edges in the order of their timestamps, a capture is at most one counter period before now
+    while ((risingCount != 0U) || (fallingCount != 0U)) {
+        const uint16_t risingCapture = inputCaptureRisingData[inputCaptureRisingIndex];
+        const uint16_t fallingCapture = inputCaptureFallingData[inputCaptureFallingIndex];
+        const uint32_t risingTimestamp = InputCapture_ExtendCapture(now, risingCapture);
+        const uint32_t fallingTimestamp = InputCapture_ExtendCapture(now, fallingCapture);
+
+        if ((fallingCount == 0U) || ((risingCount != 0U) && ((int32_t)(fallingTimestamp - risingTimestamp) >= 0))) {
+            InputCapture_AddEdge(risingTimestamp, true);
+            inputCaptureLastRisingCapture = risingCapture;
+            inputCaptureRisingIndex = (inputCaptureRisingIndex + 1U) % INPUTCAPTURE_BUFFER_SIZE;
+            --risingCount;
+        }
+        else {
+            InputCapture_AddEdge(fallingTimestamp, false);
+            inputCaptureLastFallingCapture = fallingCapture;
+            inputCaptureFallingIndex = (inputCaptureFallingIndex + 1U) % INPUTCAPTURE_BUFFER_SIZE;
+            --fallingCount;
+        }
+    }
+}
+
+void InputCapture_GetStatistics(InputCapture_Statistics* const pStatistics) {
+    if (pStatistics == NULL) {
+        ASSERT_DEBUG(false);
+        return;
+    }
+    const uint32_t previousBasePriority = CriticalSection_Enter(INPUTCAPTURE_CEILING);
+    const InputCapture_State state = inputCaptureState;
+    CriticalSection_Exit(previousBasePriority);
+
+    *pStatistics = state.Statistics;
+    if (state.Statistics.Periods != 0U) {
+        pStatistics->MeanPeriodTicks = (uint32_t)(state.SumPeriods / state.Statistics.Periods);
+        pStatistics->PeakJitterTicks = state.Statistics.MaxPeriodTicks - state.Statistics.MinPeriodTicks;
+        if (pStatistics->MeanPeriodTicks != 0U) {
+            pStatistics->FrequencyMilliHz = (uint32_t)(((uint64_t)TIMEBASE_TICK_FREQUENCY * 1000U) / pStatistics->MeanPeriodTicks);
+        }
+    }
+    if (state.SumDutyPeriods != 0U) {
+        pStatistics->MeanDutyCyclePermille = (uint32_t)((state.SumHighTimes * 1000U) / state.SumDutyPeriods);
+    }
+    if (state.CycleJitterCount != 0U) {
+        pStatistics->CycleJitterTicks = (uint32_t)(state.SumCycleJitter / state.CycleJitterCount);
+    }
+}
+
+void InputCapture_ResetStatistics(void) {
+    const uint32_t previousBasePriority = CriticalSection_Enter(INPUTCAPTURE_CEILING);
+    InputCapture_State* const pState = &inputCaptureState;
+    InputCapture_RestartSequence();
+    pState->SumPeriods = 0U;
+    pState->DutyPeriods = 0U;
+    pState->SumDutyPeriods = 0U;
+    pState->SumHighTimes = 0U;
+    pState->CycleJitterCount = 0U;
+    pState->SumCycleJitter = 0U;
+    pState->Statistics.Periods = 0U;
+    pState->Statistics.LastPeriodTicks = 0U;
+    pState->Statistics.MinPeriodTicks = 0xFFFFFFFFU;
+    pState->Statistics.MaxPeriodTicks = 0U;
+    pState->Statistics.MeanPeriodTicks = 0U;
+    pState->Statistics.FrequencyMilliHz = 0U;
+    pState->Statistics.LastDutyCyclePermille = 0U;
+    pState->Statistics.MeanDutyCyclePermille = 0U;
+    pState->Statistics.PeakJitterTicks = 0U;
+    pState->Statistics.CycleJitterTicks = 0U;
+    pState->Statistics.Overruns = 0U;
+    CriticalSection_Exit(previousBasePriority);
+}
+
+//------------------------------------------------------------------------------
+// TIM3 interrupt handler (overwrites the weak definition of vector_table_M.s)
+//------------------------------------------------------------------------------
+#ifdef __cplusplus
+extern "C" {
+#endif // __cplusplus
+void TIM3_IRQHandler(void);
+#ifdef __cplusplus
+}
+#endif // __cplusplus
+
+void TIM3_IRQHandler(void) {
+    if (TIM_IsPendingInterrupt(INPUTCAPTURE_TIMER, TIM_IrqFlag_CaptureCompare3Overcapture)
+        || TIM_IsPendingInterrupt(INPUTCAPTURE_TIMER, TIM_IrqFlag_CaptureCompare4Overcapture)) {
+        TIM_ClearPendingInterrupt(INPUTCAPTURE_TIMER, (TIM_IrqFlag)(TIM_IrqFlag_CaptureCompare3Overcapture | TIM_IrqFlag_CaptureCompare4Overcapture));
+        ++inputCaptureState.Statistics.Overruns;
+        InputCapture_RestartSequence();
+    }
+
+    const bool isRising = TIM_IsPendingInterrupt(INPUTCAPTURE_TIMER, TIM_IrqFlag_CaptureCompare3Interrupt);
+    const bool isFalling = TIM_IsPendingInterrupt(INPUTCAPTURE_TIMER, TIM_IrqFlag_CaptureCompare4Interrupt);
+    // reading the capture clears its flag, the time base is read after the captures
+    const uint16_t risingCapture = isRising ? TIM_GetCaptureValue(INPUTCAPTURE_TIMER, INPUTCAPTURE_RISING_CHANNEL) : 0U;
+    const uint16_t fallingCapture = isFalling ? TIM_GetCaptureValue(INPUTCAPTURE_TIMER, INPUTCAPTURE_FALLING_CHANNEL) : 0U;
+    const uint32_t now = TimeBase_GetMicroseconds();
+    const uint32_t risingTimestamp = InputCapture_ExtendCapture(now, risingCapture);
+    const uint32_t fallingTimestamp = InputCapture_ExtendCapture(now, fallingCapture);
+    if (isRising && isFalling && ((int32_t)(fallingTimestamp - risingTimestamp) < 0)) {
+        InputCapture_AddEdge(fallingTimestamp, false);
+        InputCapture_AddEdge(risingTimestamp, true);
+    }
+    else {
+        if (isRising) {
+            InputCapture_AddEdge(risingTimestamp, true);
+        }
+        if (isFalling) {
+            InputCapture_AddEdge(fallingTimestamp, false);
+        }
+    }
+}
@@ -0,0 +1,120 @@
+// (c) IMT - Information Management Technology AG, CH-9470 Buchs, www.imt.ch.
+// SW guideline: Technote Coding Guidelines Ver. 1.5.1
+
+#ifndef SYSTEMINPUTCAPTURE_H
+#define SYSTEMINPUTCAPTURE_H
+
+// Must be very first include
+#include <Imt.Base.Core.Platform/Platform.h>
+
+// Project includes
+#include "SystemPeripherals_DMA.h"
+
+// Determine if a C++ compiler is being used.  If so, ensure that standard C is used to process the API information.
+#ifdef __cplusplus
+extern "C" {
+#endif // __cplusplus
+
+//@{
+// Frequency and pulse width measurement of the signal on PB0 (TIM3_CH3) by input capture.
+// TIM3 is the low half of the 32-bit microsecond time base (@see SystemTimeBase.h), a 16-bit capture is extended to a
+// 32-bit timestamp with the time base (it is at most one counter period old). The pin is captured twice in PWM input
+// mode: channel 3 captures the rising edges, channel 4 (indirect input TI3) the falling edges.
+//
+// Two capture modes:
+// - InputCapture_Mode_Interrupt: each capture interrupt extends the timestamp and updates the statistics,
+//   for low edge rates.
+// - InputCapture_Mode_Dma: DMA1 Channel2 (TIM3_CH3) and Channel3 (TIM3_CH4) write the captures into circular buffers
+//   without CPU work per edge. InputCapture_Process extends the buffered captures relative to its own call time and
+//   updates the statistics, call it at least every INPUTCAPTURE_MAX_PROCESS_INTERVAL_US and before a buffer laps.
+//   The channels are the DMA channels of USART3: the DMA mode cannot be used together with the Modbus RTU slave
+//   (@see SystemModbusRtu.h) or another user of USART3 by DMA.
+//
+// TimeBase_Init must be called first. The clocks of GPIOB and for the DMA mode of DMA1 must be enabled and PB0 configured
+// as input by the application, for the interrupt mode the TIM3 interrupt must be enabled in the NVIC.
+//
+// Reference: ST_CortexM3_STM32F103_TRM_Rev15.pdf Chapter 15.3.5 Input capture mode, 15.3.6 PWM input mode
+//@}
+
+// DMA channels of the DMA mode (@see ST_CortexM3_STM32F103_TRM_Rev15.pdf Chapter 13.3.7 DMA request mapping)
+#define INPUTCAPTURE_RISING_DMA_CHANNEL DMA_ChannelAddress_DMA1_Channel2
+#define INPUTCAPTURE_FALLING_DMA_CHANNEL DMA_ChannelAddress_DMA1_Channel3
+
+// Captures per edge buffered in the DMA mode
+#define INPUTCAPTURE_BUFFER_SIZE 64U
+
+// Maximum interval between InputCapture_Process calls in the DMA mode (less than one counter period)
+#define INPUTCAPTURE_MAX_PROCESS_INTERVAL_US 50000U
+
+// Ceiling of the state shared with TIM3_IRQHandler, must mask TIM3_IRQn (@see INTERRUPTPLAN_CHECK_CEILING)
+#define INPUTCAPTURE_CEILING 2U
+
+//@{
+// Capture modes
+//@}
+typedef enum {
+    InputCapture_Mode_Interrupt,
+    InputCapture_Mode_Dma
+} InputCapture_Mode;
+
+//@{
+// Measurement statistics since the last reset, times in ticks (microseconds)
+//@}
+typedef struct {
+    // Number of measured periods (rising to rising edge)
+    uint32_t Periods;
+
+    // Period of the last, the shortest and the longest measured period
+    uint32_t LastPeriodTicks;
+    uint32_t MinPeriodTicks;
+    uint32_t MaxPeriodTicks;
+
+    // Mean period
+    uint32_t MeanPeriodTicks;
+
+    // Frequency from the mean period in mHz
+    uint32_t FrequencyMilliHz;
+
+    // Duty cycle of the last period and mean duty cycle in 1/1000
+    uint32_t LastDutyCyclePermille;
+    uint32_t MeanDutyCyclePermille;
+
+    // Peak-to-peak jitter: longest minus shortest period
+    uint32_t PeakJitterTicks;
+
+    // Mean cycle-to-cycle jitter: mean difference of consecutive periods
+    uint32_t CycleJitterTicks;
+
+    // Lost captures: overcapture (interrupt mode) or lapped buffer (DMA mode), the measurement restarts
+    uint32_t Overruns;
+} InputCapture_Statistics;
+
+//@{
+// Configure and start the captures, resets the statistics.
+// @param mode: Capture mode.
+// @param filter: Input filter 0x0..0xF (@see TIM_ICInitStruct).
+//@}
+void InputCapture_Init(const InputCapture_Mode mode, const uint16_t filter);
+
+//@{
+// Evaluate the captures buffered by the DMA, no effect in the interrupt mode.
+// Call it from one execution level only (e.g. main loop).
+//@}
+void InputCapture_Process(void);
+
+//@{
+// Copy the statistics.
+// @param pStatistics: Pointer to the InputCapture_Statistics structure to fill.
+//@}
+void InputCapture_GetStatistics(InputCapture_Statistics* const pStatistics);
+
+//@{
+// Reset the statistics, the next edges start a new measurement.
+//@}
+void InputCapture_ResetStatistics(void);
+
+#ifdef __cplusplus
+}
+#endif // __cplusplus
+
+#endif // SYSTEMINPUTCAPTURE_H
@@ -0,0 +1,51 @@
+// (c) IMT - Information Management Technology AG, CH-9470 Buchs, www.imt.ch.
+// SW guideline: Technote Coding Guidelines Ver. 1.5.1
+
+#include "SystemInterruptPlan.h"
+
+// Project includes
+#include "SystemPeripherals_SysTick.h"
+
+void InterruptPlan_ApplyPriorities(const InterruptPlan_Entry* const pTable, const uint32_t count, const uint32_t priorityGrouping) {
+    if ((pTable == NULL) || (priorityGrouping > 7U)) {
+        ASSERT_DEBUG(false);
+        return;
+    }
+    NVIC_SetPriorityGrouping(priorityGrouping);
+
+    const uint32_t subPriorityBits = INTERRUPTPLAN_SUBPRIORITY_BITS(priorityGrouping);
+    const bool isVectorTableInRam = VectorTable_IsInRam();
+    for (uint32_t i = 0U; i < count; ++i) {
+        const InterruptPlan_Entry* const pEntry = &pTable[i];
+        if ((uint32_t)pEntry->PreemptionPriority >= INTERRUPTPLAN_PREEMPTION_LEVELS(priorityGrouping)) {
+            ASSERT_DEBUG(false);
+            continue;
+        }
+        NVIC_SetPriority(pEntry->IrqNumber, (IRQ_PriorityType)((uint32_t)pEntry->PreemptionPriority << subPriorityBits));
+        if ((pEntry->Handler != NULL) && isVectorTableInRam) {
+            VectorTable_SetHandler(pEntry->IrqNumber, pEntry->Handler);
+        }
+    }
+}
+
+void InterruptPlan_EnableInterrupts(const InterruptPlan_Entry* const pTable, const uint32_t count) {
+    if (pTable == NULL) {
+        ASSERT_DEBUG(false);
+        return;
+    }
+    for (uint32_t i = 0U; i < count; ++i) {
+        const InterruptPlan_Entry* const pEntry = &pTable[i];
+        if (pEntry->Enabled != INTERRUPTPLAN_ENABLED) {
+            continue;
+        }
+        if ((int32_t)pEntry->IrqNumber >= 0) {
+            NVIC_EnableIRQ(pEntry->IrqNumber);
+        }
+        else if (pEntry->IrqNumber == SysTick_IRQn) {
+            SysTick_EnableInterrupt(true);
+        }
+        else {
+            // Cortex-M3 exceptions are enabled by their own control bits
+        }
+    }
+}
@@ -0,0 +1,140 @@
+// (c) IMT - Information Management Technology AG, CH-9470 Buchs, www.imt.ch.
+// SW guideline: Technote Coding Guidelines Ver. 1.5.1
+
+#ifndef SYSTEMINTERRUPTPLAN_H
+#define SYSTEMINTERRUPTPLAN_H
+
+// Must be very first include
+#include <Imt.Base.Core.Platform/Platform.h>
+
+// Project includes
+#include "SystemPeripherals_NVIC.h"
+#include "SystemVectorTable.h"
+#include "Core_CortexM3.h"
+
+// Imt.Base includes
+#include <Imt.Base.Core.Diagnostics/Diagnostics.h>
+
+// Determine if a C++ compiler is being used.  If so, ensure that standard C is used to process the API information.
+#ifdef __cplusplus
+extern "C" {
+#endif // __cplusplus
+
+//@{
+// Declarative interrupt plan: one table of the application defines every interrupt with its preemption priority,
+// handler, enable state and latency class. The table is an X-macro TABLE(ENTRY) with the entries
+//     ENTRY(irqNumber, preemptionPriority, handler, INTERRUPTPLAN_ENABLED/DISABLED, INTERRUPTPLAN_CRITICAL/NORMAL)
+// From the table
+// - INTERRUPTPLAN_CHECK checks at compile time: every interrupt is listed once, every preemption priority is
+//   available in the priority grouping, every latency critical interrupt preempts every normal interrupt
+//   (its preemption priority is strictly higher than the highest normal one)
+// - INTERRUPTPLAN_CHECK_CEILING checks at compile time that the ceiling of a critical section masks the interrupts
+//   sharing the resource (@see Core_CortexM3.h)
+// - INTERRUPTPLAN_ENTRY builds the InterruptPlan_Entry array for InterruptPlan_ApplyPriorities (grouping,
+//   priorities and handlers in one pass) and InterruptPlan_EnableInterrupts.
+// The handler is written into the SRAM vector table if it is relocated (@see SystemVectorTable.h), else it documents
+// the link time binding. NULL keeps the current vector.
+//
+// Reference: ST_CortexM3_STM32F10x_PM0056_Rev4.pdf Chapter 4.4.5 Application interrupt and reset control register
+//@}
+
+// Priority bits implemented by the STM32F103 (the upper 4 bits of the 8-bit priority registers)
+#define INTERRUPTPLAN_PRIORITY_BITS 4U
+
+// Enable state of an entry
+#define INTERRUPTPLAN_DISABLED 0U
+#define INTERRUPTPLAN_ENABLED  1U
+
+// Latency class of an entry: critical interrupts are never delayed by a normal interrupt
+#define INTERRUPTPLAN_NORMAL   0U
+#define INTERRUPTPLAN_CRITICAL 1U
+
+//@{
+// Sub-priority and preemption bits of a priority grouping (PRIGROUP 0..7)
+//@}
+#define INTERRUPTPLAN_SUBPRIORITY_BITS(grouping)   (((grouping) > (7U - INTERRUPTPLAN_PRIORITY_BITS)) ? ((grouping) - (7U - INTERRUPTPLAN_PRIORITY_BITS)) : 0U)
+#define INTERRUPTPLAN_PREEMPTION_LEVELS(grouping)  (1U << (INTERRUPTPLAN_PRIORITY_BITS - INTERRUPTPLAN_SUBPRIORITY_BITS(grouping)))
+
+//@{
+// Interrupt of the plan
+//@}
+typedef struct {
+    IRQ_NumberType IrqNumber;
+    // Preemption priority, the sub-priority is 0
+    IRQ_PriorityType PreemptionPriority;
+    // Handler written into the SRAM vector table, NULL keeps the current vector
+    VectorTable_Handler Handler;
+    uint8_t Enabled;
+    uint8_t Latency;
+} InterruptPlan_Entry;
+
+// Table entry to an InterruptPlan_Entry initializer
+#define INTERRUPTPLAN_ENTRY(irqNumber, preemptionPriority, handler, enabled, latency) \
+    { (irqNumber), (preemptionPriority), (handler), (uint8_t)(enabled), (uint8_t)(latency) },
+
+#ifdef __cplusplus
+//@{
+// Compile time checks of a table, use it once at namespace scope of the translation unit defining the table.
+// A duplicate interrupt fails with a redeclaration of InterruptPlan_Irq_<irqNumber> (its preemption priority), a priority which is not
+// available in the grouping or a critical interrupt which does not preempt all normal ones fails with an incomplete
+// STATIC_ASSERTION_FAILURE<false>.
+// @param TABLE: Interrupt table X-macro.
+// @param grouping: Priority grouping (PRIGROUP) of InterruptPlan_ApplyPriorities.
+//@}
+#define INTERRUPTPLAN_CHECK(TABLE, grouping)                                                                        \
+    enum InterruptPlan_UniqueIrqs { TABLE(INTERRUPTPLAN_CHECK_ENTRY_UNIQUE) InterruptPlan_UniqueIrqsEnd };         \
+    enum InterruptPlan_PriorityMasks {                                                                             \
+        InterruptPlan_UsedMask = 0U TABLE(INTERRUPTPLAN_CHECK_ENTRY_USED),                                         \
+        InterruptPlan_CriticalMask = 0U TABLE(INTERRUPTPLAN_CHECK_ENTRY_CRITICAL),                                 \
+        InterruptPlan_NormalMask = 0U TABLE(INTERRUPTPLAN_CHECK_ENTRY_NORMAL)                                      \
+    };                                                                                                             \
+    enum InterruptPlan_Checks {                                                                                    \
+        InterruptPlan_CheckGrouping = sizeof(STATIC_ASSERTION_FAILURE<((grouping) <= 7U)>),                        \
+        InterruptPlan_CheckPriorities = sizeof(STATIC_ASSERTION_FAILURE<                                           \
+            ((uint32_t)InterruptPlan_UsedMask < (1UL << INTERRUPTPLAN_PREEMPTION_LEVELS(grouping)))>),             \
+        InterruptPlan_CheckLatency = sizeof(STATIC_ASSERTION_FAILURE<                                              \
+            (((uint32_t)InterruptPlan_NormalMask == 0U)                                                            \
+             || ((uint32_t)InterruptPlan_CriticalMask < ((uint32_t)InterruptPlan_NormalMask & (0U - (uint32_t)InterruptPlan_NormalMask))))>) \
+    }
+
+//@{
+// Compile time check of a critical section ceiling against the plan, use it after INTERRUPTPLAN_CHECK (one per line).
+// The ceiling must mask the interrupt (ceiling <= its preemption priority) and never the unmaskable priorities.
+// Requires a grouping without sub-priority bits (0..3): the ceiling is compared to the preemption priority.
+// @param ceiling: Ceiling of CriticalSection_Enter / CriticalSectionGuard.
+// @param irqNumber: Interrupt accessing the resource.
+//@}
+#define INTERRUPTPLAN_CHECK_CEILING(ceiling, irqNumber) \
+    ASSERT_COMPILER(((ceiling) >= CORE_CRITICALSECTION_HIGHEST_CEILING) && ((ceiling) <= (uint32_t)InterruptPlan_Irq_##irqNumber))
+
+// Helpers of INTERRUPTPLAN_CHECK: one enumerator per interrupt, bit masks of the used preemption priorities
+#define INTERRUPTPLAN_CHECK_ENTRY_UNIQUE(irqNumber, preemptionPriority, handler, enabled, latency) InterruptPlan_Irq_##irqNumber = (preemptionPriority),
+#define INTERRUPTPLAN_CHECK_ENTRY_USED(irqNumber, preemptionPriority, handler, enabled, latency) | (1UL << (uint32_t)(preemptionPriority))
+#define INTERRUPTPLAN_CHECK_ENTRY_CRITICAL(irqNumber, preemptionPriority, handler, enabled, latency) \
+    | (((latency) == INTERRUPTPLAN_CRITICAL) ? (1UL << (uint32_t)(preemptionPriority)) : 0UL)
+#define INTERRUPTPLAN_CHECK_ENTRY_NORMAL(irqNumber, preemptionPriority, handler, enabled, latency) \
+    | (((latency) == INTERRUPTPLAN_NORMAL) ? (1UL << (uint32_t)(preemptionPriority)) : 0UL)
+#endif // __cplusplus
+
+//@{
+// Set the priority grouping, the priorities of all entries and the handlers of the entries with a handler.
+// Call it before any of the interrupts is enabled.
+// @param pTable: Entries of the plan.
+// @param count: Number of entries.
+// @param priorityGrouping: PRIGROUP 0..7, the preemption priorities are shifted above the sub-priority bits.
+//@}
+void InterruptPlan_ApplyPriorities(const InterruptPlan_Entry* const pTable, const uint32_t count, const uint32_t priorityGrouping);
+
+//@{
+// Enable the interrupts of the entries marked INTERRUPTPLAN_ENABLED.
+// SysTick is enabled in the SysTick control register, other Cortex-M3 exceptions are always enabled.
+// @param pTable: Entries of the plan.
+// @param count: Number of entries.
+//@}
+void InterruptPlan_EnableInterrupts(const InterruptPlan_Entry* const pTable, const uint32_t count);
+
+#ifdef __cplusplus
+}
+#endif // __cplusplus
+
+#endif // SYSTEMINTERRUPTPLAN_H
@@ -0,0 +1,407 @@
+// (c) IMT - Information Management Technology AG, CH-9470 Buchs, www.imt.ch.
+// SW guideline: Technote Coding Guidelines Ver. 1.5.1
+
+#include "SystemMemoryCopy.h"
+
+// Project includes
+#include "SystemStartupControl.h"
+#include "SystemRamCode.h"
+#include "Core_CortexM3.h"
+
+// Imt.Base includes
+#include <Imt.Base.Core.Diagnostics/Diagnostics.h>
+
+// Flags of the channel
+#define MEMORYCOPY_IRQFLAG_GL DMA1_IrqFlag_Ch4_GL
+#define MEMORYCOPY_IRQFLAG_TC DMA1_IrqFlag_Ch4_TC
+#define MEMORYCOPY_IRQFLAG_TE DMA1_IrqFlag_Ch4_TE
+
+// Maximum number of units of a single transfer (CNDTR is 16 bit)
+#define MEMORYCOPY_MAX_UNITS 0xFFFFU
+
+// Sizes measured by MemoryCopy_Calibrate: multiples of the step up to MEMORYCOPY_BENCHMARK_MAX_SIZE
+#define MEMORYCOPY_CALIBRATION_STEP 16U
+
+//@{
+// Queued request. A fill reads its value from FillWord, which stays in the queue until the completion.
+//@}
+typedef struct {
+    uint8_t* pDestination;
+    const uint8_t* pSource;
+    uint32_t Size;
+    uint32_t FillWord;
+    bool IsFill;
+    MemoryCopy_Completion Completion;
+    void* pContext;
+    // Bytes of the finished transfers of the request
+    uint32_t DoneSize;
+} MemoryCopy_Request;
+
+//@{
+// Queue of the requests: the oldest (in transfer while the count is not 0) at head, size of the running transfer
+//@}
+static MemoryCopy_Request memoryCopyQueue[MEMORYCOPY_QUEUE_SIZE];
+static uint32_t memoryCopyHead = 0U;
+static uint32_t memoryCopyCount = 0U;
+static uint32_t memoryCopyTransferSize = 0U;
+
+static uint32_t memoryCopyThreshold = MEMORYCOPY_DEFAULT_THRESHOLD;
+static MemoryCopy_Statistics memoryCopyStatistics;
+
+// Buffers of the benchmark, the content is irrelevant
+#pragma data_alignment = 4
+static STARTUP_NOINIT uint8_t memoryCopyBenchmarkSource[MEMORYCOPY_BENCHMARK_MAX_SIZE];
+#pragma data_alignment = 4
+static STARTUP_NOINIT uint8_t memoryCopyBenchmarkDestination[MEMORYCOPY_BENCHMARK_MAX_SIZE];
+
+//@{
+// Start the next transfer of a request: words as long as the addresses are aligned and a word remains, then bytes.
+// Called at the ceiling with the channel idle.
+//@}
+static void MemoryCopy_StartTransfer(const MemoryCopy_Request* const pRequest) {
+    const uint8_t* const pSource = pRequest->IsFill ? (const uint8_t*)&pRequest->FillWord : &pRequest->pSource[pRequest->DoneSize];
+    uint8_t* const pDestination = &pRequest->pDestination[pRequest->DoneSize];
+    const uint32_t remaining = pRequest->Size - pRequest->DoneSize;
+    const bool isAligned = (((((uintptr_t)pDestination) | ((uintptr_t)pSource)) & 0x3U) == 0U); //lint !e923 cast from pointer to int [MISRA C++ Rule 5-2-9]. Justification: alignment check
+    const bool isWord = isAligned && (remaining >= 4U);
+    const uint32_t unitSize = isWord ? 4U : 1U;
+    const uint32_t units = ((remaining / unitSize) > MEMORYCOPY_MAX_UNITS) ? MEMORYCOPY_MAX_UNITS : (remaining / unitSize);
+
+    // the source is the peripheral side: incremented for a copy, fixed on the fill word
+    DMA_InitStruct dmaInit;
+    dmaInit.PeripheralBaseAddr = (uint32_t)pSource; //lint !e923 cast from pointer to int [MISRA C++ Rule 5-2-9]. Justification: DMA address register
+    dmaInit.MemoryBaseAddr = (uint32_t)pDestination; //lint !e923 cast from pointer to int [MISRA C++ Rule 5-2-9]. Justification: DMA address register
+    dmaInit.DIR = DMA_DIR_PeripheralSRC;
+    dmaInit.BufferSize = units;
+    dmaInit.PeripheralInc = pRequest->IsFill ? DMA_PeripheralInc_Disable : DMA_PeripheralInc_Enable;
+    dmaInit.MemoryInc = DMA_MemoryInc_Enable;
+    dmaInit.PeripheralDataSize = isWord ? DMA_PeripheralDataSize_Word : DMA_PeripheralDataSize_Byte;
+    dmaInit.MemoryDataSize = isWord ? DMA_MemoryDataSize_Word : DMA_MemoryDataSize_Byte;
+    dmaInit.Mode = DMA_Mode_Normal;
+    dmaInit.Priority = DMA_Priority_Low;
+    dmaInit.M2M = DMA_M2M_Enable;
+
+    DMA_Enable(MEMORYCOPY_DMA_CHANNEL, false);
+    DMA_Init(MEMORYCOPY_DMA_CHANNEL, &dmaInit);
+    memoryCopyTransferSize = units * unitSize;
+    DMA_Enable(MEMORYCOPY_DMA_CHANNEL, true);
+}
+
+//@{
+// Append a request to the queue and start it if the channel is idle.
+// @return bool: false if the queue is full
+//@}
+static bool MemoryCopy_Queue(const MemoryCopy_Request* const pRequest) {
+    const uint32_t previousBasePriority = CriticalSection_Enter(MEMORYCOPY_CEILING);
+    const bool isQueued = (memoryCopyCount < MEMORYCOPY_QUEUE_SIZE);
+    if (isQueued) {
+        memoryCopyQueue[(memoryCopyHead + memoryCopyCount) % MEMORYCOPY_QUEUE_SIZE] = *pRequest;
+        ++memoryCopyCount;
+        ++memoryCopyStatistics.DmaRequests;
+        if (memoryCopyCount > memoryCopyStatistics.MaxQueued) {
+            memoryCopyStatistics.MaxQueued = memoryCopyCount;
+        }
+        if (memoryCopyCount == 1U) {
+            MemoryCopy_StartTransfer(&memoryCopyQueue[memoryCopyHead]);
+        }
+    }
+    else {
+        ++memoryCopyStatistics.QueueFull;
+    }
+    CriticalSection_Exit(previousBasePriority);
+    return isQueued;
+}
+
+//@{
+// Count a request done by the CPU and call its completion handler.
+//@}
+static void MemoryCopy_CompleteByCpu(const MemoryCopy_Completion completion, void* const pContext) {
+    const uint32_t previousBasePriority = CriticalSection_Enter(MEMORYCOPY_CEILING);
+    ++memoryCopyStatistics.CpuRequests;
+    CriticalSection_Exit(previousBasePriority);
+    if (completion != NULL) {
+        completion(pContext);
+    }
+}
+
+void MemoryCopy_Init(void) {
+    DMA_Enable(MEMORYCOPY_DMA_CHANNEL, false);
+    memoryCopyHead = 0U;
+    memoryCopyCount = 0U;
+    memoryCopyTransferSize = 0U;
+    MemoryCopy_ResetStatistics();
+    DMA_ClearPendingInterrupt(MEMORYCOPY_IRQFLAG_GL);
+    DMA_EnableInterrupt(MEMORYCOPY_DMA_CHANNEL, (DMA_Irq)(DMA_Irq_TransferComplete | DMA_Irq_TransferError), true);
+}
+
+//@{
+// Copy loop of MemoryCopy_Copy and MemoryCopy_CopyInFlash.
+// Forced inline, so the code is placed in the section of the calling function.
+//@}
+#pragma inline = forced
+static void MemoryCopy_CopyLoop(void* const pDestination, const void* const pSource, const uint32_t size) {
+    uint8_t* pDst = (uint8_t*)pDestination;
+    const uint8_t* pSrc = (const uint8_t*)pSource;
+    uint32_t remaining = size;
+
+    // same offset within the word: bytes up to the word boundary, then words
+    if (((((uintptr_t)pDst) ^ ((uintptr_t)pSrc)) & 0x3U) == 0U) { //lint !e923 cast from pointer to int [MISRA C++ Rule 5-2-9]. Justification: alignment check
+        while (((((uintptr_t)pDst) & 0x3U) != 0U) && (remaining > 0U)) { //lint !e923 cast from pointer to int [MISRA C++ Rule 5-2-9]. Justification: alignment check
+            *pDst++ = *pSrc++;
+            --remaining;
+        }
+        uint32_t* pDstWord = (uint32_t*)pDst;
+        const uint32_t* pSrcWord = (const uint32_t*)pSrc;
+        // four loads before four stores: the compiler merges them into one LDM/STM pair
+        while (remaining >= 16U) {
+            const uint32_t word0 = pSrcWord[0];
+            const uint32_t word1 = pSrcWord[1];
+            const uint32_t word2 = pSrcWord[2];
+            const uint32_t word3 = pSrcWord[3];
+            pDstWord[0] = word0;
+            pDstWord[1] = word1;
+            pDstWord[2] = word2;
+            pDstWord[3] = word3;
+            pSrcWord += 4;
+            pDstWord += 4;
+            remaining -= 16U;
+        }
+        while (remaining >= 4U) {
+            *pDstWord++ = *pSrcWord++;
+            remaining -= 4U;
+        }
+        pDst = (uint8_t*)pDstWord;
+        pSrc = (const uint8_t*)pSrcWord;
+    }
+    while (remaining > 0U) {
+        *pDst++ = *pSrc++;
+        --remaining;
+    }
+}
+
+SYSTEM_RAMFUNC void MemoryCopy_Copy(void* const pDestination, const void* const pSource, const uint32_t size) {
+    if (((pDestination == NULL) || (pSource == NULL)) && (size != 0U)) {
+        ASSERT_DEBUG(false);
+        return;
+    }
+    MemoryCopy_CopyLoop(pDestination, pSource, size);
+}
+
+void MemoryCopy_CopyInFlash(void* const pDestination, const void* const pSource, const uint32_t size) {
+    if (((pDestination == NULL) || (pSource == NULL)) && (size != 0U)) {
+        ASSERT_DEBUG(false);
+        return;
+    }
+    MemoryCopy_CopyLoop(pDestination, pSource, size);
+}
+
+void MemoryCopy_Fill(void* const pDestination, const uint8_t value, const uint32_t size) {
+    if ((pDestination == NULL) && (size != 0U)) {
+        ASSERT_DEBUG(false);
+        return;
+    }
+    uint8_t* pDst = (uint8_t*)pDestination;
+    uint32_t remaining = size;
+    while (((((uintptr_t)pDst) & 0x3U) != 0U) && (remaining > 0U)) { //lint !e923 cast from pointer to int [MISRA C++ Rule 5-2-9]. Justification: alignment check
+        *pDst++ = value;
+        --remaining;
+    }
+    const uint32_t word = (uint32_t)value * 0x01010101U;
+    uint32_t* pDstWord = (uint32_t*)pDst;
+    // four stores: one STM
+    while (remaining >= 16U) {
+        pDstWord[0] = word;
+        pDstWord[1] = word;
+        pDstWord[2] = word;
+        pDstWord[3] = word;
+        pDstWord += 4;
+        remaining -= 16U;
+    }
+    while (remaining >= 4U) {
+        *pDstWord++ = word;
+        remaining -= 4U;
+    }
+    pDst = (uint8_t*)pDstWord;
+    while (remaining > 0U) {
+        *pDst++ = value;
+        --remaining;
+    }
+}
+
+bool MemoryCopy_CopyAsync(void* const pDestination, const void* const pSource, const uint32_t size,
+                          const MemoryCopy_Completion completion, void* const pContext) {
+    if (((pDestination == NULL) || (pSource == NULL)) && (size != 0U)) {
+        ASSERT_DEBUG(false);
+        return false;
+    }
+    if (size < memoryCopyThreshold) {
+        MemoryCopy_Copy(pDestination, pSource, size);
+        MemoryCopy_CompleteByCpu(completion, pContext);
+        return true;
+    }
+    MemoryCopy_Request request;
+    request.pDestination = (uint8_t*)pDestination;
+    request.pSource = (const uint8_t*)pSource;
+    request.Size = size;
+    request.FillWord = 0U;
+    request.IsFill = false;
+    request.Completion = completion;
+    request.pContext = pContext;
+    request.DoneSize = 0U;
+    return MemoryCopy_Queue(&request);
+}
+
+bool MemoryCopy_FillAsync(void* const pDestination, const uint8_t value, const uint32_t size,
+                          const MemoryCopy_Completion completion, void* const pContext) {
+    if ((pDestination == NULL) && (size != 0U)) {
+        ASSERT_DEBUG(false);
+        return false;
+    }
+    if (size < memoryCopyThreshold) {
+        MemoryCopy_Fill(pDestination, value, size);
+        MemoryCopy_CompleteByCpu(completion, pContext);
+        return true;
+    }
+    MemoryCopy_Request request;
+    request.pDestination = (uint8_t*)pDestination;
+    request.pSource = NULL;
+    request.Size = size;
+    request.FillWord = (uint32_t)value * 0x01010101U;
+    request.IsFill = true;
+    request.Completion = completion;
+    request.pContext = pContext;
+    request.DoneSize = 0U;
+    return MemoryCopy_Queue(&request);
+}
+
+bool MemoryCopy_IsBusy(void) {
+    return memoryCopyCount != 0U;
+}
+
+uint32_t MemoryCopy_GetThreshold(void) {
+    return memoryCopyThreshold;
+}
+
+void MemoryCopy_GetStatistics(MemoryCopy_Statistics* const pStatistics) {
+    if (pStatistics == NULL) {
+        ASSERT_DEBUG(false);
+        return;
+    }
+    const uint32_t previousBasePriority = CriticalSection_Enter(MEMORYCOPY_CEILING);
+    *pStatistics = memoryCopyStatistics;
+    CriticalSection_Exit(previousBasePriority);
+}
+
+void MemoryCopy_ResetStatistics(void) {
+    const uint32_t previousBasePriority = CriticalSection_Enter(MEMORYCOPY_CEILING);
+    memoryCopyStatistics.DmaRequests = 0U;
+    memoryCopyStatistics.CpuRequests = 0U;
+    memoryCopyStatistics.QueueFull = 0U;
+    memoryCopyStatistics.TransferErrors = 0U;
+    memoryCopyStatistics.MaxQueued = 0U;
+    CriticalSection_Exit(previousBasePriority);
+}
+
+void MemoryCopy_MeasureCopy(const uint32_t size, MemoryCopy_Benchmark* const pBenchmark) {
+    if ((pBenchmark == NULL) || (size == 0U) || (size > MEMORYCOPY_BENCHMARK_MAX_SIZE) || MemoryCopy_IsBusy()) {
+        ASSERT_DEBUG(false);
+        return;
+    }
+    pBenchmark->Size = size;
+
+    // the first call loads the prefetch buffer, measure the second call
+    uint32_t startCycles = 0U;
+    for (uint32_t run = 0U; run < 2U; ++run) {
+        startCycles = DWT->CYCCNT;
+        MemoryCopy_Copy(memoryCopyBenchmarkDestination, memoryCopyBenchmarkSource, size);
+        pBenchmark->CpuCycles = DWT->CYCCNT - startCycles;
+    }
+
+    // polled: the interrupt would take the transfer for a queued request
+    MemoryCopy_Request request;
+    request.pDestination = memoryCopyBenchmarkDestination;
+    request.pSource = memoryCopyBenchmarkSource;
+    request.Size = size;
+    request.FillWord = 0U;
+    request.IsFill = false;
+    request.Completion = NULL;
+    request.pContext = NULL;
+    request.DoneSize = 0U;
+    DMA_EnableInterrupt(MEMORYCOPY_DMA_CHANNEL, (DMA_Irq)(DMA_Irq_TransferComplete | DMA_Irq_TransferError), false);
+    DMA_ClearPendingInterrupt(MEMORYCOPY_IRQFLAG_GL);
+    startCycles = DWT->CYCCNT;
+    MemoryCopy_StartTransfer(&request);
+    pBenchmark->DmaStartCycles = DWT->CYCCNT - startCycles;
+    while (!DMA_IsPendingInterrupt(MEMORYCOPY_IRQFLAG_TC) && !DMA_IsPendingInterrupt(MEMORYCOPY_IRQFLAG_TE)) {
+        // wait for the end of the transfer
+    }
+    pBenchmark->DmaCycles = DWT->CYCCNT - startCycles;
+    DMA_Enable(MEMORYCOPY_DMA_CHANNEL, false);
+    DMA_ClearPendingInterrupt(MEMORYCOPY_IRQFLAG_GL);
+    DMA_EnableInterrupt(MEMORYCOPY_DMA_CHANNEL, (DMA_Irq)(DMA_Irq_TransferComplete | DMA_Irq_TransferError), true);
+}
+
+uint32_t MemoryCopy_Calibrate(void) {
+    if (MemoryCopy_IsBusy()) {
+        ASSERT_DEBUG(false);
+        return memoryCopyThreshold;
+    }
+    uint32_t threshold = MEMORYCOPY_BENCHMARK_MAX_SIZE;
+    bool isFound = false;
+    for (uint32_t size = MEMORYCOPY_CALIBRATION_STEP; (size <= MEMORYCOPY_BENCHMARK_MAX_SIZE) && !isFound; size += MEMORYCOPY_CALIBRATION_STEP) {
+        MemoryCopy_Benchmark benchmark;
+        MemoryCopy_MeasureCopy(size, &benchmark);
+        // CPU time of a DMA request: the start and the completion interrupt
+        if (benchmark.CpuCycles > (2U * benchmark.DmaStartCycles)) {
+            threshold = size;
+            isFound = true;
+        }
+    }
+    memoryCopyThreshold = threshold;
+    return threshold;
+}
+
+//------------------------------------------------------------------------------
+// DMA1 Channel4 interrupt handler (overwrite the weak definition of vector_table_M.s)
+//------------------------------------------------------------------------------
+#ifdef __cplusplus
+extern "C" {
+#endif // __cplusplus
+void DMA1_Channel4_IRQHandler(void);
+#ifdef __cplusplus
+}
+#endif // __cplusplus
+
+void DMA1_Channel4_IRQHandler(void) {
+    const bool isError = DMA_IsPendingInterrupt(MEMORYCOPY_IRQFLAG_TE);
+    DMA_ClearPendingInterrupt(MEMORYCOPY_IRQFLAG_GL);
+    if (memoryCopyCount == 0U) {
+        return;
+    }
+    MemoryCopy_Request* const pRequest = &memoryCopyQueue[memoryCopyHead];
+    pRequest->DoneSize += memoryCopyTransferSize;
+    if (isError) {
+        // bus error, the channel is disabled: the rest of the request is dropped
+        ++memoryCopyStatistics.TransferErrors;
+        pRequest->DoneSize = pRequest->Size;
+    }
+    if (pRequest->DoneSize < pRequest->Size) {
+        MemoryCopy_StartTransfer(pRequest);
+        return;
+    }
+
+    // the slot is free for new requests from the completion handler
+    const MemoryCopy_Completion completion = pRequest->Completion;
+    void* const pContext = pRequest->pContext;
+    memoryCopyHead = (memoryCopyHead + 1U) % MEMORYCOPY_QUEUE_SIZE;
+    --memoryCopyCount;
+    if (memoryCopyCount != 0U) {
+        MemoryCopy_StartTransfer(&memoryCopyQueue[memoryCopyHead]);
+    }
+    else {
+        DMA_Enable(MEMORYCOPY_DMA_CHANNEL, false);
+    }
+    if (completion != NULL) {
+        completion(pContext);
+    }
+}
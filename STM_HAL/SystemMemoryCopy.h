@@ -0,0 +1,191 @@
+// (c) IMT - Information Management Technology AG, CH-9470 Buchs, www.imt.ch.
+// SW guideline: Technote Coding Guidelines Ver. 1.5.1
+
+#ifndef SYSTEMMEMORYCOPY_H
+#define SYSTEMMEMORYCOPY_H
+
+// Must be very first include
+#include <Imt.Base.Core.Platform/Platform.h>
+
+// Project includes
+#include "SystemPeripherals_DMA.h"
+
+// Determine if a C++ compiler is being used.  If so, ensure that standard C is used to process the API information.
+#ifdef __cplusplus
+extern "C" {
+#endif // __cplusplus
+
+//@{
+// Memory copy and fill, asynchronous by memory-to-memory DMA or at once by the CPU.
+// - DMA: MemoryCopy_CopyAsync and MemoryCopy_FillAsync queue a request, DMA1 Channel4 executes the requests in order.
+//   The transfer complete interrupt calls the completion handler of a request and starts the next one. Word transfers
+//   if the addresses are word aligned, the remaining bytes and unaligned requests by byte transfers. Transfers of more
+//   than 65535 units (CNDTR is 16 bit) are split. The channel has the low DMA priority: the peripheral channels (USART, TIM)
+//   win the arbitration at each unit.
+// - CPU: MemoryCopy_Copy and MemoryCopy_Fill move 16 bytes per loop pass (four words, one LDM/STM pair) if the addresses
+//   are word aligned. MemoryCopy_Copy runs from SRAM (@see SystemRamCode.h). An asynchronous request below the threshold is done by the CPU, its completion handler is called
+//   before the call returns: earlier DMA requests may still be pending, the areas of requests must not overlap.
+// - Threshold: the CPU time of a DMA request is constant (queue, start, completion interrupt), the CPU copy grows with
+//   the size. MemoryCopy_Calibrate measures both and sets the threshold to the crossover.
+//
+// DMA1 Channel4 is the transmit channel of USART1 (@see SystemUsartLink.h), a link on USART1 cannot be used together.
+// The clock of DMA1 must be enabled by the application and DMA1_Channel4_IRQn enabled in the NVIC at the priority
+// MEMORYCOPY_CEILING. The asynchronous functions can be called from the main loop and from interrupts up to the
+// ceiling, also from a completion handler.
+//
+// Reference: ST_CortexM3_STM32F103_TRM_Rev15.pdf Chapter 13.3.3 Memory-to-memory mode
+//@}
+
+// DMA channel of the requests
+#define MEMORYCOPY_DMA_CHANNEL DMA_ChannelAddress_DMA1_Channel4
+
+// Ceiling of the queue shared with DMA1_Channel4_IRQHandler (@see INTERRUPTPLAN_CHECK_CEILING)
+#define MEMORYCOPY_CEILING 5U
+
+// Number of queued requests, including the one in transfer
+#define MEMORYCOPY_QUEUE_SIZE 8U
+
+// Threshold until MemoryCopy_Calibrate: requests below it are done by the CPU
+#define MEMORYCOPY_DEFAULT_THRESHOLD 64U
+
+// Maximum size of MemoryCopy_MeasureCopy in bytes
+#define MEMORYCOPY_BENCHMARK_MAX_SIZE 512U
+
+//@{
+// Called when a request is complete: from DMA1_Channel4_IRQHandler, or from the caller for a CPU copy.
+// @param pContext: Context passed with the request.
+//@}
+typedef void (*MemoryCopy_Completion)(void* pContext);
+
+//@{
+// Statistics since the last reset
+//@}
+typedef struct {
+    // Requests queued for DMA
+    uint32_t DmaRequests;
+
+    // Requests below the threshold done by the CPU
+    uint32_t CpuRequests;
+
+    // Requests rejected, the queue was full
+    uint32_t QueueFull;
+
+    // Requests aborted by a DMA bus error, the completion handler is called anyway
+    uint32_t TransferErrors;
+
+    // Maximum number of queued requests
+    uint32_t MaxQueued;
+} MemoryCopy_Statistics;
+
+//@{
+// Cycles to copy the same buffer by the CPU and by DMA
+//@}
+typedef struct {
+    // Size of the buffer in bytes
+    uint32_t Size;
+
+    // CPU copy
+    uint32_t CpuCycles;
+
+    // CPU time to configure and start the DMA transfer
+    uint32_t DmaStartCycles;
+
+    // Start to the end of the DMA transfer
+    uint32_t DmaCycles;
+} MemoryCopy_Benchmark;
+
+//@{
+// Empty the queue and enable the transfer complete and error interrupts of the channel.
+//@}
+void MemoryCopy_Init(void);
+
+//@{
+// Copy memory by the CPU. The areas must not overlap.
+// @param pDestination: Destination address.
+// @param pSource: Source address.
+// @param size: Number of bytes.
+//@}
+void MemoryCopy_Copy(void* const pDestination, const void* const pSource, const uint32_t size);
+
+//@{
+// Same code as MemoryCopy_Copy executed from flash, the reference of RamCode_MeasureCopy.
+// @param pDestination: Destination address.
+// @param pSource: Source address.
+// @param size: Number of bytes.
+//@}
+void MemoryCopy_CopyInFlash(void* const pDestination, const void* const pSource, const uint32_t size);
+
+//@{
+// Fill memory by the CPU.
+// @param pDestination: Destination address.
+// @param value: Byte value.
+// @param size: Number of bytes.
+//@}
+void MemoryCopy_Fill(void* const pDestination, const uint8_t value, const uint32_t size);
+
+//@{
+// Queue a copy, by the CPU below the threshold. The areas must not overlap and stay valid until the completion.
+// @param pDestination: Destination address in SRAM.
+// @param pSource: Source address in SRAM or flash.
+// @param size: Number of bytes.
+// @param completion: Called when the copy is complete, NULL for none.
+// @param pContext: Passed unchanged to the completion handler.
+// @return bool: false if the queue is full (counted), nothing is copied
+//@}
+bool MemoryCopy_CopyAsync(void* const pDestination, const void* const pSource, const uint32_t size,
+                          const MemoryCopy_Completion completion, void* const pContext);
+
+//@{
+// Queue a fill, by the CPU below the threshold. The area must stay valid until the completion.
+// @param pDestination: Destination address in SRAM.
+// @param value: Byte value.
+// @param size: Number of bytes.
+// @param completion: Called when the fill is complete, NULL for none.
+// @param pContext: Passed unchanged to the completion handler.
+// @return bool: false if the queue is full (counted), nothing is filled
+//@}
+bool MemoryCopy_FillAsync(void* const pDestination, const uint8_t value, const uint32_t size,
+                          const MemoryCopy_Completion completion, void* const pContext);
+
+//@{
+// Returns true while requests are queued or in transfer.
+//@}
+bool MemoryCopy_IsBusy(void);
+
+//@{
+// Returns the size from which the requests are done by DMA.
+//@}
+uint32_t MemoryCopy_GetThreshold(void);
+
+//@{
+// Copy the statistics.
+// @param pStatistics: Pointer to the MemoryCopy_Statistics structure to fill.
+//@}
+void MemoryCopy_GetStatistics(MemoryCopy_Statistics* const pStatistics);
+
+//@{
+// Reset the statistics.
+//@}
+void MemoryCopy_ResetStatistics(void);
+
+//@{
+// Measure the cycles to copy a buffer by the CPU and by DMA. The queue must be empty, the DMA transfer is polled.
+// Note: Requires the running DWT cycle counter (@see SystemStartupControl.h), call it with interrupts disabled for stable results.
+// @param size: Number of bytes, at most MEMORYCOPY_BENCHMARK_MAX_SIZE.
+// @param pBenchmark: Pointer to the MemoryCopy_Benchmark structure to fill.
+//@}
+void MemoryCopy_MeasureCopy(const uint32_t size, MemoryCopy_Benchmark* const pBenchmark);
+
+//@{
+// Set the threshold to the smallest size which the CPU copies slower than the CPU time of a DMA request.
+// The completion interrupt is counted like the start (entry, exit and the same register accesses).
+// Call it after MemoryCopy_Init with an empty queue, e.g. before the interrupts are enabled.
+// @return uint32_t: Threshold in bytes, MEMORYCOPY_BENCHMARK_MAX_SIZE if the CPU is faster for all measured sizes
+//@}
+uint32_t MemoryCopy_Calibrate(void);
+
+#ifdef __cplusplus
+}
+#endif // __cplusplus
+
+#endif // SYSTEMMEMORYCOPY_H
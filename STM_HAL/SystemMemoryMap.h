@@ -24,6 +24,10 @@
 #define NVIC_BASE             (SCS_BASE + 0x0100)
 // System Control Block Base Address
 #define SCB_BASE              (SCS_BASE + 0x0D00)
+// Core Debug Base Address
+#define CoreDebug_BASE        (SCS_BASE + 0x0DF0)
+// Data Watchpoint and Trace Unit Base Address
+#define DWT_BASE              ((uint32_t)0xE0001000)
 
 //------------------------------------------------------------------------------
 // Peripheral memory map of STM32F103
@@ -33,6 +37,8 @@
 #define FLASH_BASE            ((uint32_t)0x08000000)
 // SRAM base address in the alias region
 #define SRAM_BASE             ((uint32_t)0x20000000)
+// SRAM size of STM32F103xB, must match __RAM_size__ of LinkerConfig.icf
+#define SRAM_SIZE             ((uint32_t)0x00005000)
 // Peripheral base address in the alias region
 #define PERIPH_BASE           ((uint32_t)0x40000000)
 
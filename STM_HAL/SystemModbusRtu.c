@@ -0,0 +1,538 @@
+// (c) IMT - Information Management Technology AG, CH-9470 Buchs, www.imt.ch.
+// SW guideline: Technote Coding Guidelines Ver. 1.5.1
+
+#include "SystemModbusRtu.h"
+
+// Project includes
+#include "SystemPeripherals_USART.h"
+#include "SystemPeripherals_DMA.h"
+#include "SystemPeripherals_TIM.h"
+#include "SystemStartupControl.h"
+#include "Core_CortexM3.h"
+
+// Imt.Base includes
+#include <Imt.Base.Core.Diagnostics/Diagnostics.h>
+
+//@{
+// USART and gap timer, the DMA channels are in the header
+//@}
+#define MODBUSRTU_USART   USART_ModuleAddress_USART3
+#define MODBUSRTU_TIMER   TIM_ModuleAddress_TIM1
+
+// Receive buffer, a frame filling it completely is an overrun
+#define MODBUSRTU_RX_BUFFER_SIZE (MODBUSRTU_MAX_FRAME_SIZE + 1U)
+
+// Gap timer tick 1us, fixed gaps above 19200 baud (Modbus over Serial Line V1.02 Chapter 2.5.1.1)
+#define MODBUSRTU_TIMER_FREQUENCY 1000000U
+#define MODBUSRTU_FIXED_GAP_BAUDRATE 19200U
+#define MODBUSRTU_FIXED_T15_US 750U
+#define MODBUSRTU_FIXED_T35_US 1750U
+#define MODBUSRTU_MIN_BAUDRATE 1200U
+#define MODBUSRTU_MAX_BAUDRATE 115200U
+
+//@{
+// Function codes and exception codes
+//@}
+#define MODBUSRTU_READ_HOLDING_REGISTERS    0x03U
+#define MODBUSRTU_READ_INPUT_REGISTERS      0x04U
+#define MODBUSRTU_WRITE_SINGLE_REGISTER     0x06U
+#define MODBUSRTU_WRITE_MULTIPLE_REGISTERS  0x10U
+#define MODBUSRTU_EXCEPTION_FLAG            0x80U
+#define MODBUSRTU_ILLEGAL_FUNCTION          0x01U
+#define MODBUSRTU_ILLEGAL_DATA_ADDRESS      0x02U
+#define MODBUSRTU_ILLEGAL_DATA_VALUE        0x03U
+
+//@{
+// Request limits: registers per read and write, size of a request without CRC (address, function, start, quantity)
+//@}
+#define MODBUSRTU_MAX_READ_REGISTERS  125U
+#define MODBUSRTU_MAX_WRITE_REGISTERS 123U
+#define MODBUSRTU_REQUEST_SIZE        6U
+#define MODBUSRTU_BROADCAST_ADDRESS   0U
+// Shortest frame: address, function and CRC
+#define MODBUSRTU_MIN_FRAME_SIZE      4U
+
+//@{
+// CRC-16 table of the reflected polynomial 0xA001, one entry per byte value
+//@}
+static const uint16_t MODBUSRTU_CRC_TABLE[256] = {
+    0x0000U, 0xC0C1U, 0xC181U, 0x0140U, 0xC301U, 0x03C0U, 0x0280U, 0xC241U,
+    0xC601U, 0x06C0U, 0x0780U, 0xC741U, 0x0500U, 0xC5C1U, 0xC481U, 0x0440U,
+    0xCC01U, 0x0CC0U, 0x0D80U, 0xCD41U, 0x0F00U, 0xCFC1U, 0xCE81U, 0x0E40U,
+    0x0A00U, 0xCAC1U, 0xCB81U, 0x0B40U, 0xC901U, 0x09C0U, 0x0880U, 0xC841U,
+    0xD801U, 0x18C0U, 0x1980U, 0xD941U, 0x1B00U, 0xDBC1U, 0xDA81U, 0x1A40U,
+    0x1E00U, 0xDEC1U, 0xDF81U, 0x1F40U, 0xDD01U, 0x1DC0U, 0x1C80U, 0xDC41U,
+    0x1400U, 0xD4C1U, 0xD581U, 0x1540U, 0xD701U, 0x17C0U, 0x1680U, 0xD641U,
+    0xD201U, 0x12C0U, 0x1380U, 0xD341U, 0x1100U, 0xD1C1U, 0xD081U, 0x1040U,
+    0xF001U, 0x30C0U, 0x3180U, 0xF141U, 0x3300U, 0xF3C1U, 0xF281U, 0x3240U,
+    0x3600U, 0xF6C1U, 0xF781U, 0x3740U, 0xF501U, 0x35C0U, 0x3480U, 0xF441U,
+    0x3C00U, 0xFCC1U, 0xFD81U, 0x3D40U, 0xFF01U, 0x3FC0U, 0x3E80U, 0xFE41U,
+    0xFA01U, 0x3AC0U, 0x3B80U, 0xFB41U, 0x3900U, 0xF9C1U, 0xF881U, 0x3840U,
+    0x2800U, 0xE8C1U, 0xE981U, 0x2940U, 0xEB01U, 0x2BC0U, 0x2A80U, 0xEA41U,
+    0xEE01U, 0x2EC0U, 0x2F80U, 0xEF41U, 0x2D00U, 0xEDC1U, 0xEC81U, 0x2C40U,
+    0xE401U, 0x24C0U, 0x2580U, 0xE541U, 0x2700U, 0xE7C1U, 0xE681U, 0x2640U,
+    0x2200U, 0xE2C1U, 0xE381U, 0x2340U, 0xE101U, 0x21C0U, 0x2080U, 0xE041U,
+    0xA001U, 0x60C0U, 0x6180U, 0xA141U, 0x6300U, 0xA3C1U, 0xA281U, 0x6240U,
+    0x6600U, 0xA6C1U, 0xA781U, 0x6740U, 0xA501U, 0x65C0U, 0x6480U, 0xA441U,
+    0x6C00U, 0xACC1U, 0xAD81U, 0x6D40U, 0xAF01U, 0x6FC0U, 0x6E80U, 0xAE41U,
+    0xAA01U, 0x6AC0U, 0x6B80U, 0xAB41U, 0x6900U, 0xA9C1U, 0xA881U, 0x6840U,
+    0x7800U, 0xB8C1U, 0xB981U, 0x7940U, 0xBB01U, 0x7BC0U, 0x7A80U, 0xBA41U,
+    0xBE01U, 0x7EC0U, 0x7F80U, 0xBF41U, 0x7D00U, 0xBDC1U, 0xBC81U, 0x7C40U,
+    0xB401U, 0x74C0U, 0x7580U, 0xB541U, 0x7700U, 0xB7C1U, 0xB681U, 0x7640U,
+    0x7200U, 0xB2C1U, 0xB381U, 0x7340U, 0xB101U, 0x71C0U, 0x7080U, 0xB041U,
+    0x5000U, 0x90C1U, 0x9181U, 0x5140U, 0x9301U, 0x53C0U, 0x5280U, 0x9241U,
+    0x9601U, 0x56C0U, 0x5780U, 0x9741U, 0x5500U, 0x95C1U, 0x9481U, 0x5440U,
+    0x9C01U, 0x5CC0U, 0x5D80U, 0x9D41U, 0x5F00U, 0x9FC1U, 0x9E81U, 0x5E40U,
+    0x5A00U, 0x9AC1U, 0x9B81U, 0x5B40U, 0x9901U, 0x59C0U, 0x5880U, 0x9841U,
+    0x8801U, 0x48C0U, 0x4980U, 0x8941U, 0x4B00U, 0x8BC1U, 0x8A81U, 0x4A40U,
+    0x4E00U, 0x8EC1U, 0x8F81U, 0x4F40U, 0x8D01U, 0x4DC0U, 0x4C80U, 0x8C41U,
+    0x4400U, 0x84C1U, 0x8581U, 0x4540U, 0x8701U, 0x47C0U, 0x4680U, 0x8641U,
+    0x8201U, 0x42C0U, 0x4380U, 0x8341U, 0x4100U, 0x81C1U, 0x8081U, 0x4040U
+};
+
+static ModbusRtu_Config modbusRtuConfig;
+static ModbusRtu_Statistics modbusRtuStatistics;
+
+//@{
+// Receive: frame written by the DMA (.noinit), CRC over the first modbusRtuRxCrcCount bytes, received bytes at the
+// idle line and at t1.5, frame dropped up to the next silence of t3.5
+//@}
+static STARTUP_NOINIT uint8_t modbusRtuRxBuffer[MODBUSRTU_RX_BUFFER_SIZE];
+static uint16_t modbusRtuRxCrc = 0xFFFFU;
+static uint32_t modbusRtuRxCrcCount = 0U;
+static uint32_t modbusRtuIdleCount = 0U;
+static uint32_t modbusRtuGapCount = 0U;
+static bool modbusRtuIsFrameDropped = false;
+
+//@{
+// Transmit: response built at t1.5 with its CRC, sent at t3.5 (.noinit)
+//@}
+static STARTUP_NOINIT uint8_t modbusRtuTxBuffer[MODBUSRTU_MAX_FRAME_SIZE];
+static uint32_t modbusRtuTxSize = 0U;
+static uint16_t modbusRtuTxCrc = 0xFFFFU;
+
+uint16_t ModbusRtu_UpdateCrc(uint16_t crc, const uint8_t* const pData, const uint32_t size) {
+    if (pData == NULL) {
+        ASSERT_DEBUG(false);
+        return crc;
+    }
+    for (uint32_t index = 0U; index < size; ++index) {
+        crc = (uint16_t)((crc >> 8) ^ MODBUSRTU_CRC_TABLE[(crc ^ pData[index]) & 0xFFU]);
+    }
+    return crc;
+}
+
+//@{
+// Returns the number of bytes received into the buffer since the receive restarted.
+//@}
+static uint32_t ModbusRtu_GetRxCount(void) {
+    return MODBUSRTU_RX_BUFFER_SIZE - (uint32_t)DMA_GetCurrDataCounter(MODBUSRTU_RX_DMA_CHANNEL);
+}
+
+//@{
+// Advance the CRC of the frame over the bytes received since the last call.
+//@}
+static void ModbusRtu_AdvanceRxCrc(void) {
+    const uint32_t count = ModbusRtu_GetRxCount();
+    modbusRtuRxCrc = ModbusRtu_UpdateCrc(modbusRtuRxCrc, &modbusRtuRxBuffer[modbusRtuRxCrcCount], count - modbusRtuRxCrcCount);
+    modbusRtuRxCrcCount = count;
+}
+
+//@{
+// Receive the next frame at the beginning of the buffer, called after a silence of t3.5.
+//@}
+static void ModbusRtu_RestartReceive(void) {
+    DMA_Enable(MODBUSRTU_RX_DMA_CHANNEL, false);
+    DMA_ClearPendingInterrupt((DMA_IrqFlag)(DMA1_IrqFlag_Ch3_HT | DMA1_IrqFlag_Ch3_TC | DMA1_IrqFlag_Ch3_GL));
+    DMA_SetCurrDataCounter(MODBUSRTU_RX_DMA_CHANNEL, (uint16_t)MODBUSRTU_RX_BUFFER_SIZE);
+    DMA_Enable(MODBUSRTU_RX_DMA_CHANNEL, true);
+    modbusRtuRxCrc = 0xFFFFU;
+    modbusRtuRxCrcCount = 0U;
+    modbusRtuIdleCount = 0U;
+    modbusRtuGapCount = 0U;
+    modbusRtuIsFrameDropped = false;
+}
+
+//@{
+// Append a byte to the response and advance its CRC.
+//@}
+static void ModbusRtu_AppendByte(const uint8_t value) {
+    modbusRtuTxBuffer[modbusRtuTxSize] = value;
+    ++modbusRtuTxSize;
+    modbusRtuTxCrc = (uint16_t)((modbusRtuTxCrc >> 8) ^ MODBUSRTU_CRC_TABLE[(modbusRtuTxCrc ^ value) & 0xFFU]);
+}
+
+//@{
+// Append a register value or address, high byte first.
+//@}
+static void ModbusRtu_AppendWord(const uint16_t value) {
+    ModbusRtu_AppendByte((uint8_t)(value >> 8));
+    ModbusRtu_AppendByte((uint8_t)value);
+}
+
+//@{
+// Returns the big endian word of the request at the index.
+//@}
+static uint16_t ModbusRtu_GetWord(const uint32_t index) {
+    return (uint16_t)(((uint16_t)modbusRtuRxBuffer[index] << 8) | modbusRtuRxBuffer[index + 1U]);
+}
+
+//@{
+// Returns the range containing all registers [address, address + quantity), NULL if there is none.
+//@}
+static const ModbusRtu_RegisterRange* ModbusRtu_FindRange(const ModbusRtu_RegisterRange* const pRanges, const uint32_t rangeCount,
+                                                         const uint32_t address, const uint32_t quantity) {
+    for (uint32_t index = 0U; index < rangeCount; ++index) {
+        const ModbusRtu_RegisterRange* const pRange = &pRanges[index];
+        if ((address >= pRange->Address) && ((address + quantity) <= ((uint32_t)pRange->Address + pRange->Count))) {
+            return pRange;
+        }
+    }
+    return NULL;
+}
+
+//@{
+// Write a holding register if the write handler accepts the value.
+// @return uint8_t: 0 or the exception code
+//@}
+static uint8_t ModbusRtu_WriteRegister(const ModbusRtu_RegisterRange* const pRange, const uint16_t address, const uint16_t value) {
+    if ((pRange->WriteHandler != NULL) && !pRange->WriteHandler(pRange->pContext, address, value)) {
+        return MODBUSRTU_ILLEGAL_DATA_VALUE;
+    }
+    pRange->pValues[address - pRange->Address] = value;
+    return 0U;
+}
+
+//@{
+// Execute the request in the receive buffer and append the response PDU after the address.
+// @param size: Request size without the CRC.
+// @return uint8_t: 0 or the exception code
+//@}
+static uint8_t ModbusRtu_ExecuteRequest(const uint32_t size) {
+    const ModbusRtu_RegisterMap* const pMap = modbusRtuConfig.pRegisterMap;
+    const uint8_t function = modbusRtuRxBuffer[1];
+    if ((function != MODBUSRTU_READ_HOLDING_REGISTERS) && (function != MODBUSRTU_READ_INPUT_REGISTERS)
+        && (function != MODBUSRTU_WRITE_SINGLE_REGISTER) && (function != MODBUSRTU_WRITE_MULTIPLE_REGISTERS)) {
+        return MODBUSRTU_ILLEGAL_FUNCTION;
+    }
+    if (size < MODBUSRTU_REQUEST_SIZE) {
+        return MODBUSRTU_ILLEGAL_DATA_VALUE;
+    }
+    const uint16_t address = ModbusRtu_GetWord(2U);
+    const uint16_t quantity = ModbusRtu_GetWord(4U);
+    uint8_t exception = 0U;
+
+    if (function == MODBUSRTU_WRITE_SINGLE_REGISTER) {
+        // quantity is the value
+        const ModbusRtu_RegisterRange* const pRange = ModbusRtu_FindRange(pMap->pHoldingRanges, pMap->HoldingRangeCount, address, 1U);
+        if (size != MODBUSRTU_REQUEST_SIZE) {
+            exception = MODBUSRTU_ILLEGAL_DATA_VALUE;
+        }
+        else if (pRange == NULL) {
+            exception = MODBUSRTU_ILLEGAL_DATA_ADDRESS;
+        }
+        else {
+            exception = ModbusRtu_WriteRegister(pRange, address, quantity);
+        }
+        if (exception == 0U) {
+            // echo of the request
+            ModbusRtu_AppendByte(function);
+            ModbusRtu_AppendWord(address);
+            ModbusRtu_AppendWord(quantity);
+        }
+    }
+    else if (function == MODBUSRTU_WRITE_MULTIPLE_REGISTERS) {
+        const ModbusRtu_RegisterRange* const pRange = ModbusRtu_FindRange(pMap->pHoldingRanges, pMap->HoldingRangeCount, address, quantity);
+        const uint32_t byteCount = (size > MODBUSRTU_REQUEST_SIZE) ? modbusRtuRxBuffer[MODBUSRTU_REQUEST_SIZE] : 0U;
+        if ((quantity == 0U) || (quantity > MODBUSRTU_MAX_WRITE_REGISTERS) || (byteCount != (2U * quantity))
+            || (size != (MODBUSRTU_REQUEST_SIZE + 1U + byteCount))) {
+            exception = MODBUSRTU_ILLEGAL_DATA_VALUE;
+        }
+        else if (pRange == NULL) {
+            exception = MODBUSRTU_ILLEGAL_DATA_ADDRESS;
+        }
+        else {
+            // a rejected value stops the write, the registers before it are written
+            for (uint32_t index = 0U; (index < quantity) && (exception == 0U); ++index) {
+                exception = ModbusRtu_WriteRegister(pRange, (uint16_t)(address + index), ModbusRtu_GetWord(MODBUSRTU_REQUEST_SIZE + 1U + (2U * index)));
+            }
+        }
+        if (exception == 0U) {
+            ModbusRtu_AppendByte(function);
+            ModbusRtu_AppendWord(address);
+            ModbusRtu_AppendWord(quantity);
+        }
+    }
+    else {
+        const bool isHolding = (function == MODBUSRTU_READ_HOLDING_REGISTERS);
+        const ModbusRtu_RegisterRange* const pRange = isHolding ? ModbusRtu_FindRange(pMap->pHoldingRanges, pMap->HoldingRangeCount, address, quantity)
+                                                                : ModbusRtu_FindRange(pMap->pInputRanges, pMap->InputRangeCount, address, quantity);
+        if ((size != MODBUSRTU_REQUEST_SIZE) || (quantity == 0U) || (quantity > MODBUSRTU_MAX_READ_REGISTERS)) {
+            exception = MODBUSRTU_ILLEGAL_DATA_VALUE;
+        }
+        else if (pRange == NULL) {
+            exception = MODBUSRTU_ILLEGAL_DATA_ADDRESS;
+        }
+        else {
+            ModbusRtu_AppendByte(function);
+            ModbusRtu_AppendByte((uint8_t)(2U * quantity));
+            const uint16_t* const pValues = &pRange->pValues[address - pRange->Address];
+            for (uint32_t index = 0U; index < quantity; ++index) {
+                ModbusRtu_AppendWord(pValues[index]);
+            }
+        }
+    }
+    return exception;
+}
+
+//@{
+// t1.5 after the last byte: the frame is complete if no byte followed the idle line, build the response.
+//@}
+static void ModbusRtu_HandleFrameEnd(void) {
+    const uint32_t startCycles = DWT->CYCCNT;
+    const uint32_t count = ModbusRtu_GetRxCount();
+    if (count != modbusRtuIdleCount) {
+        // bytes within t1.5: the frame continues, the next idle line restarts the timer
+        TIM_Enable(MODBUSRTU_TIMER, false);
+        TIM_ClearPendingInterrupt(MODBUSRTU_TIMER, TIM_IrqFlag_CaptureCompare2Interrupt);
+        return;
+    }
+    modbusRtuGapCount = count;
+    modbusRtuTxSize = 0U;
+    if (modbusRtuIsFrameDropped) {
+        return;
+    }
+
+    ModbusRtu_AdvanceRxCrc();
+    if ((count < MODBUSRTU_MIN_FRAME_SIZE) || (modbusRtuRxCrc != 0U)) {
+        ++modbusRtuStatistics.CrcErrors;
+        return;
+    }
+    const uint8_t slaveAddress = modbusRtuRxBuffer[0];
+    if ((slaveAddress != modbusRtuConfig.SlaveAddress) && (slaveAddress != MODBUSRTU_BROADCAST_ADDRESS)) {
+        ++modbusRtuStatistics.OtherAddress;
+        return;
+    }
+    ++modbusRtuStatistics.Frames;
+    if ((DMA_GetCurrDataCounter(MODBUSRTU_TX_DMA_CHANNEL) != 0U) || USART_Rs485IsTransmitting(MODBUSRTU_USART)) {
+        // the response buffer is in transmission, the master repeats the request after its timeout
+        ++modbusRtuStatistics.TxBusy;
+        return;
+    }
+
+    modbusRtuTxCrc = 0xFFFFU;
+    ModbusRtu_AppendByte(slaveAddress);
+    const uint8_t exception = ModbusRtu_ExecuteRequest(count - 2U);
+    if (exception != 0U) {
+        modbusRtuTxSize = 0U;
+        modbusRtuTxCrc = 0xFFFFU;
+        ModbusRtu_AppendByte(slaveAddress);
+        ModbusRtu_AppendByte((uint8_t)(modbusRtuRxBuffer[1] | MODBUSRTU_EXCEPTION_FLAG));
+        ModbusRtu_AppendByte(exception);
+        ++modbusRtuStatistics.Exceptions;
+    }
+    if (slaveAddress == MODBUSRTU_BROADCAST_ADDRESS) {
+        // executed without a response
+        modbusRtuTxSize = 0U;
+    }
+    else {
+        // low byte first, the CRC of the response is complete with its last byte
+        const uint16_t crc = modbusRtuTxCrc;
+        ModbusRtu_AppendByte((uint8_t)crc);
+        ModbusRtu_AppendByte((uint8_t)(crc >> 8));
+    }
+
+    const uint32_t cycles = DWT->CYCCNT - startCycles;
+    if (cycles > modbusRtuStatistics.MaxResponseCycles) {
+        modbusRtuStatistics.MaxResponseCycles = cycles;
+    }
+}
+
+//@{
+// t3.5 after the last byte: send the response and receive the next frame, unless bytes followed t1.5.
+//@}
+static void ModbusRtu_HandleSilence(void) {
+    if (ModbusRtu_GetRxCount() != modbusRtuGapCount) {
+        // the next idle line restarts the timer, the receive restarts after a silence of t3.5
+        if (!modbusRtuIsFrameDropped) {
+            ++modbusRtuStatistics.GapErrors;
+            modbusRtuIsFrameDropped = true;
+        }
+        modbusRtuTxSize = 0U;
+        return;
+    }
+    if (modbusRtuTxSize != 0U) {
+        // drives the bus in the RS-485 mode, released by the transmission complete interrupt
+        USART_Rs485BeginTransmit(MODBUSRTU_USART, modbusRtuTxSize);
+        DMA_Enable(MODBUSRTU_TX_DMA_CHANNEL, false);
+        DMA_SetCurrDataCounter(MODBUSRTU_TX_DMA_CHANNEL, (uint16_t)modbusRtuTxSize);
+        DMA_Enable(MODBUSRTU_TX_DMA_CHANNEL, true);
+        modbusRtuTxSize = 0U;
+    }
+    ModbusRtu_RestartReceive();
+}
+
+//@{
+// Configure a DMA channel between the data register of the USART and a buffer.
+//@}
+static void ModbusRtu_InitDma(const DMA_ChannelAddress dmaChannel, const DMA_DatatTransferDir direction, uint8_t* const pBuffer, const uint32_t size) {
+    DMA_InitStruct dmaInit;
+    dmaInit.PeripheralBaseAddr = USART_GetDataRegisterAddress(MODBUSRTU_USART);
+    dmaInit.MemoryBaseAddr = (uint32_t)pBuffer; //lint !e923 cast from pointer to int [MISRA C++ Rule 5-2-9]. Justification: DMA address register
+    dmaInit.DIR = direction;
+    dmaInit.BufferSize = size;
+    dmaInit.PeripheralInc = DMA_PeripheralInc_Disable;
+    dmaInit.MemoryInc = DMA_MemoryInc_Enable;
+    dmaInit.PeripheralDataSize = DMA_PeripheralDataSize_Byte;
+    dmaInit.MemoryDataSize = DMA_MemoryDataSize_Byte;
+    dmaInit.Mode = DMA_Mode_Normal;
+    dmaInit.Priority = DMA_Priority_Medium;
+    dmaInit.M2M = DMA_M2M_Disable;
+    DMA_Enable(dmaChannel, false);
+    DMA_Init(dmaChannel, &dmaInit);
+}
+
+//@{
+// Configure TIM1 as one pulse gap timer: compare 1 at t1.5 and compare 2 at t3.5 after the last byte,
+// started by the idle line one character time after the last byte.
+//@}
+static void ModbusRtu_InitTimer(const uint32_t baudRate, const uint32_t characterBits) {
+    const uint32_t characterUs = ((characterBits * MODBUSRTU_TIMER_FREQUENCY) + (baudRate - 1U)) / baudRate;
+    const uint32_t t15Us = (baudRate > MODBUSRTU_FIXED_GAP_BAUDRATE) ? MODBUSRTU_FIXED_T15_US : ((3U * characterUs) / 2U);
+    const uint32_t t35Us = (baudRate > MODBUSRTU_FIXED_GAP_BAUDRATE) ? MODBUSRTU_FIXED_T35_US : ((7U * characterUs) / 2U);
+
+    TIM_Enable(MODBUSRTU_TIMER, false);
+    TIM_TimeBaseInitStruct timeBase;
+    timeBase.Prescaler = (uint16_t)((TIM_GetInputClockFrequency(MODBUSRTU_TIMER) / MODBUSRTU_TIMER_FREQUENCY) - 1U);
+    timeBase.CounterMode = TIM_CounterModeUp;
+    timeBase.Period = (uint16_t)(t35Us - characterUs);
+    TIM_TimeBaseInit(MODBUSRTU_TIMER, &timeBase);
+    // the update at the end of the period stops the counter
+    TIM_SetOnePulseMode(MODBUSRTU_TIMER, TIM_OnePulseMode_Single);
+
+    TIM_OCInitStruct outputCompare;
+    outputCompare.OCMode = TIM_OCMode_Timing;
+    outputCompare.CaptureCompareEnable = false;
+    outputCompare.CaptureCompareValue = (uint16_t)(t15Us - characterUs);
+    outputCompare.OutputPolarity = TIM_OCPolarity_ActiveHigh;
+    TIM_OCInit(MODBUSRTU_TIMER, TIM_Channel1, &outputCompare);
+    outputCompare.CaptureCompareValue = (uint16_t)(t35Us - characterUs);
+    TIM_OCInit(MODBUSRTU_TIMER, TIM_Channel2, &outputCompare);
+
+    TIM_ClearPendingInterrupt(MODBUSRTU_TIMER, (TIM_IrqFlag)(TIM_IrqFlag_UpdateInterrupt | TIM_IrqFlag_CaptureCompare1Interrupt | TIM_IrqFlag_CaptureCompare2Interrupt));
+    TIM_EnableInterrupt(MODBUSRTU_TIMER, (TIM_Irq)(TIM_Irq_CaptureCompare1Interrupt | TIM_Irq_CaptureCompare2Interrupt), true);
+}
+
+void ModbusRtu_Init(const ModbusRtu_Config* const pConfig) {
+    if ((pConfig == NULL) || (pConfig->pRegisterMap == NULL)) {
+        ASSERT_DEBUG(false);
+        return;
+    }
+    // the gaps in microseconds fit the 16-bit timer down to 1200 baud
+    if ((pConfig->BaudRate < MODBUSRTU_MIN_BAUDRATE) || (pConfig->BaudRate > MODBUSRTU_MAX_BAUDRATE)
+        || (pConfig->CharacterBits < 10U) || (pConfig->CharacterBits > 12U)) {
+        ASSERT_DEBUG(false);
+        return;
+    }
+    modbusRtuConfig = *pConfig;
+    ModbusRtu_ResetStatistics();
+    ModbusRtu_InitTimer(pConfig->BaudRate, pConfig->CharacterBits);
+
+    ModbusRtu_InitDma(MODBUSRTU_RX_DMA_CHANNEL, DMA_DIR_PeripheralSRC, modbusRtuRxBuffer, MODBUSRTU_RX_BUFFER_SIZE);
+    DMA_EnableInterrupt(MODBUSRTU_RX_DMA_CHANNEL, DMA_Irq_HalfTransferComplete, true);
+    ModbusRtu_RestartReceive();
+    modbusRtuTxSize = 0U;
+    ModbusRtu_InitDma(MODBUSRTU_TX_DMA_CHANNEL, DMA_DIR_PeripheralDST, modbusRtuTxBuffer, 0U);
+
+    USART_EnableInterrupt(MODBUSRTU_USART, USART_Irq_CR1_RXNE, false);
+    USART_EnableDmaRequest(MODBUSRTU_USART, (USART_DmaRequest)(USART_DmaRequest_Rx | USART_DmaRequest_Tx), true);
+    USART_ClearIdleLine(MODBUSRTU_USART);
+    USART_EnableInterrupt(MODBUSRTU_USART, USART_Irq_CR1_IDLE, true);
+}
+
+void ModbusRtu_GetStatistics(ModbusRtu_Statistics* const pStatistics) {
+    if (pStatistics == NULL) {
+        ASSERT_DEBUG(false);
+        return;
+    }
+    const uint32_t previousBasePriority = CriticalSection_Enter(MODBUSRTU_CEILING);
+    *pStatistics = modbusRtuStatistics;
+    CriticalSection_Exit(previousBasePriority);
+}
+
+void ModbusRtu_ResetStatistics(void) {
+    const uint32_t previousBasePriority = CriticalSection_Enter(MODBUSRTU_CEILING);
+    modbusRtuStatistics.Frames = 0U;
+    modbusRtuStatistics.CrcErrors = 0U;
+    modbusRtuStatistics.GapErrors = 0U;
+    modbusRtuStatistics.CharacterErrors = 0U;
+    modbusRtuStatistics.Overruns = 0U;
+    modbusRtuStatistics.OtherAddress = 0U;
+    modbusRtuStatistics.Exceptions = 0U;
+    modbusRtuStatistics.TxBusy = 0U;
+    modbusRtuStatistics.MaxResponseCycles = 0U;
+    CriticalSection_Exit(previousBasePriority);
+}
+
+//------------------------------------------------------------------------------
+// USART3, TIM1 capture compare and DMA1 Channel3 interrupt handlers (overwrite the weak definitions of vector_table_M.s)
+//------------------------------------------------------------------------------
+#ifdef __cplusplus
+extern "C" {
+#endif // __cplusplus
+void USART3_IRQHandler(void);
+void TIM1_CC_IRQHandler(void);
+void DMA1_Channel3_IRQHandler(void);
+#ifdef __cplusplus
+}
+#endif // __cplusplus
+
+void USART3_IRQHandler(void) {
+    // end of the response in the RS-485 mode: release the bus first
+    (void)USART_Rs485HandleInterrupt(MODBUSRTU_USART);
+
+    if (USART_IsIdleLineDetected(MODBUSRTU_USART)) {
+        const uint32_t count = ModbusRtu_GetRxCount();
+        if (!modbusRtuIsFrameDropped) {
+            if (count == MODBUSRTU_RX_BUFFER_SIZE) {
+                ++modbusRtuStatistics.Overruns;
+                modbusRtuIsFrameDropped = true;
+            }
+            else if (USART_IsReceiveErrorDetected(MODBUSRTU_USART)) {
+                ++modbusRtuStatistics.CharacterErrors;
+                modbusRtuIsFrameDropped = true;
+            }
+            else {
+                ModbusRtu_AdvanceRxCrc();
+            }
+        }
+        // also clears the error flags
+        USART_ClearIdleLine(MODBUSRTU_USART);
+
+        // one character time after the last byte: restart the gap timer
+        modbusRtuIdleCount = count;
+        TIM_Enable(MODBUSRTU_TIMER, false);
+        TIM_SetCounter(MODBUSRTU_TIMER, 0U);
+        TIM_ClearPendingInterrupt(MODBUSRTU_TIMER, (TIM_IrqFlag)(TIM_IrqFlag_CaptureCompare1Interrupt | TIM_IrqFlag_CaptureCompare2Interrupt));
+        TIM_Enable(MODBUSRTU_TIMER, true);
+    }
+}
+
+void TIM1_CC_IRQHandler(void) {
+    if (TIM_IsPendingInterrupt(MODBUSRTU_TIMER, TIM_IrqFlag_CaptureCompare1Interrupt)) {
+        TIM_ClearPendingInterrupt(MODBUSRTU_TIMER, TIM_IrqFlag_CaptureCompare1Interrupt);
+        ModbusRtu_HandleFrameEnd();
+    }
+    if (TIM_IsPendingInterrupt(MODBUSRTU_TIMER, TIM_IrqFlag_CaptureCompare2Interrupt)) {
+        TIM_ClearPendingInterrupt(MODBUSRTU_TIMER, TIM_IrqFlag_CaptureCompare2Interrupt);
+        ModbusRtu_HandleSilence();
+    }
+}
+
+void DMA1_Channel3_IRQHandler(void) {
+    // half buffer received: advance the CRC during a long frame
+    DMA_ClearPendingInterrupt((DMA_IrqFlag)(DMA1_IrqFlag_Ch3_HT | DMA1_IrqFlag_Ch3_GL));
+    if (!modbusRtuIsFrameDropped) {
+        ModbusRtu_AdvanceRxCrc();
+    }
+}
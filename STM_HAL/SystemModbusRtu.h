@@ -0,0 +1,169 @@
+// (c) IMT - Information Management Technology AG, CH-9470 Buchs, www.imt.ch.
+// SW guideline: Technote Coding Guidelines Ver. 1.5.1
+
+#ifndef SYSTEMMODBUSRTU_H
+#define SYSTEMMODBUSRTU_H
+
+// Must be very first include
+#include <Imt.Base.Core.Platform/Platform.h>
+
+// Project includes
+#include "SystemPeripherals_DMA.h"
+
+// Determine if a C++ compiler is being used.  If so, ensure that standard C is used to process the API information.
+#ifdef __cplusplus
+extern "C" {
+#endif // __cplusplus
+
+//@{
+// Modbus RTU slave on USART3 with the frame gaps timed by TIM1, no CPU work per byte.
+// - Receive: DMA1 Channel3 writes the frame into a buffer. The idle line interrupt of USART3 (one character time after
+//   the last byte) advances the CRC-16 over the new bytes and restarts TIM1 in one pulse mode. The half buffer interrupt
+//   of the channel advances it during long frames, the CRC of a complete frame is known at its end.
+// - Gaps: compare 1 of TIM1 marks t1.5 after the last byte. Without new bytes the frame is complete: the request is
+//   checked (address, CRC residue 0) and executed, the response is built with its CRC while the bytes are appended.
+//   Compare 2 marks t3.5: without new bytes since t1.5 the response is sent by DMA1 Channel2 and the receive restarts.
+//   Bytes between t1.5 and t3.5 are a gap error, the frame is dropped.
+// - Registers: function codes 0x03 (read holding registers), 0x04 (read input registers), 0x06 (write single register)
+//   and 0x10 (write multiple registers) on the tables of a ModbusRtu_RegisterMap. A request must lie within one range.
+//   Exceptions 0x01 (function), 0x02 (address) and 0x03 (value). Writes of the broadcast address 0 have no response.
+//
+// On RS-485 the response drives the bus by the half-duplex mode of the USART (@see USART_Rs485Init), the transmission
+// complete interrupt releases it.
+//
+// USART3 must be initialized and the clocks of DMA1 and TIM1 enabled by the application. The interrupts USART3_IRQn,
+// TIM1_CC_IRQn and DMA1_Channel3_IRQn must be enabled in the NVIC at the same priority (@see MODBUSRTU_CEILING).
+// The write handlers are called from TIM1_CC_IRQHandler.
+//
+// Reference: Modbus over Serial Line V1.02 Chapter 2.5.1.1, Modbus Application Protocol V1.1b3 Chapter 6
+//@}
+
+// Size of the largest frame (address, PDU of 253 bytes, CRC), the receive buffer has one byte more to detect an overrun
+#define MODBUSRTU_MAX_FRAME_SIZE 256U
+
+// Ceiling of the state shared by USART3_IRQHandler, TIM1_CC_IRQHandler and DMA1_Channel3_IRQHandler
+#define MODBUSRTU_CEILING 3U
+
+// DMA channels of USART3 (@see ST_CortexM3_STM32F103_TRM_Rev15.pdf Chapter 13.3.7 DMA request mapping), owned by the slave
+#define MODBUSRTU_RX_DMA_CHANNEL DMA_ChannelAddress_DMA1_Channel3
+#define MODBUSRTU_TX_DMA_CHANNEL DMA_ChannelAddress_DMA1_Channel2
+
+//@{
+// Called when a holding register is written, before the value is stored.
+// @param pContext: Context of the register range.
+// @param address: Register address.
+// @param value: New value.
+// @return bool: false to reject the value (exception 0x03), the register keeps its value
+//@}
+typedef bool (*ModbusRtu_WriteHandler)(void* pContext, const uint16_t address, const uint16_t value);
+
+//@{
+// Range of consecutive registers
+//@}
+typedef struct {
+    // Address of the first register
+    uint16_t Address;
+
+    // Number of registers
+    uint16_t Count;
+
+    // Register values, read and written by the slave
+    uint16_t* pValues;
+
+    // Holding registers: write handler, NULL to accept any value. Not used for input registers.
+    ModbusRtu_WriteHandler WriteHandler;
+
+    // Passed unchanged to the write handler
+    void* pContext;
+} ModbusRtu_RegisterRange;
+
+//@{
+// Register map of the slave: tables of register ranges, sorted or not
+//@}
+typedef struct {
+    const ModbusRtu_RegisterRange* pHoldingRanges;
+    uint32_t HoldingRangeCount;
+    const ModbusRtu_RegisterRange* pInputRanges;
+    uint32_t InputRangeCount;
+} ModbusRtu_RegisterMap;
+
+//@{
+// Slave configuration
+//@}
+typedef struct {
+    // Slave address 1..247
+    uint8_t SlaveAddress;
+
+    // Baud rate of USART3 1200..115200, above 19200 baud the gaps are fixed to t1.5 = 750us and t3.5 = 1750us
+    uint32_t BaudRate;
+
+    // Bits per character: start, 8 data, parity or second stop and stop bit, 11 for the standard 8E1
+    uint32_t CharacterBits;
+
+    // Register map, kept by reference
+    const ModbusRtu_RegisterMap* pRegisterMap;
+} ModbusRtu_Config;
+
+//@{
+// Slave statistics since the last reset
+//@}
+typedef struct {
+    // Valid frames addressed to the slave, including broadcasts
+    uint32_t Frames;
+
+    // Frames with a wrong CRC or shorter than 4 bytes
+    uint32_t CrcErrors;
+
+    // Frames with bytes between t1.5 and t3.5
+    uint32_t GapErrors;
+
+    // Frames with a parity, framing or noise error of a character
+    uint32_t CharacterErrors;
+
+    // Frames longer than MODBUSRTU_MAX_FRAME_SIZE
+    uint32_t Overruns;
+
+    // Valid frames for another slave
+    uint32_t OtherAddress;
+
+    // Exception responses
+    uint32_t Exceptions;
+
+    // Requests dropped unanswered, the previous response was still in transmission or driving the bus
+    uint32_t TxBusy;
+
+    // Longest time from t1.5 to the complete response in CPU cycles, below one character time
+    uint32_t MaxResponseCycles;
+} ModbusRtu_Statistics;
+
+//@{
+// Configure the gap timer and the DMA channels, start the receive and enable the interrupts of USART3 and TIM1.
+// @param pConfig: Slave configuration.
+//@}
+void ModbusRtu_Init(const ModbusRtu_Config* const pConfig);
+
+//@{
+// Copy the statistics.
+// @param pStatistics: Pointer to the ModbusRtu_Statistics structure to fill.
+//@}
+void ModbusRtu_GetStatistics(ModbusRtu_Statistics* const pStatistics);
+
+//@{
+// Reset the statistics.
+//@}
+void ModbusRtu_ResetStatistics(void);
+
+//@{
+// Returns the CRC-16 (polynomial 0xA001 reflected, initial value 0xFFFF) advanced over the bytes.
+// @param crc: CRC of the preceding bytes, 0xFFFF for the first byte.
+// @param pData: Bytes.
+// @param size: Number of bytes.
+// @return uint16_t: CRC, sent low byte first. The CRC over a frame including its CRC is 0.
+//@}
+uint16_t ModbusRtu_UpdateCrc(uint16_t crc, const uint8_t* const pData, const uint32_t size);
+
+#ifdef __cplusplus
+}
+#endif // __cplusplus
+
+#endif // SYSTEMMODBUSRTU_H
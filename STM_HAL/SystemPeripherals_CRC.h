@@ -0,0 +1,126 @@
+// (c) IMT - Information Management Technology AG, CH-9470 Buchs, www.imt.ch.
+// SW guideline: Technote Coding Guidelines Ver. 1.5.1
+
+#ifndef SYSTEMPERIPHERALS_CRC_H
+#define SYSTEMPERIPHERALS_CRC_H
+
+// Must be very first include
+#include <Imt.Base.Core.Platform/Platform.h>
+
+// Determine if a C++ compiler is being used.  If so, ensure that standard C is used to process the API information.
+#ifdef __cplusplus
+extern "C" {
+#endif // __cplusplus
+
+//@{
+// CRC calculation unit (CRC32, polynomial 0x04C11DB7, initial value 0xFFFFFFFF, no reflection, no final XOR).
+// The unit processes 32-bit words MSB first, a word is read little endian from memory (byte 3 is processed first).
+// Data which is not a multiple of 4 bytes is completed in software: the remaining bytes are processed one by one in memory order.
+// The checksum of a byte stream does not depend on how the stream is split into CRC_Update calls (buffer chains).
+//
+// The unit is fed by CPU word writes (CRC_Update) or by memory-to-memory DMA (CRC_UpdateDma).
+// The unit holds a single running checksum and cannot be loaded with a start value: a context which lost the unit
+// to another context (CRC_Begin) continues in software with the identical table-driven algorithm.
+// On the host build the complete calculation is done in software with identical results.
+// CRC_UpdateDma uses DMA1 Channel1 in memory-to-memory mode.
+// The AHB clock of the unit (RCC_AHBPeriph_CRC) and for CRC_UpdateDma of DMA1 must be enabled by the application.
+// The functions are not reentrant, use the unit from one execution level (main or a single interrupt) only.
+//
+// Reference: ST_CortexM3_STM32F103_TRM_Rev15.pdf Chapter 4
+//@}
+
+// Initial value of the checksum after CRC_Begin
+#define CRC_INITIAL_VALUE ((uint32_t)0xFFFFFFFF)
+
+//@{
+// Running checksum of a byte stream
+//@}
+typedef struct {
+    // Checksum of all complete words processed so far
+    uint32_t Value;
+
+    // Bytes of an incomplete word, little endian
+    uint32_t PendingWord;
+
+    // Number of bytes in PendingWord (0..3)
+    uint32_t PendingCount;
+} CRC_Context;
+
+//@{
+// Cycles to checksum the same buffer
+//@}
+typedef struct {
+    // Size of the buffer in bytes
+    uint32_t Size;
+
+    // CRC unit fed by CPU word writes
+    uint32_t HardwareCycles;
+
+    // CRC unit fed by memory-to-memory DMA
+    uint32_t DmaCycles;
+
+    // Table-driven software CRC
+    uint32_t SoftwareCycles;
+} CRC_Benchmark;
+
+//@{
+// Start a new checksum, resets the CRC unit and takes it over for this context.
+// @param pContext: Checksum context.
+//@}
+void CRC_Begin(CRC_Context* const pContext);
+
+//@{
+// Add data to the checksum, complete words are written to the CRC unit by the CPU.
+// @param pContext: Checksum context.
+// @param pData: Data of any alignment.
+// @param size: Number of bytes.
+//@}
+void CRC_Update(CRC_Context* const pContext, const void* const pData, const uint32_t size);
+
+//@{
+// Add data to the checksum, complete words are written to the CRC unit by memory-to-memory DMA.
+// Blocks until the DMA transfer is completed, interrupts are served meanwhile.
+// Falls back to CRC_Update if the data is not word aligned or the stream has pending bytes.
+// @param pContext: Checksum context.
+// @param pData: Data, should be word aligned.
+// @param size: Number of bytes.
+//@}
+void CRC_UpdateDma(CRC_Context* const pContext, const void* const pData, const uint32_t size);
+
+//@{
+// Add data to the checksum with the table-driven software algorithm (no CRC unit).
+// @param pContext: Checksum context.
+// @param pData: Data of any alignment.
+// @param size: Number of bytes.
+//@}
+void CRC_UpdateSoftware(CRC_Context* const pContext, const void* const pData, const uint32_t size);
+
+//@{
+// Returns the checksum of all data added since CRC_Begin, the context can be updated further.
+// @param pContext: Checksum context.
+//@}
+uint32_t CRC_GetValue(const CRC_Context* const pContext);
+
+//@{
+// Returns the checksum of a single buffer.
+// @param pData: Data of any alignment.
+// @param size: Number of bytes.
+//@}
+uint32_t CRC_Calculate(const void* const pData, const uint32_t size);
+
+#if defined(__IAR_SYSTEMS_ICC__)
+//@{
+// Measure the cycles to checksum a buffer with the CRC unit (CPU and DMA fed) and in software.
+// Note: Requires the running DWT cycle counter (@see SystemStartupControl.h).
+// @param pData: Data, should be word aligned.
+// @param size: Number of bytes.
+// @param pBenchmark: Pointer to the CRC_Benchmark structure to fill.
+//@}
+void CRC_MeasureThroughput(const void* const pData, const uint32_t size, CRC_Benchmark* const pBenchmark);
+#endif // __IAR_SYSTEMS_ICC__
+
+#ifdef __cplusplus
+}
+#endif // __cplusplus
+
+#endif // SYSTEMPERIPHERALS_CRC_H
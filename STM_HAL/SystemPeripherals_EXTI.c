@@ -21,6 +21,9 @@ typedef struct {
     volatile uint32_t PR;
 } EXTI_ModuleRegisters;
 
+// Number of EXTI lines (EXTI_Line0..EXTI_Line19)
+#define EXTI_LINE_COUNT 20U
+
 void EXTI_Init(const EXTI_InitStruct* const extiInitStruct) {
     if (extiInitStruct == NULL) {
     //    ASSERT_DEBUG(false);
@@ -72,3 +75,23 @@ bool EXTI_IsITPending(const EXTI_Line line) {
     const EXTI_ModuleRegisters* const pEXTI = (EXTI_ModuleRegisters*)EXTI_BASE;
     return (pEXTI->PR & (uint32_t)line) > 0U;
 }
+
+void EXTI_EnableInterrupt(const uint32_t line, const bool enabled) {
+    // EXTI_IMR is the first register of the EXTI module
+    for (uint32_t lineNumber = 0U; lineNumber < EXTI_LINE_COUNT; ++lineNumber) {
+        if ((line & ((uint32_t)1U << lineNumber)) != 0U) {
+            BITBAND_PERIPH(EXTI_BASE, lineNumber) = enabled ? 1U : 0U;
+        }
+    }
+}
+
+uint32_t EXTI_GetPendingInterrupts(const uint32_t line) {
+    const EXTI_ModuleRegisters* const pEXTI = (EXTI_ModuleRegisters*)EXTI_BASE;
+    return pEXTI->PR & pEXTI->IMR & line;
+}
+
+void EXTI_ClearPendingInterrupts(const uint32_t line) {
+    EXTI_ModuleRegisters* const pEXTI = (EXTI_ModuleRegisters*)EXTI_BASE;
+    // the pending bits are cleared by writing 1, other lines are not affected
+    pEXTI->PR = line;
+}
@@ -120,6 +120,29 @@ void EXTI_ClearITPendingBit(const EXTI_Line line);
 //@}
 bool EXTI_IsITPending(const EXTI_Line line);
 
+//@{
+// Mask or unmask the interrupt request of the external interrupt lines.
+// Each line is written by its own bit-band access, so concurrent calls from different interrupt levels do not interfere.
+// Note: The pending bit is still set by an edge on a masked line, clear it before unmasking to ignore that edge.
+// @param line: One or more EXTI_Line values.
+// @param enabled: true: interrupt request enabled, false: masked
+//@}
+void EXTI_EnableInterrupt(const uint32_t line, const bool enabled);
+
+//@{
+// Returns the pending interrupt requests of the unmasked lines with a single read of the pending register.
+// Lines masked by EXTI_EnableInterrupt are ignored, their pending bits are kept.
+// @param line: One or more EXTI_Line values to check.
+// @return uint32_t: Bit n is set if line n is pending and unmasked.
+//@}
+uint32_t EXTI_GetPendingInterrupts(const uint32_t line);
+
+//@{
+// Clear the pending bits of one or more lines with a single write.
+// @param line: One or more EXTI_Line values.
+//@}
+void EXTI_ClearPendingInterrupts(const uint32_t line);
+
 #ifdef __cplusplus
 }
 #endif // __cplusplus
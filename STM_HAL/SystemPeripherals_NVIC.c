@@ -63,3 +63,13 @@ void NVIC_EnableIRQ(const IRQ_NumberType irqNumber) {
     // enable interrupt
     NVIC->ISER[((uint32_t)(irqNumber) >> 5)] = (1 << ((uint32_t)(irqNumber) & 0x1F));
 }
+
+void NVIC_DisableIRQ(const IRQ_NumberType irqNumber) {
+    // disable interrupt
+    NVIC->ICER[((uint32_t)(irqNumber) >> 5)] = (1 << ((uint32_t)(irqNumber) & 0x1F));
+}
+
+void NVIC_SetPendingIRQ(const IRQ_NumberType irqNumber) {
+    // set interrupt pending
+    NVIC->ISPR[((uint32_t)(irqNumber) >> 5)] = (1 << ((uint32_t)(irqNumber) & 0x1F));
+}
@@ -178,6 +178,20 @@ void NVIC_SetPriority(const IRQ_NumberType irqNumber, const IRQ_PriorityType irq
 // @param IRQ_NumberType irqNumber External interrupt number. Value cannot be negative.
 void NVIC_EnableIRQ(const IRQ_NumberType irqNumber);
 
+//@{
+// Disable External Interrupt.
+// The function disables a device-specific interrupt in the NVIC interrupt controller.
+// @param IRQ_NumberType irqNumber External interrupt number. Value cannot be negative.
+//@}
+void NVIC_DisableIRQ(const IRQ_NumberType irqNumber);
+
+//@{
+// Set Pending Interrupt.
+// The function sets the pending bit of a device-specific interrupt, the interrupt is taken like a hardware request.
+// @param IRQ_NumberType irqNumber External interrupt number. Value cannot be negative.
+//@}
+void NVIC_SetPendingIRQ(const IRQ_NumberType irqNumber);
+
 #ifdef __cplusplus
 }
 #endif // __cplusplus
@@ -3,11 +3,14 @@
 
 #include "SystemPeripherals_TIM.h"
 
+// Project includes
+#include "SystemPeripherals_RCC.h"
+
 // Imt.Base includes
 #include <Imt.Base.Core.Diagnostics/Diagnostics.h>
 
 //@{
-// General purpose timer module register structure (TIM2..TIM5)
+// General purpose timer module register structure (TIM2..TIM5), the same layout for TIM1 (RCR and BDTR are reserved here)
 //@}
 typedef struct {
     volatile uint16_t CR1;
@@ -70,6 +73,20 @@ typedef struct {
 // CKD[1:0] bits (clock division)
 #define  TIM_CR1_CKD            ((uint16_t)0x0300)
 
+//@{
+// TIM CR2 bit definitions
+//@}
+// MMS[2:0] bits (Master mode selection)
+#define  TIM_CR2_MMS            ((uint16_t)0x0070)
+
+//@{
+// TIM SMCR bit definitions
+//@}
+// SMS[2:0] bits (Slave mode selection)
+#define  TIM_SMCR_SMS           ((uint16_t)0x0007)
+// TS[2:0] bits (Trigger selection)
+#define  TIM_SMCR_TS            ((uint16_t)0x0070)
+
 //@{
 // TIM EGR bit definitions
 //@}
@@ -77,17 +94,60 @@ typedef struct {
 #define  TIM_EGR_UG             ((uint16_t)0x0001)
 
 //@{
-// TIM CCER bit definitions
+// TIM CCER bit definitions of channel 1, channel x is shifted by 4 * (x - 1)
+//@}
+#define TIM_CCER_CC1E           ((uint16_t)0x0001)
+#define TIM_CCER_CC1P           ((uint16_t)0x0002)
+
+//@{
+// TIM CCMR1 bit definitions of channel 1, channel 2 (CCMR1) and channel 4 (CCMR2) are shifted by 8,
+// channel 3 is at the same position in CCMR2
+//@}
+#define TIM_CCMR_CC1S           ((uint16_t)0x0003)
+#define TIM_CCMR_OC1PE          ((uint16_t)0x0008)
+#define TIM_CCMR_OC1M           ((uint16_t)0x0070)
+#define TIM_CCMR_IC1PSC         ((uint16_t)0x000C)
+#define TIM_CCMR_IC1F           ((uint16_t)0x00F0)
+
+//@{
+// Returns the Capture Compare Mode Register of a channel (CCMR1 for channel 1 and 2, CCMR2 for channel 3 and 4).
 //@}
-#define TIM_CCER_CC4E           ((uint16_t)0x1000)
-#define TIM_CCER_CC4P           ((uint16_t)0x2000)
+static volatile uint16_t* TIM_GetModeRegister(TIM_GeneralPurposeModuleRegisters* const pTIM, const TIM_Channel channel) {
+    return (channel < TIM_Channel3) ? &pTIM->CCMR1 : &pTIM->CCMR2;
+}
 
 //@{
-// TIM CCMR2 bit definitions
+// Returns the shift of the channel bits within its Capture Compare Mode Register.
 //@}
-#define TIM_CCMR2_CC4S           ((uint16_t)0x0300)
-#define TIM_CCMR2_OC4PE          ((uint16_t)0x0800)
-#define TIM_CCMR2_OC4M           ((uint16_t)0x7000)
+static uint16_t TIM_GetModeRegisterShift(const TIM_Channel channel) {
+    return ((channel == TIM_Channel2) || (channel == TIM_Channel4)) ? 8U : 0U;
+}
+
+//@{
+// Returns the Capture Compare Register of a channel, NULL for an invalid channel.
+//@}
+static volatile uint16_t* TIM_GetCompareRegister(TIM_GeneralPurposeModuleRegisters* const pTIM, const TIM_Channel channel) {
+    volatile uint16_t* pCCR = NULL;
+    switch (channel) {
+        case TIM_Channel1:
+            pCCR = &pTIM->CCR1;
+            break;
+        case TIM_Channel2:
+            pCCR = &pTIM->CCR2;
+            break;
+        case TIM_Channel3:
+            pCCR = &pTIM->CCR3;
+            break;
+        case TIM_Channel4:
+            pCCR = &pTIM->CCR4;
+            break;
+        default:
+            // Invalid channel
+            ASSERT_DEBUG(false);
+            break;
+    }
+    return pCCR;
+}
 
 void TIM_TimeBaseInit(const TIM_ModuleAddress timerModule, const TIM_TimeBaseInitStruct* const pTimInitStruct) {
     if (pTimInitStruct == NULL) {
@@ -138,59 +198,94 @@ void TIM_OCInit(const TIM_ModuleAddress timerModule, const TIM_Channel channel,
     }
 
     TIM_GeneralPurposeModuleRegisters* const pTIM = (TIM_GeneralPurposeModuleRegisters*)timerModule; //lint !e923 cast from int to pointer [MISRA C++ Rule 5-2-7], [MISRA C++ Rule 5-2-8]. Justification: With this construct we reach more type safety
-    switch (channel) {
-        case TIM_Channel4:
-            {
-                // Disable the Channel 4 Capture Compare: Reset the CC4E Bit
-                pTIM->CCER &= (uint16_t)(~(uint16_t)TIM_CCER_CC4E);
-
-                // Get CCER, CCMR2 register values
-                uint16_t tmpCCER = pTIM->CCER;
-                uint16_t tmpCCMR2 = pTIM->CCMR2;
-
-                // Reset the Output Compare mode and Capture/Compare selection Bits
-                tmpCCMR2 &= (~TIM_CCMR2_OC4M);
-                tmpCCMR2 &= (~TIM_CCMR2_CC4S);
-                // Select the Output Compare Mode
-                tmpCCMR2 |= (uint16_t)((uint16_t)pOcInitStruct->OCMode << 8U);
-
-                // Reset the Output Polarity level
-                tmpCCER &= (~TIM_CCER_CC4P);
-                // Set the Output Compare Polarity
-                tmpCCER |= (uint16_t)((uint16_t)pOcInitStruct->OutputPolarity << 12U);
-                // Enable/Disable Capture Compare
-                tmpCCER |= (pOcInitStruct->CaptureCompareEnable) ? TIM_CCER_CC4E : 0x0000U;
-
-                // Write back CCER, CCMR2, CCR4 register values
-                pTIM->CCMR2 = tmpCCMR2;
-                pTIM->CCR4 = pOcInitStruct->CaptureCompareValue;
-                pTIM->CCER = tmpCCER;
-            }
-            break;
-        default:
-            // Invalid channel selected -> do noting
-            ASSERT_DEBUG(false);
-            break;
+    volatile uint16_t* const pCCR = TIM_GetCompareRegister(pTIM, channel);
+    if (pCCR == NULL) {
+        // Invalid channel selected -> do noting
+        return;
     }
+    volatile uint16_t* const pCCMR = TIM_GetModeRegister(pTIM, channel);
+    const uint16_t modeShift = TIM_GetModeRegisterShift(channel);
+    const uint16_t enableShift = (uint16_t)channel;
+
+    // Disable the Channel Capture Compare: Reset the CCxE Bit
+    pTIM->CCER &= (uint16_t)(~(uint16_t)(TIM_CCER_CC1E << enableShift));
+
+    // Get CCER, CCMRx register values
+    uint16_t tmpCCER = pTIM->CCER;
+    uint16_t tmpCCMR = *pCCMR;
+
+    // Reset the Output Compare mode and Capture/Compare selection Bits
+    tmpCCMR &= (uint16_t)(~(uint16_t)(TIM_CCMR_OC1M << modeShift));
+    tmpCCMR &= (uint16_t)(~(uint16_t)(TIM_CCMR_CC1S << modeShift));
+    // Select the Output Compare Mode
+    tmpCCMR |= (uint16_t)((uint16_t)pOcInitStruct->OCMode << modeShift);
+
+    // Reset the Output Polarity level
+    tmpCCER &= (uint16_t)(~(uint16_t)(TIM_CCER_CC1P << enableShift));
+    // Set the Output Compare Polarity
+    tmpCCER |= (uint16_t)((uint16_t)pOcInitStruct->OutputPolarity << enableShift);
+    // Enable/Disable Capture Compare
+    tmpCCER |= (pOcInitStruct->CaptureCompareEnable) ? (uint16_t)(TIM_CCER_CC1E << enableShift) : 0x0000U;
+
+    // Write back CCER, CCMRx, CCRx register values
+    *pCCMR = tmpCCMR;
+    *pCCR = pOcInitStruct->CaptureCompareValue;
+    pTIM->CCER = tmpCCER;
 }
 
-void TIM_OCPreloadConfig(const TIM_ModuleAddress timerModule, const TIM_Channel channel, const TIM_OCPreloadState ocPreloadState) {
+void TIM_ICInit(const TIM_ModuleAddress timerModule, const TIM_Channel channel, const TIM_ICInitStruct* const pIcInitStruct) {
+    if ((pIcInitStruct == NULL) || (pIcInitStruct->Filter > 0x000FU)) {
+        ASSERT_DEBUG(false);
+        return;
+    }
+
     TIM_GeneralPurposeModuleRegisters* const pTIM = (TIM_GeneralPurposeModuleRegisters*)timerModule; //lint !e923 cast from int to pointer [MISRA C++ Rule 5-2-7], [MISRA C++ Rule 5-2-8]. Justification: With this construct we reach more type safety
+    if (channel > TIM_Channel4) {
+        // Invalid channel
+        ASSERT_DEBUG(false);
+        return;
+    }
+    volatile uint16_t* const pCCMR = TIM_GetModeRegister(pTIM, channel);
+    const uint16_t modeShift = TIM_GetModeRegisterShift(channel);
+    const uint16_t enableShift = (uint16_t)channel;
+
+    // Disable the Channel Capture Compare (CCxS is writable only with CCxE reset)
+    pTIM->CCER &= (uint16_t)(~(uint16_t)(TIM_CCER_CC1E << enableShift));
+
+    // Select the input, the prescaler and the filter
+    uint16_t tmpCCMR = *pCCMR;
+    tmpCCMR &= (uint16_t)(~(uint16_t)((TIM_CCMR_CC1S | TIM_CCMR_IC1PSC | TIM_CCMR_IC1F) << modeShift));
+    tmpCCMR |= (uint16_t)(((uint16_t)pIcInitStruct->Selection | (uint16_t)pIcInitStruct->Prescaler | (uint16_t)(pIcInitStruct->Filter << 4U)) << modeShift);
+    *pCCMR = tmpCCMR;
+
+    // Select the polarity and enable the capture
+    uint16_t tmpCCER = pTIM->CCER;
+    tmpCCER &= (uint16_t)(~(uint16_t)(TIM_CCER_CC1P << enableShift));
+    tmpCCER |= (uint16_t)(((uint16_t)pIcInitStruct->Polarity | TIM_CCER_CC1E) << enableShift);
+    pTIM->CCER = tmpCCER;
+}
 
-    switch (channel) {
-        case TIM_Channel4: {
-                // Modify the OC4PE Bit
-                uint16_t tmpCCMR2 = pTIM->CCMR2;
-                tmpCCMR2 &= ~(TIM_CCMR2_OC4PE);
-                tmpCCMR2 |= (uint16_t)((uint16_t)ocPreloadState << 8U);
-                pTIM->CCMR2 = tmpCCMR2;
-            }
-            break;
-        default:
-            // Invalid channel
-            ASSERT_DEBUG(false);
-            break;
+uint16_t TIM_GetCaptureValue(const TIM_ModuleAddress timerModule, const TIM_Channel channel) {
+    TIM_GeneralPurposeModuleRegisters* const pTIM = (TIM_GeneralPurposeModuleRegisters*)timerModule; //lint !e923 cast from int to pointer [MISRA C++ Rule 5-2-7], [MISRA C++ Rule 5-2-8]. Justification: With this construct we reach more type safety
+    const volatile uint16_t* const pCCR = TIM_GetCompareRegister(pTIM, channel);
+    return (pCCR != NULL) ? *pCCR : 0U;
+}
+
+void TIM_OCPreloadConfig(const TIM_ModuleAddress timerModule, const TIM_Channel channel, const TIM_OCPreloadState ocPreloadState) {
+    TIM_GeneralPurposeModuleRegisters* const pTIM = (TIM_GeneralPurposeModuleRegisters*)timerModule; //lint !e923 cast from int to pointer [MISRA C++ Rule 5-2-7], [MISRA C++ Rule 5-2-8]. Justification: With this construct we reach more type safety
+    if (channel > TIM_Channel4) {
+        // Invalid channel
+        ASSERT_DEBUG(false);
+        return;
     }
+
+    // Modify the OCxPE Bit
+    volatile uint16_t* const pCCMR = TIM_GetModeRegister(pTIM, channel);
+    const uint16_t modeShift = TIM_GetModeRegisterShift(channel);
+    uint16_t tmpCCMR = *pCCMR;
+    tmpCCMR &= (uint16_t)(~(uint16_t)(TIM_CCMR_OC1PE << modeShift));
+    tmpCCMR |= (uint16_t)((uint16_t)ocPreloadState << modeShift);
+    *pCCMR = tmpCCMR;
 }
 
 void TIM_CaptureCompareEnable(const TIM_ModuleAddress timerModule, const TIM_Channel channel, const bool doEnable) {
@@ -208,17 +303,25 @@ void TIM_CaptureCompareEnable(const TIM_ModuleAddress timerModule, const TIM_Cha
 
 void TIM_SetCompareValue(const TIM_ModuleAddress timerModule, const TIM_Channel channel, const uint16_t captureCompareValue) {
     TIM_GeneralPurposeModuleRegisters* const pTIM = (TIM_GeneralPurposeModuleRegisters*)timerModule; //lint !e923 cast from int to pointer [MISRA C++ Rule 5-2-7], [MISRA C++ Rule 5-2-8]. Justification: With this construct we reach more type safety
+    volatile uint16_t* const pCCR = TIM_GetCompareRegister(pTIM, channel);
+    if (pCCR != NULL) {
+        // Modify the Capture Compare Register value
+        *pCCR = captureCompareValue;
+    }
+}
 
-    switch (channel) {
-        case TIM_Channel4: {
-                // Modify the Capture Compare Register value
-                pTIM->CCR1 = captureCompareValue;
-            }
-            break;
-        default:
-            // Invalid channel
-         //   ASSERT_DEBUG(false);
-            break;
+uint32_t TIM_GetCompareRegisterAddress(const TIM_ModuleAddress timerModule, const TIM_Channel channel) {
+    TIM_GeneralPurposeModuleRegisters* const pTIM = (TIM_GeneralPurposeModuleRegisters*)timerModule; //lint !e923 cast from int to pointer [MISRA C++ Rule 5-2-7], [MISRA C++ Rule 5-2-8]. Justification: With this construct we reach more type safety
+    return (uint32_t)TIM_GetCompareRegister(pTIM, channel); //lint !e923 cast from pointer to int [MISRA C++ Rule 5-2-9]. Justification: DMA peripheral address
+}
+
+void TIM_EnableDmaRequest(const TIM_ModuleAddress timerModule, const TIM_DmaRequest dmaRequest, const bool doEnable) {
+    TIM_GeneralPurposeModuleRegisters* const pTIM = (TIM_GeneralPurposeModuleRegisters*)timerModule; //lint !e923 cast from int to pointer [MISRA C++ Rule 5-2-7], [MISRA C++ Rule 5-2-8]. Justification: With this construct we reach more type safety
+    if (doEnable) {
+        pTIM->DIER |= (uint16_t)dmaRequest;
+    }
+    else {
+        pTIM->DIER &= ~((uint16_t)dmaRequest);
     }
 }
 
@@ -237,6 +340,18 @@ void TIM_ClearPendingInterrupt(const TIM_ModuleAddress timerModule, const TIM_Ir
     pTIM->SR = ~(uint16_t)(flagToClear);
 }
 
+bool TIM_IsPendingInterrupt(const TIM_ModuleAddress timerModule, const TIM_IrqFlag irqFlag) {
+    const TIM_GeneralPurposeModuleRegisters* const pTIM = (TIM_GeneralPurposeModuleRegisters*)timerModule; //lint !e923 cast from int to pointer [MISRA C++ Rule 5-2-7], [MISRA C++ Rule 5-2-8]. Justification: With this construct we reach more type safety
+    return ((pTIM->SR & (uint16_t)irqFlag) != 0U);
+}
+
+uint32_t TIM_GetInputClockFrequency(const TIM_ModuleAddress timerModule) {
+    const RCC_Clocks clocks = RCC_GetClocksFreq();
+    // TIM1 is clocked by APB2, the general-purpose timers by APB1
+    const uint32_t busFrequency = (timerModule == TIM_ModuleAddress_TIM1) ? clocks.PCLK2_Frequency : clocks.PCLK1_Frequency;
+    return (busFrequency == clocks.HCLK_Frequency) ? busFrequency : (2U * busFrequency);
+}
+
 void TIM_SetOnePulseMode(const TIM_ModuleAddress timerModule, const TIM_OnePulseMode opmMode) {
     TIM_GeneralPurposeModuleRegisters* const pTIM = (TIM_GeneralPurposeModuleRegisters*)timerModule; //lint !e923 cast from int to pointer [MISRA C++ Rule 5-2-7], [MISRA C++ Rule 5-2-8]. Justification: With this construct we reach more type safety
     // Reset OPM bit
@@ -271,3 +386,23 @@ void TIM_SetUpdateRequestSource(const TIM_ModuleAddress timerModule, const TIM_U
         pTIM->CR1 &= ~(uint16_t)TIM_CR1_URS;
     }
 }
+
+void TIM_SetMasterMode(const TIM_ModuleAddress timerModule, const TIM_MasterMode masterMode) {
+    TIM_GeneralPurposeModuleRegisters* const pTIM = (TIM_GeneralPurposeModuleRegisters*)timerModule; //lint !e923 cast from int to pointer [MISRA C++ Rule 5-2-7], [MISRA C++ Rule 5-2-8]. Justification: With this construct we reach more type safety
+    uint16_t tmpCR2 = pTIM->CR2;
+    tmpCR2 &= (uint16_t)(~TIM_CR2_MMS);
+    tmpCR2 |= (uint16_t)masterMode;
+    pTIM->CR2 = tmpCR2;
+}
+
+void TIM_SetSlaveMode(const TIM_ModuleAddress timerModule, const TIM_InputTrigger inputTrigger, const TIM_SlaveMode slaveMode) {
+    TIM_GeneralPurposeModuleRegisters* const pTIM = (TIM_GeneralPurposeModuleRegisters*)timerModule; //lint !e923 cast from int to pointer [MISRA C++ Rule 5-2-7], [MISRA C++ Rule 5-2-8]. Justification: With this construct we reach more type safety
+    uint16_t tmpSMCR = pTIM->SMCR;
+    // the trigger is changed with the slave mode disabled
+    tmpSMCR &= (uint16_t)(~(uint16_t)(TIM_SMCR_SMS | TIM_SMCR_TS));
+    pTIM->SMCR = tmpSMCR;
+    tmpSMCR |= (uint16_t)inputTrigger;
+    pTIM->SMCR = tmpSMCR;
+    tmpSMCR |= (uint16_t)slaveMode;
+    pTIM->SMCR = tmpSMCR;
+}
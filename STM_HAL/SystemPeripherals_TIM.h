@@ -18,7 +18,9 @@ extern "C" {
 //@{
 // Timer (TIM) peripheral module.
 // The general-purpose timers consist of a 16-bit auto-reload counter driven by a programmable prescaler
-// Note: Only the general-purpose timers (TIM2 to TIM4) are implemented.
+// Note: Only the general-purpose timers (TIM2 to TIM4) are implemented. The advanced-control timer TIM1 has the same
+// registers for these functions and is supported without its outputs: the repetition counter, break and dead-time
+// registers keep their reset values (MOE cleared), the compare channels are usable as timing events.
 //
 // Reference: ST_CortexM3_STM32F103_TRM_Rev15.pdf Chapter 15
 // @author lbreitenmoser
@@ -28,6 +30,7 @@ extern "C" {
 // Enumeration of the available TIM modules
 //@}
 typedef enum {
+    TIM_ModuleAddress_TIM1 = TIM1_BASE,
     TIM_ModuleAddress_TIM2 = TIM2_BASE,
     TIM_ModuleAddress_TIM3 = TIM3_BASE,
     TIM_ModuleAddress_TIM4 = TIM4_BASE
@@ -50,6 +53,9 @@ typedef enum {
     TIM_OCMode_Active   = ((uint16_t)0x0010),
     TIM_OCMode_Inactive = ((uint16_t)0x0020),
     TIM_OCMode_Toggle   = ((uint16_t)0x0030),
+    // Output forced to the inactive or active level, used to set a defined level before toggling
+    TIM_OCMode_ForceInactive = ((uint16_t)0x0040),
+    TIM_OCMode_ForceActive   = ((uint16_t)0x0050),
     TIM_OCMode_PWM1     = ((uint16_t)0x0060),
     TIM_OCMode_PWM2     = ((uint16_t)0x0070)
 } TIM_OCMode;
@@ -74,6 +80,9 @@ typedef enum {
 // Enumeration of the available TIM channels.
 //@}
 typedef enum {
+    TIM_Channel1 = ((uint16_t)0x0000),
+    TIM_Channel2 = ((uint16_t)0x0004),
+    TIM_Channel3 = ((uint16_t)0x0008),
     TIM_Channel4 = ((uint16_t)0x000C)
 } TIM_Channel;
 
@@ -81,16 +90,75 @@ typedef enum {
 // Enumeration of the available TIM interrupts.
 //@}
 typedef enum {
-    TIM_Irq_UpdateInterrupt = ((uint16_t)0x0001)
+    TIM_Irq_UpdateInterrupt         = ((uint16_t)0x0001),
+    TIM_Irq_CaptureCompare1Interrupt = ((uint16_t)0x0002),
+    TIM_Irq_CaptureCompare2Interrupt = ((uint16_t)0x0004),
+    TIM_Irq_CaptureCompare3Interrupt = ((uint16_t)0x0008),
+    TIM_Irq_CaptureCompare4Interrupt = ((uint16_t)0x0010)
 } TIM_Irq;
 
 //@{
 // Enumeration of the available TIM status flags.
 //@}
 typedef enum {
-    TIM_IrqFlag_UpdateInterrupt = ((uint16_t)0x0001)
+    TIM_IrqFlag_UpdateInterrupt         = ((uint16_t)0x0001),
+    TIM_IrqFlag_CaptureCompare1Interrupt = ((uint16_t)0x0002),
+    TIM_IrqFlag_CaptureCompare2Interrupt = ((uint16_t)0x0004),
+    TIM_IrqFlag_CaptureCompare3Interrupt = ((uint16_t)0x0008),
+    TIM_IrqFlag_CaptureCompare4Interrupt = ((uint16_t)0x0010),
+    // A capture occurred while the capture flag of the channel was still set (the previous value was lost)
+    TIM_IrqFlag_CaptureCompare1Overcapture = ((uint16_t)0x0200),
+    TIM_IrqFlag_CaptureCompare2Overcapture = ((uint16_t)0x0400),
+    TIM_IrqFlag_CaptureCompare3Overcapture = ((uint16_t)0x0800),
+    TIM_IrqFlag_CaptureCompare4Overcapture = ((uint16_t)0x1000)
 } TIM_IrqFlag;
 
+//@{
+// Enumeration of the available TIM input capture polarities (edge of the input signal which is captured).
+//@}
+typedef enum {
+    TIM_ICPolarity_Rising  = ((uint16_t)0x0000),
+    TIM_ICPolarity_Falling = ((uint16_t)0x0002)
+} TIM_ICPolarity;
+
+//@{
+// Enumeration of the available TIM input capture input selections.
+// @see ST_CortexM3_STM32F103_TRM_Rev15.pdf Chapter 15.3.6 PWM input mode
+//@}
+typedef enum {
+    // Channel x captures its own input TIx
+    TIM_ICSelection_DirectTI   = ((uint16_t)0x0001),
+    // Channel x captures the input of its pair channel (TI1 <-> TI2, TI3 <-> TI4)
+    TIM_ICSelection_IndirectTI = ((uint16_t)0x0002),
+    // Channel x captures the trigger input TRC
+    TIM_ICSelection_TRC        = ((uint16_t)0x0003)
+} TIM_ICSelection;
+
+//@{
+// Enumeration of the available TIM input capture prescalers (capture every n-th edge).
+//@}
+typedef enum {
+    TIM_ICPrescaler_Div1 = ((uint16_t)0x0000),
+    TIM_ICPrescaler_Div2 = ((uint16_t)0x0004),
+    TIM_ICPrescaler_Div4 = ((uint16_t)0x0008),
+    TIM_ICPrescaler_Div8 = ((uint16_t)0x000C)
+} TIM_ICPrescaler;
+
+//@{
+// Enumeration of the available TIM DMA requests.
+// DMA1 channel mapping: TIM2_UP Channel2, TIM2_CH1 Channel5, TIM2_CH2 Channel7, TIM2_CH3 Channel1, TIM2_CH4 Channel7,
+// TIM3_UP Channel3, TIM3_CH1 Channel6, TIM3_CH3 Channel2, TIM3_CH4 Channel3,
+// TIM4_UP Channel7, TIM4_CH1 Channel1, TIM4_CH2 Channel4, TIM4_CH3 Channel5
+// @see ST_CortexM3_STM32F103_TRM_Rev15.pdf Chapter 13.3.7 DMA request mapping
+//@}
+typedef enum {
+    TIM_DmaRequest_Update          = ((uint16_t)0x0100),
+    TIM_DmaRequest_CaptureCompare1 = ((uint16_t)0x0200),
+    TIM_DmaRequest_CaptureCompare2 = ((uint16_t)0x0400),
+    TIM_DmaRequest_CaptureCompare3 = ((uint16_t)0x0800),
+    TIM_DmaRequest_CaptureCompare4 = ((uint16_t)0x1000)
+} TIM_DmaRequest;
+
 //@{
 // Enumeration of the available one pulse modes.
 // @see ST_CortexM3_STM32F103_TRM_Rev15.pdf Chapter 15.4.1
@@ -112,6 +180,50 @@ typedef enum {
     TIM_UptateRequestSource_Regular
 } TIM_UpdateRequestSource;
 
+//@{
+// Enumeration of the available master modes: selects the trigger output (TRGO) to the slave timers.
+// @see ST_CortexM3_STM32F103_TRM_Rev15.pdf Chapter 15.3.15 Timer synchronization
+//@}
+typedef enum {
+    TIM_MasterMode_Reset  = ((uint16_t)0x0000),
+    TIM_MasterMode_Enable = ((uint16_t)0x0010),
+    TIM_MasterMode_Update = ((uint16_t)0x0020),
+    TIM_MasterMode_OC1    = ((uint16_t)0x0030),
+    TIM_MasterMode_OC1Ref = ((uint16_t)0x0040),
+    TIM_MasterMode_OC2Ref = ((uint16_t)0x0050),
+    TIM_MasterMode_OC3Ref = ((uint16_t)0x0060),
+    TIM_MasterMode_OC4Ref = ((uint16_t)0x0070)
+} TIM_MasterMode;
+
+//@{
+// Enumeration of the available slave modes.
+//@}
+typedef enum {
+    TIM_SlaveMode_Disabled      = ((uint16_t)0x0000),
+    TIM_SlaveMode_Reset         = ((uint16_t)0x0004),
+    TIM_SlaveMode_Gated         = ((uint16_t)0x0005),
+    TIM_SlaveMode_Trigger       = ((uint16_t)0x0006),
+    // The rising edges of the trigger input clock the counter
+    TIM_SlaveMode_ExternalClock = ((uint16_t)0x0007)
+} TIM_SlaveMode;
+
+//@{
+// Enumeration of the available slave trigger inputs.
+// Internal triggers: TIM2 ITR0 TIM1, ITR1 TIM8, ITR2 TIM3, ITR3 TIM4; TIM3 ITR0 TIM1, ITR1 TIM2, ITR2 TIM5, ITR3 TIM4;
+// TIM4 ITR0 TIM1, ITR1 TIM2, ITR2 TIM3, ITR3 TIM8
+// @see ST_CortexM3_STM32F103_TRM_Rev15.pdf Chapter 15.4.3 Table 86
+//@}
+typedef enum {
+    TIM_InputTrigger_ITR0    = ((uint16_t)0x0000),
+    TIM_InputTrigger_ITR1    = ((uint16_t)0x0010),
+    TIM_InputTrigger_ITR2    = ((uint16_t)0x0020),
+    TIM_InputTrigger_ITR3    = ((uint16_t)0x0030),
+    TIM_InputTrigger_TI1F_ED = ((uint16_t)0x0040),
+    TIM_InputTrigger_TI1FP1  = ((uint16_t)0x0050),
+    TIM_InputTrigger_TI2FP2  = ((uint16_t)0x0060),
+    TIM_InputTrigger_ETRF    = ((uint16_t)0x0070)
+} TIM_InputTrigger;
+
 //@{
 // TIM init structure definition
 //@}
@@ -146,6 +258,24 @@ typedef struct {
     TIM_OCPolarity OutputPolarity;
 } TIM_OCInitStruct;
 
+//@{
+// TIM Channel input capture init structure definition
+//@}
+typedef struct {
+    // Specifies the captured edge of the input signal.
+    TIM_ICPolarity Polarity;
+
+    // Specifies the input of the channel.
+    TIM_ICSelection Selection;
+
+    // Specifies the input capture prescaler.
+    TIM_ICPrescaler Prescaler;
+
+    // Specifies the input capture filter (ICxF), a number between 0x0 and 0xF.
+    // 0: no filter, else the input must be stable for N samples of the sampling frequency.
+    uint16_t Filter;
+} TIM_ICInitStruct;
+
 //@ {
 // Initializes the TIMx Time Base Unit peripheral according to the specified parameters in the TIM_TimeBaseInit_t.
 // @param timerModule: Select the TIM peripheral.
@@ -180,6 +310,25 @@ void TIM_SetCounter(const TIM_ModuleAddress timerModule, const uint16_t setCount
 //@}
 void TIM_OCInit(const TIM_ModuleAddress timerModule, const TIM_Channel channel, const TIM_OCInitStruct* const pOcInitStruct);
 
+//@{
+// Initializes the selected channel of the selected TIM peripheral as input capture according to the
+// specified parameters in the pIcInitStruct and enables the capture.
+// @param timerModule: Select the TIM peripheral.
+// @param channel: Select the channel.
+// @param pIcInitStruct: Pointer to a TIM_ICInitStruct structure that contains
+//                       the configuration information for the TIM channel.
+//@}
+void TIM_ICInit(const TIM_ModuleAddress timerModule, const TIM_Channel channel, const TIM_ICInitStruct* const pIcInitStruct);
+
+//@{
+// Returns the Capture Compare Register value of the selected channel of the selected
+// TIM peripheral. In input capture mode the read clears the capture flag of the channel.
+// @param timerModule: Select the TIM peripheral.
+// @param channel: Select the channel.
+// @return uint16_t: counter value at the last capture
+//@}
+uint16_t TIM_GetCaptureValue(const TIM_ModuleAddress timerModule, const TIM_Channel channel);
+
 //@{
 // Enables or disables the preload register of the selected channel of the selected
 // TIM peripheral.
@@ -209,6 +358,24 @@ void TIM_CaptureCompareEnable(const TIM_ModuleAddress timerModule, const TIM_Cha
 //@}
 void TIM_SetCompareValue(const TIM_ModuleAddress timerModule, const TIM_Channel channel, const uint16_t captureCompareValue);
 
+//@{
+// Returns the address of the Capture Compare Register of the selected channel of the selected
+// TIM peripheral, used as DMA peripheral address.
+// @param timerModule: Select the TIM peripheral.
+// @param channel: Select the channel.
+// @return uint32_t: address of the 16-bit CCRx register
+//@}
+uint32_t TIM_GetCompareRegisterAddress(const TIM_ModuleAddress timerModule, const TIM_Channel channel);
+
+//@{
+// Enables or disables the specified TIM DMA requests.
+// @param timerModule: Select the TIM peripheral.
+// @param dmaRequest: Specifies the TIM DMA request sources to be enabled or disabled.
+// @param doEnable: true DMA request would be enabled
+//                  false DMA request would be disabled
+//@}
+void TIM_EnableDmaRequest(const TIM_ModuleAddress timerModule, const TIM_DmaRequest dmaRequest, const bool doEnable);
+
 //@{
 // Enables or disables the specified TIM interrupts.
 // @param timerModule: Select the TIM peripheral.
@@ -225,6 +392,22 @@ void TIM_EnableInterrupt(const TIM_ModuleAddress timerModule, const TIM_Irq irq,
 //@}
 void TIM_ClearPendingInterrupt(const TIM_ModuleAddress timerModule, const TIM_IrqFlag irqFlag);
 
+//@{
+// Checks whether a TIM status flag is set, independent of the interrupt enable.
+// @param timerModule: Select the TIM peripheral.
+// @param irqFlag: Specifies the flag to check.
+// @return bool: true if the flag is set
+//@}
+bool TIM_IsPendingInterrupt(const TIM_ModuleAddress timerModule, const TIM_IrqFlag irqFlag);
+
+//@{
+// Returns the clock of the counter before the prescaler of the TIM peripheral:
+// PCLK1, doubled if the APB1 clock is divided (TIM2..TIM4 are on APB1), for TIM1 the same with PCLK2 (APB2).
+// @param timerModule: Select the TIM peripheral.
+// @return uint32_t: clock in Hz
+//@}
+uint32_t TIM_GetInputClockFrequency(const TIM_ModuleAddress timerModule);
+
 //@{
 // Sets the one pulse mode.
 // @param timerModule: Select the TIM peripheral.
@@ -254,6 +437,21 @@ void TIM_SetAutoreloadRegister(const TIM_ModuleAddress timerModule, const uint16
 //@}
 void TIM_SetUpdateRequestSource(const TIM_ModuleAddress timerModule, const TIM_UpdateRequestSource source);
 
+//@{
+// Selects the trigger output (TRGO) of a master timer.
+// @param timerModule: Select the TIM peripheral.
+// @param masterMode: Specifies the trigger output source.
+//@}
+void TIM_SetMasterMode(const TIM_ModuleAddress timerModule, const TIM_MasterMode masterMode);
+
+//@{
+// Selects the trigger input and the slave mode of a slave timer.
+// @param timerModule: Select the TIM peripheral.
+// @param inputTrigger: Specifies the trigger input, for the chaining an internal trigger ITRx of the master.
+// @param slaveMode: Specifies the reaction to the trigger.
+//@}
+void TIM_SetSlaveMode(const TIM_ModuleAddress timerModule, const TIM_InputTrigger inputTrigger, const TIM_SlaveMode slaveMode);
+
 #ifdef __cplusplus
 }
 #endif // __cplusplus
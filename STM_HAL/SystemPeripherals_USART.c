@@ -8,6 +8,7 @@
 
 // Project includes
 #include "SystemPeripherals_RCC.h"
+#include "Core_CortexM3.h"
 
 //@{
 // Universal synchronous asynchronous receiver transmitter module register structure (USART1..USART3)
@@ -38,6 +39,9 @@ typedef struct {
 #define CR1_OVER8_Set             ((uint16_t)0x8000)
 // USART CR1 Mask
 #define CR1_UE_Mask               ((uint16_t)0x2000)
+// USART receiver enable and transmission complete interrupt enable
+#define CR1_RE_Set                ((uint16_t)0x0004)
+#define CR1_TCIE_Set              ((uint16_t)0x0040)
 
 //@{
 // USART CR2 bit definitions
@@ -54,10 +58,54 @@ typedef struct {
 //@{
 // USART SR bit definitions
 //@}
+// Receive errors: parity, framing, noise and overrun
+#define SR_PE                     ((uint16_t)0x0001)
+#define SR_FE                     ((uint16_t)0x0002)
+#define SR_NE                     ((uint16_t)0x0004)
+#define SR_ORE                    ((uint16_t)0x0008)
+#define SR_IDLE                   ((uint16_t)0x0010)
 #define SR_RXNE                   ((uint16_t)0x0020)
 #define SR_TC                     ((uint16_t)0x0040)
 #define SR_TXE                    ((uint16_t)0x0080)
 
+//@{
+// RS-485 half-duplex state of a USART, not enabled while pDriverEnable is NULL
+//@}
+typedef struct {
+    USART_Rs485Config Config;
+    // Duration of one bit in CPU cycles, from the baud rate register
+    uint32_t CyclesPerBit;
+    // Start and expected duration of the running transmission
+    uint32_t StartCycles;
+    uint32_t DurationCycles;
+    bool IsTransmitting;
+    USART_Rs485Statistics Statistics;
+} USART_Rs485State;
+
+static USART_Rs485State usartRs485States[3];
+
+//@{
+// Returns the RS-485 state of the USART, NULL for an invalid module.
+//@}
+static USART_Rs485State* USART_GetRs485State(const USART_ModuleAddress usartModule) {
+    USART_Rs485State* pState = NULL;
+    switch (usartModule) {
+        case USART_ModuleAddress_USART1:
+            pState = &usartRs485States[0];
+            break;
+        case USART_ModuleAddress_USART2:
+            pState = &usartRs485States[1];
+            break;
+        case USART_ModuleAddress_USART3:
+            pState = &usartRs485States[2];
+            break;
+        default:
+            ASSERT_DEBUG(false);
+            break;
+    }
+    return pState;
+}
+
 void USART_DeInit(const USART_ModuleAddress usartModule) {
     switch (usartModule) {
         case USART_ModuleAddress_USART1:
@@ -158,6 +206,69 @@ void USART_Init(const USART_ModuleAddress usartModule, const USART_InitStruct* c
     pUsart->BRR = (uint16_t)tmpreg;
 }
 
+bool USART_CalculateBaudRate(const USART_ModuleAddress usartModule, const uint32_t baudRate, USART_BaudRateSetting* const pSetting) {
+    if ((pSetting == NULL) || (baudRate == 0U)) {
+        ASSERT_DEBUG(false);
+        return false;
+    }
+    pSetting->Divider = 0U;
+    pSetting->ActualBaudRate = 0U;
+    pSetting->ErrorPpm = 0;
+
+    const RCC_Clocks rccClock = RCC_GetClocksFreq();
+    const uint32_t busFrequency = (usartModule == USART_ModuleAddress_USART1) ? rccClock.PCLK2_Frequency : rccClock.PCLK1_Frequency;
+    // BRR = 16 * USARTDIV = bus clock / baud rate, at least 16 (USARTDIV 1.0)
+    const uint32_t divider = (busFrequency + (baudRate / 2U)) / baudRate;
+    if ((divider < 16U) || (divider > 0xFFFFU)) {
+        return false;
+    }
+    pSetting->Divider = (uint16_t)divider;
+    pSetting->ActualBaudRate = (busFrequency + (divider / 2U)) / divider;
+    // 64-bit: the bus clock in ppm exceeds 32 bits
+    const int64_t deviation = (((int64_t)busFrequency * 1000000) / (int64_t)divider) - ((int64_t)baudRate * 1000000);
+    pSetting->ErrorPpm = (int32_t)(deviation / (int64_t)baudRate);
+    return true;
+}
+
+bool USART_InitChecked(const USART_ModuleAddress usartModule, const USART_InitStruct* const pUsartInitStruct, const uint32_t maxErrorPpm,
+                       USART_BaudRateSetting* const pSetting) {
+    if ((pUsartInitStruct == NULL) || (pSetting == NULL)) {
+        ASSERT_DEBUG(false);
+        return false;
+    }
+    if (!USART_CalculateBaudRate(usartModule, pUsartInitStruct->BaudRate, pSetting)) {
+        return false;
+    }
+    const uint32_t errorPpm = (pSetting->ErrorPpm < 0) ? (uint32_t)(-pSetting->ErrorPpm) : (uint32_t)pSetting->ErrorPpm;
+    if (errorPpm > maxErrorPpm) {
+        return false;
+    }
+    USART_Init(usartModule, pUsartInitStruct);
+    // the rounded divider: USART_Init truncates the mantissa and drops the carry of a fraction rounded up to 16
+    USART_ModuleRegisters* const pUsart = (USART_ModuleRegisters*)usartModule;
+    pUsart->BRR = pSetting->Divider;
+    return true;
+}
+
+void USART_SetBaudRateDivider(const USART_ModuleAddress usartModule, const uint16_t divider) {
+    if (divider < 16U) {
+        ASSERT_DEBUG(false);
+        return;
+    }
+    USART_ModuleRegisters* const pUsart = (USART_ModuleRegisters*)usartModule;
+    pUsart->BRR = divider;
+}
+
+void USART_EnableReceiver(const USART_ModuleAddress usartModule, const bool doEnable) {
+    USART_ModuleRegisters* const pUsart = (USART_ModuleRegisters*)usartModule;
+    if (doEnable) {
+        pUsart->CR1 |= CR1_RE_Set;
+    }
+    else {
+        pUsart->CR1 &= ~CR1_RE_Set;
+    }
+}
+
 void USART_Enable(const USART_ModuleAddress usartModule, const bool doEnable) {
     USART_ModuleRegisters* const pUsart = (USART_ModuleRegisters*)usartModule;
     if (doEnable) {
@@ -198,6 +309,21 @@ void USART_EnableInterrupt(const USART_ModuleAddress usartModule, const USART_Ir
     }
 }
 
+void USART_EnableDmaRequest(const USART_ModuleAddress usartModule, const USART_DmaRequest dmaRequest, const bool doEnable) {
+    USART_ModuleRegisters* const pUsart = (USART_ModuleRegisters*)usartModule;
+    if (doEnable) {
+        pUsart->CR3 |= (uint16_t)dmaRequest;
+    }
+    else {
+        pUsart->CR3 &= ~((uint16_t)dmaRequest);
+    }
+}
+
+uint32_t USART_GetDataRegisterAddress(const USART_ModuleAddress usartModule) {
+    USART_ModuleRegisters* const pUsart = (USART_ModuleRegisters*)usartModule;
+    return (uint32_t)&pUsart->DR; //lint !e923 cast from pointer to int [MISRA C++ Rule 5-2-9]. Justification: DMA peripheral address
+}
+
 void USART_SendData(const USART_ModuleAddress usartModule, uint16_t data) {
     USART_ModuleRegisters* const pUsart = (USART_ModuleRegisters*)usartModule;
     pUsart->DR = (data & (uint16_t)0x01FF);
@@ -221,4 +347,114 @@ bool USART_IsTransmissionComplete(const USART_ModuleAddress usartModule) {
 bool USART_IsTransmitDataRegisterEmpty(const USART_ModuleAddress usartModule) {
     USART_ModuleRegisters* const pUsart = (USART_ModuleRegisters*)usartModule;
     return ((pUsart->SR & SR_TXE) != 0U);
-}
\ No newline at end of file
+}
+
+bool USART_IsIdleLineDetected(const USART_ModuleAddress usartModule) {
+    USART_ModuleRegisters* const pUsart = (USART_ModuleRegisters*)usartModule;
+    return ((pUsart->SR & SR_IDLE) != 0U);
+}
+
+bool USART_IsReceiveErrorDetected(const USART_ModuleAddress usartModule) {
+    USART_ModuleRegisters* const pUsart = (USART_ModuleRegisters*)usartModule;
+    return ((pUsart->SR & (SR_PE | SR_FE | SR_NE | SR_ORE)) != 0U);
+}
+
+void USART_ClearIdleLine(const USART_ModuleAddress usartModule) {
+    USART_ModuleRegisters* const pUsart = (USART_ModuleRegisters*)usartModule;
+    // the flag is cleared by the read sequence SR, DR
+    (void)pUsart->SR;
+    (void)pUsart->DR;
+}
+
+void USART_Rs485Init(const USART_ModuleAddress usartModule, const USART_Rs485Config* const pConfig) {
+    USART_Rs485State* const pState = USART_GetRs485State(usartModule);
+    if ((pState == NULL) || (pConfig == NULL) || (pConfig->pDriverEnable == NULL)) {
+        ASSERT_DEBUG(false);
+        return;
+    }
+    USART_ModuleRegisters* const pUsart = (USART_ModuleRegisters*)usartModule;
+    pState->Config = *pConfig;
+    pState->IsTransmitting = false;
+    *pConfig->pDriverEnable = 0U;
+    pUsart->CR1 &= ~CR1_TCIE_Set;
+    pUsart->CR1 |= CR1_RE_Set;
+
+    // one bit is 16 * USARTDIV = BRR clocks of the bus, the STM32F103 has no oversampling by 8 (@see USART_CalculateBaudRate)
+    const uint32_t busCyclesPerBit = pUsart->BRR;
+    const RCC_Clocks rccClock = RCC_GetClocksFreq();
+    const uint32_t busFrequency = (usartModule == USART_ModuleAddress_USART1) ? rccClock.PCLK2_Frequency : rccClock.PCLK1_Frequency;
+    pState->CyclesPerBit = busCyclesPerBit * (rccClock.HCLK_Frequency / busFrequency);
+    USART_Rs485ResetStatistics(usartModule);
+}
+
+void USART_Rs485BeginTransmit(const USART_ModuleAddress usartModule, const uint32_t size) {
+    USART_Rs485State* const pState = USART_GetRs485State(usartModule);
+    if ((pState == NULL) || (pState->Config.pDriverEnable == NULL)) {
+        return;
+    }
+    USART_ModuleRegisters* const pUsart = (USART_ModuleRegisters*)usartModule;
+    if (pState->IsTransmitting) {
+        ++pState->Statistics.Overlaps;
+    }
+    *pState->Config.pDriverEnable = 1U;
+    if (pState->Config.IsEchoSuppressed) {
+        pUsart->CR1 &= ~CR1_RE_Set;
+    }
+    // TC is still set from the last transmission, cleared by writing 0 (the other rc_w0 flags are kept by writing 1)
+    pUsart->SR = (uint16_t)~SR_TC;
+    pState->StartCycles = DWT->CYCCNT;
+    pState->DurationCycles = size * pState->Config.CharacterBits * pState->CyclesPerBit;
+    pState->IsTransmitting = true;
+    pUsart->CR1 |= CR1_TCIE_Set;
+}
+
+bool USART_Rs485HandleInterrupt(const USART_ModuleAddress usartModule) {
+    USART_Rs485State* const pState = USART_GetRs485State(usartModule);
+    USART_ModuleRegisters* const pUsart = (USART_ModuleRegisters*)usartModule;
+    if ((pState == NULL) || !pState->IsTransmitting || ((pUsart->SR & SR_TC) == 0U)) {
+        return false;
+    }
+    // the last stop bit has left the line: release the bus before anything else
+    *pState->Config.pDriverEnable = 0U;
+    const uint32_t endCycles = DWT->CYCCNT;
+    pUsart->CR1 &= ~CR1_TCIE_Set;
+    if (pState->Config.IsEchoSuppressed) {
+        pUsart->CR1 |= CR1_RE_Set;
+    }
+    pState->IsTransmitting = false;
+
+    const uint32_t elapsedCycles = endCycles - pState->StartCycles;
+    const uint32_t releaseCycles = (elapsedCycles > pState->DurationCycles) ? (elapsedCycles - pState->DurationCycles) : 0U;
+    ++pState->Statistics.Transmissions;
+    pState->Statistics.LastReleaseCycles = releaseCycles;
+    if (releaseCycles > pState->Statistics.MaxReleaseCycles) {
+        pState->Statistics.MaxReleaseCycles = releaseCycles;
+    }
+    return true;
+}
+
+bool USART_Rs485IsTransmitting(const USART_ModuleAddress usartModule) {
+    const USART_Rs485State* const pState = USART_GetRs485State(usartModule);
+    return (pState != NULL) && pState->IsTransmitting;
+}
+
+void USART_Rs485GetStatistics(const USART_ModuleAddress usartModule, USART_Rs485Statistics* const pStatistics) {
+    const USART_Rs485State* const pState = USART_GetRs485State(usartModule);
+    if ((pState == NULL) || (pStatistics == NULL)) {
+        ASSERT_DEBUG(false);
+        return;
+    }
+    *pStatistics = pState->Statistics;
+}
+
+void USART_Rs485ResetStatistics(const USART_ModuleAddress usartModule) {
+    USART_Rs485State* const pState = USART_GetRs485State(usartModule);
+    if (pState == NULL) {
+        ASSERT_DEBUG(false);
+        return;
+    }
+    pState->Statistics.Transmissions = 0U;
+    pState->Statistics.Overlaps = 0U;
+    pState->Statistics.LastReleaseCycles = 0U;
+    pState->Statistics.MaxReleaseCycles = 0U;
+}
@@ -18,6 +18,17 @@ extern "C" {
 //@{
 // Universal synchronous asynchronous receiver transmitter (USART).
 //
+// RS-485 half-duplex mode (USART_Rs485Init): a GPIO enables the line driver of the transceiver during a transmission.
+// USART_Rs485BeginTransmit drives the bus and enables the transmission complete (TC) interrupt, then the caller starts
+// the transmission (e.g. the TX DMA). TC is set when the last stop bit has left the line and the transmit data register
+// is empty, so with a DMA feeding the data register it is set once at the end. USART_Rs485HandleInterrupt releases the
+// bus first thing in the interrupt: the release latency is the interrupt entry plus a few instructions, well below one
+// bit time up to 115200 baud at 8MHz as long as no handler of the same or a higher priority runs. Otherwise the
+// release is delayed by the run time of those handlers: the bound of the application is stated with its interrupt
+// plan (e.g. APPLICATION_INTERRUPT_TABLE), the measured maximum is USART_Rs485Statistics.MaxReleaseCycles.
+// The echo of the own transmission (transceiver receiver always enabled) is suppressed by disabling the receiver of
+// the USART meanwhile.
+//
 // Reference: ST_CortexM3_STM32F103_TRM_Rev15.pdf Chapter 27
 // Reference: ST_CortexM3_STM32F103_Datasheet_Rev16.pdf Chapter 2.3.17
 // @author lbreitenmoser
@@ -91,6 +102,16 @@ typedef enum {
     USART_Irq_CR3_CTS  = ((uint16_t)0x0400)
 } USART_Irq;
 
+//@{
+// Enumeration of the available USART DMA requests.
+// USART1: TX DMA1 Channel4, RX DMA1 Channel5; USART2: TX Channel7, RX Channel6; USART3: TX Channel2, RX Channel3
+// @see ST_CortexM3_STM32F103_TRM_Rev15.pdf Chapter 13.3.7 DMA request mapping
+//@}
+typedef enum {
+    USART_DmaRequest_Rx = ((uint16_t)0x0040),
+    USART_DmaRequest_Tx = ((uint16_t)0x0080)
+} USART_DmaRequest;
+
 //@{
 // USART init structure definition
 //@}
@@ -121,6 +142,56 @@ typedef struct {
     USART_HardwareFlowControl HardwareFlowControl;
 } USART_InitStruct;
 
+//@{
+// RS-485 half-duplex configuration
+//@}
+typedef struct {
+    // Output data bit of the driver enable GPIO in the bit-band region (e.g. &GPIOB_12_WRITE_ADDR), 1 drives the bus
+    volatile uint32_t* pDriverEnable;
+
+    // Disable the receiver during the own transmissions, for transceivers with an always enabled receiver
+    bool IsEchoSuppressed;
+
+    // Bits per character: start, data, parity and stop bits, the duration of a transmission for the statistics
+    uint32_t CharacterBits;
+} USART_Rs485Config;
+
+//@{
+// RS-485 turnaround statistics since the last reset, times in CPU cycles
+//@}
+typedef struct {
+    // Completed transmissions
+    uint32_t Transmissions;
+
+    // Transmissions started before the previous one completed, the bus stays driven
+    uint32_t Overlaps;
+
+    // Release of the bus after the last stop bit: elapsed time since USART_Rs485BeginTransmit minus the duration of the
+    // characters at the configured baud rate, last and maximum value
+    uint32_t LastReleaseCycles;
+    uint32_t MaxReleaseCycles;
+} USART_Rs485Statistics;
+
+// Largest deviation of the baud rate accepted by USART_InitChecked: half of the smallest receiver tolerance (3.03%, 9 data
+// bits with a fractional divider), the other end of the line may deviate by the same amount
+// @see ST_CortexM3_STM32F103_TRM_Rev15.pdf Chapter 27.3.5 USART receiver's tolerance to clock deviation
+#define USART_BAUDRATE_MAX_ERROR_PPM 15000U
+
+//@{
+// Divider of a baud rate. The STM32F103 samples 16 times per bit (no OVER8), the highest baud rate is the bus clock / 16:
+// 4.5 Mbaud on USART1 at PCLK2 = 72MHz, 2.25 Mbaud on USART2/3 at PCLK1 = 36MHz, 500 kbaud at 8MHz.
+//@}
+typedef struct {
+    // BRR value: USARTDIV in 1/16, the bus clock divided by the baud rate rounded to the nearest integer
+    uint16_t Divider;
+
+    // Baud rate of the divider
+    uint32_t ActualBaudRate;
+
+    // Deviation of the actual from the requested baud rate in ppm, negative if slower
+    int32_t ErrorPpm;
+} USART_BaudRateSetting;
+
 
 //@ {
 // Deinitializes the USARTx peripheral registers to their default reset values.
@@ -136,6 +207,40 @@ void USART_DeInit(const USART_ModuleAddress usartModule);
 //@ }
 void USART_Init(const USART_ModuleAddress usartModule, const USART_InitStruct* const pUsartInitStruct);
 
+//@ {
+// Computes the divider of a baud rate at the current bus clock of the USART, the USART is not touched.
+// @param usartModule: USART module.
+// @param baudRate: Requested baud rate.
+// @param pSetting: Pointer to the USART_BaudRateSetting structure to fill.
+// @return bool: false if the baud rate is above the bus clock / 16 or below the bus clock / 65535
+//@ }
+bool USART_CalculateBaudRate(const USART_ModuleAddress usartModule, const uint32_t baudRate, USART_BaudRateSetting* const pSetting);
+
+//@ {
+// Initializes the USART like USART_Init with the rounded divider of USART_CalculateBaudRate, up to the bus clock / 16.
+// A baud rate out of range or with a larger error is rejected and the USART is not touched.
+// @param usartModule: USART module.
+// @param pUsartInitStruct: USART configuration.
+// @param maxErrorPpm: Largest accepted deviation of the baud rate, e.g. USART_BAUDRATE_MAX_ERROR_PPM.
+// @param pSetting: Pointer to the USART_BaudRateSetting structure to fill, also on a rejection.
+// @return bool: false if the configuration was rejected
+//@ }
+bool USART_InitChecked(const USART_ModuleAddress usartModule, const USART_InitStruct* const pUsartInitStruct, const uint32_t maxErrorPpm,
+                       USART_BaudRateSetting* const pSetting);
+
+//@ {
+// Writes the baud rate divider (BRR) without changing the frame format, e.g. after an auto-baud detection.
+// Change it while the USART neither receives nor transmits.
+// @param usartModule: USART module.
+// @param divider: Divider of USART_CalculateBaudRate, at least 16.
+//@ }
+void USART_SetBaudRateDivider(const USART_ModuleAddress usartModule, const uint16_t divider);
+
+//@ {
+// Enables or disables the receiver (RE) without changing the transmitter.
+//@ }
+void USART_EnableReceiver(const USART_ModuleAddress usartModule, const bool doEnable);
+
 //@ {
 // Enables or disables the specified USART peripheral.
 // @param timerModule: Select the USART peripheral.
@@ -153,6 +258,21 @@ void USART_Enable(const USART_ModuleAddress usartModule, const bool doEnable);
 //@}
 void USART_EnableInterrupt(const USART_ModuleAddress usartModule, const USART_Irq irq, const bool doEnable);
 
+//@{
+// Enables or disables the specified USART DMA requests.
+// @param usartModule: Select the USART peripheral.
+// @param dmaRequest: Specifies the USART DMA request sources to be enabled or disabled.
+// @param doEnable: true DMA request would be enabled
+//                  false DMA request would be disabled
+//@}
+void USART_EnableDmaRequest(const USART_ModuleAddress usartModule, const USART_DmaRequest dmaRequest, const bool doEnable);
+
+//@{
+// Returns the address of the data register (DR), the peripheral address of the DMA transfers.
+// @param usartModule: Select the USART peripheral.
+//@}
+uint32_t USART_GetDataRegisterAddress(const USART_ModuleAddress usartModule);
+
 //@ {
 // Transmits single data through the selected peripheral.
 // @param usartModule: Select the USART peripheral.
@@ -181,6 +301,62 @@ bool USART_IsTransmissionComplete(const USART_ModuleAddress usartModule);
 // Returns true if if a new byte can be send.
 //@ }
 bool USART_IsTransmitDataRegisterEmpty(const USART_ModuleAddress usartModule);
+
+//@ {
+// Returns true if an idle line was detected after received data.
+//@ }
+bool USART_IsIdleLineDetected(const USART_ModuleAddress usartModule);
+
+//@ {
+// Returns true if a parity, framing, noise or overrun error was detected since the last clear sequence (read of SR
+// followed by DR, e.g. USART_ClearIdleLine). With DMA receive the flags stay set until then.
+//@ }
+bool USART_IsReceiveErrorDetected(const USART_ModuleAddress usartModule);
+
+//@ {
+// Clears the idle line flag (read of SR followed by DR), with DMA receive the data register is already read by the DMA.
+//@ }
+void USART_ClearIdleLine(const USART_ModuleAddress usartModule);
+
+//@{
+// Enable the RS-485 half-duplex mode: the bus is released, the receiver enabled. Call it after USART_Init,
+// the driver enable GPIO must be configured as output.
+// @param usartModule: Select the USART peripheral.
+// @param pConfig: Pointer to a USART_Rs485Config structure, copied.
+//@}
+void USART_Rs485Init(const USART_ModuleAddress usartModule, const USART_Rs485Config* const pConfig);
+
+//@{
+// Drive the bus and enable the transmission complete interrupt, call it just before the transmission starts.
+// No effect if the RS-485 mode is not enabled.
+// @param usartModule: Select the USART peripheral.
+// @param size: Number of characters of the transmission.
+//@}
+void USART_Rs485BeginTransmit(const USART_ModuleAddress usartModule, const uint32_t size);
+
+//@{
+// Release the bus at the end of the transmission, call it first in the interrupt handler of the USART.
+// @param usartModule: Select the USART peripheral.
+// @return bool: true if the transmission completed
+//@}
+bool USART_Rs485HandleInterrupt(const USART_ModuleAddress usartModule);
+
+//@{
+// Returns true while a RS-485 transmission drives the bus.
+//@}
+bool USART_Rs485IsTransmitting(const USART_ModuleAddress usartModule);
+
+//@{
+// Copy the RS-485 statistics.
+// @param usartModule: Select the USART peripheral.
+// @param pStatistics: Pointer to the USART_Rs485Statistics structure to fill.
+//@}
+void USART_Rs485GetStatistics(const USART_ModuleAddress usartModule, USART_Rs485Statistics* const pStatistics);
+
+//@{
+// Reset the RS-485 statistics.
+//@}
+void USART_Rs485ResetStatistics(const USART_ModuleAddress usartModule);
 void USART2_IT(const USART_ModuleAddress usartModule);
 #ifdef __cplusplus
 }
@@ -0,0 +1,56 @@
+// (c) IMT - Information Management Technology AG, CH-9470 Buchs, www.imt.ch.
+// SW guideline: Technote Coding Guidelines Ver. 1.5.1
+
+#include "SystemRamCode.h"
+
+// Project includes
+#include "Core_CortexM3.h"
+#include "SystemStartupControl.h"
+#include "SystemMemoryCopy.h"
+#include "SystemMemoryMap.h"
+
+// Imt.Base includes
+#include <Imt.Base.Core.Diagnostics/Diagnostics.h>
+
+// Buffers of the copy benchmark, the content is irrelevant
+#pragma data_alignment = 4
+static STARTUP_NOINIT uint8_t ramCodeBenchmarkSource[RAMCODE_BENCHMARK_MAX_SIZE];
+#pragma data_alignment = 4
+static STARTUP_NOINIT uint8_t ramCodeBenchmarkDestination[RAMCODE_BENCHMARK_MAX_SIZE];
+
+//@{
+// Flash interface registers
+//@}
+typedef struct {
+    volatile uint32_t ACR;
+} RamCode_FlashRegisters;
+
+// Wait states of the flash access (ACR LATENCY) at 72 MHz
+#define RAMCODE_FLASH_LATENCY_MASK ((uint32_t)0x07)
+#define RAMCODE_FLASH_LATENCY_72MHZ ((uint32_t)0x02)
+
+void RamCode_MeasureCopy(const uint32_t size, RamCode_Benchmark* const pBenchmark) {
+    if ((pBenchmark == NULL) || (size > RAMCODE_BENCHMARK_MAX_SIZE)) {
+        ASSERT_DEBUG(false);
+        return;
+    }
+
+    // the wait states of 72 MHz: more wait states than the clock needs are allowed
+    RamCode_FlashRegisters* const pFlash = (RamCode_FlashRegisters*)FLASH_MEMORY_IFC_BASE; //lint !e923 cast from int to pointer [MISRA C++ Rule 5-2-7], [MISRA C++ Rule 5-2-8]. Justification: With this construct we reach more type safety
+    const uint32_t previousAcr = pFlash->ACR;
+    pFlash->ACR = (previousAcr & ~RAMCODE_FLASH_LATENCY_MASK) | RAMCODE_FLASH_LATENCY_72MHZ;
+
+    // the first calls load the prefetch buffer, measure the second call
+    uint32_t startCycles = 0U;
+    for (uint32_t run = 0U; run < 2U; ++run) {
+        startCycles = DWT->CYCCNT;
+        MemoryCopy_CopyInFlash(ramCodeBenchmarkDestination, ramCodeBenchmarkSource, size);
+        pBenchmark->FlashCycles = DWT->CYCCNT - startCycles;
+    }
+    for (uint32_t run = 0U; run < 2U; ++run) {
+        startCycles = DWT->CYCCNT;
+        MemoryCopy_Copy(ramCodeBenchmarkDestination, ramCodeBenchmarkSource, size);
+        pBenchmark->RamCycles = DWT->CYCCNT - startCycles;
+    }
+    pFlash->ACR = previousAcr;
+}
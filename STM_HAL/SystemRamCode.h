@@ -0,0 +1,66 @@
+// (c) IMT - Information Management Technology AG, CH-9470 Buchs, www.imt.ch.
+// SW guideline: Technote Coding Guidelines Ver. 1.5.1
+
+#ifndef SYSTEMRAMCODE_H
+#define SYSTEMRAMCODE_H
+
+// Must be very first include
+#include <Imt.Base.Core.Platform/Platform.h>
+
+// Determine if a C++ compiler is being used.  If so, ensure that standard C is used to process the API information.
+#ifdef __cplusplus
+extern "C" {
+#endif // __cplusplus
+
+//@{
+// RAM-resident execution of hot code.
+// Functions declared with SYSTEM_RAMFUNC are placed in the section .textrw, which the C++ runtime copies
+// from flash to the RAMCODE block in SRAM before main (@see LinkerConfig.icf).
+// Code in SRAM runs without flash wait states (2 at 72 MHz), but instruction and data fetches share the
+// System bus, so the benefit depends on the code: use RamCode_MeasureCopy to compare.
+// Candidates are short, frequently called functions: interrupt handlers, copy, CRC and ring buffer operations.
+// In SRAM: the interrupt handlers of the DMA link (@see UsartApp.cpp) with UsartLink_UpdateFlowControl, MemoryCopy_Copy,
+// EventQueue_Post and the word loop of the CRC.
+// Calls from SRAM to flash and back are long calls (veneers), keep the callees of RAM code in RAM or inline.
+//
+// The application runs at 8 MHz (HSI) with 0 flash wait states, where flash code is as fast as SRAM code.
+// RamCode_MeasureCopy sets the 2 wait states of 72 MHz during the measurement: the cycles are those at 72 MHz.
+//
+// Reference: ST_CortexM3_STM32F103_TRM_Rev15.pdf Chapter 3.3.3 Embedded Flash memory (read latency)
+//@}
+
+#if defined(__IAR_SYSTEMS_ICC__)
+// Place a function in SRAM (copied at startup)
+#define SYSTEM_RAMFUNC __ramfunc
+#else
+// Host build: no placement
+#define SYSTEM_RAMFUNC
+#endif // __IAR_SYSTEMS_ICC__
+
+//@{
+// Cycles per call of the same code executed from flash and from SRAM
+//@}
+typedef struct {
+    // Code executed from flash
+    uint32_t FlashCycles;
+
+    // Code executed from SRAM
+    uint32_t RamCycles;
+} RamCode_Benchmark;
+
+// Maximum size of RamCode_MeasureCopy in bytes
+#define RAMCODE_BENCHMARK_MAX_SIZE 256U
+
+//@{
+// Measure the cycles per call of MemoryCopy_Copy (SRAM) and MemoryCopy_CopyInFlash (flash) at 2 flash wait states.
+// Note: Requires the running DWT cycle counter (@see SystemStartupControl.h), call it with interrupts disabled for stable results.
+// @param size: Number of bytes copied per call, at most RAMCODE_BENCHMARK_MAX_SIZE.
+// @param pBenchmark: Pointer to the RamCode_Benchmark structure to fill.
+//@}
+void RamCode_MeasureCopy(const uint32_t size, RamCode_Benchmark* const pBenchmark);
+
+#ifdef __cplusplus
+}
+#endif // __cplusplus
+
+#endif // SYSTEMRAMCODE_H
@@ -0,0 +1,62 @@
+// (c) IMT - Information Management Technology AG, CH-9470 Buchs, www.imt.ch.
+// SW guideline: Technote Coding Guidelines Ver. 1.5.1
+
+#include "SystemStackMonitor.h"
+
+// Imt.Base includes
+#include <Imt.Base.Core.Diagnostics/Diagnostics.h>
+
+// IAR includes
+#include <intrinsics.h>
+
+// Linker blocks defined in LinkerConfig.icf
+#pragma section = "CSTACK"
+#pragma section = "ISR_STACK"
+
+//@{
+// Returns the number of bytes between the stack bottom and the deepest overwritten word.
+//@}
+static uint32_t StackMonitor_ScanHighWaterMark(const uint32_t* const pBottom, const uint32_t* const pTop) {
+    const uint32_t* pWord = pBottom;
+    while ((pWord < pTop) && (*pWord == STACKMONITOR_PAINT_PATTERN)) {
+        ++pWord;
+    }
+    return (uint32_t)(pTop - pWord) * sizeof(uint32_t);
+}
+
+void StackMonitor_GetUsage(const StackMonitor_Context context, StackMonitor_Usage* const pUsage) {
+    if (pUsage == NULL) {
+        ASSERT_DEBUG(false);
+        return;
+    }
+
+    const uint32_t* pBottom = NULL;
+    const uint32_t* pTop = NULL;
+    uint32_t stackPointer = 0U;
+    switch (context) {
+        case StackMonitor_Context_Main:
+            pBottom = (const uint32_t*)__section_begin("CSTACK");
+            pTop = (const uint32_t*)__section_end("CSTACK");
+            stackPointer = __get_PSP();
+            break;
+        case StackMonitor_Context_Interrupt:
+            pBottom = (const uint32_t*)__section_begin("ISR_STACK");
+            pTop = (const uint32_t*)__section_end("ISR_STACK");
+            stackPointer = __get_MSP();
+            break;
+        default:
+            ASSERT_DEBUG(false);
+            return;
+    }
+
+    pUsage->Size = (uint32_t)(pTop - pBottom) * sizeof(uint32_t);
+    pUsage->Used = (uint32_t)pTop - stackPointer;
+    pUsage->HighWaterMark = StackMonitor_ScanHighWaterMark(pBottom, pTop);
+    pUsage->Overflow = (*pBottom != STACKMONITOR_PAINT_PATTERN);
+}
+
+uint32_t StackMonitor_GetHighWaterMark(const StackMonitor_Context context) {
+    StackMonitor_Usage usage;
+    StackMonitor_GetUsage(context, &usage);
+    return usage.HighWaterMark;
+}
@@ -0,0 +1,77 @@
+// (c) IMT - Information Management Technology AG, CH-9470 Buchs, www.imt.ch.
+// SW guideline: Technote Coding Guidelines Ver. 1.5.1
+
+#ifndef SYSTEMSTACKMONITOR_H
+#define SYSTEMSTACKMONITOR_H
+
+// Must be very first include
+#include <Imt.Base.Core.Platform/Platform.h>
+
+// Determine if a C++ compiler is being used.  If so, ensure that standard C is used to process the API information.
+#ifdef __cplusplus
+extern "C" {
+#endif // __cplusplus
+
+//@{
+// Stack usage monitor.
+// The main context (thread mode) runs on the process stack pointer (PSP) in CSTACK,
+// all interrupts (handler mode) run on the main stack pointer (MSP) in ISR_STACK.
+// Both stacks are painted with STACKMONITOR_PAINT_PATTERN in SystemStartup.s before the C++ runtime starts.
+// The high-water mark is the deepest painted word which was overwritten since reset.
+// The exception frame of the first (not nested) interrupt is stacked on CSTACK,
+// so the ISR_STACK high-water mark is the worst-case interrupt nesting.
+// ISR_STACK is placed at the start of RAM below CSTACK (@see LinkerConfig.icf): its overflow leaves the RAM and
+// faults before the monitor could report it, it does not corrupt the main context.
+//
+// Reference: Cortex-M3 Devices Generic User Guide DUI0552A Chapter 2.1.2 Stacks
+//@}
+
+// Fill pattern of unused stack (0xCD is used by the C-SPY stack plugin as well)
+#define STACKMONITOR_PAINT_PATTERN ((uint32_t)0xCDCDCDCD)
+
+//@{
+// Enumeration of the monitored stacks
+//@}
+typedef enum {
+    // Main context in thread mode (CSTACK, PSP)
+    StackMonitor_Context_Main,
+    // Interrupt nesting in handler mode (ISR_STACK, MSP)
+    StackMonitor_Context_Interrupt
+} StackMonitor_Context;
+
+//@{
+// Stack usage of a context in bytes
+//@}
+typedef struct {
+    // Size of the stack
+    uint32_t Size;
+
+    // Bytes in use at the time of the call
+    uint32_t Used;
+
+    // Maximum bytes used since reset
+    uint32_t HighWaterMark;
+
+    // The lowest word of the stack was overwritten (stack overflow into the adjacent memory is likely)
+    bool Overflow;
+} StackMonitor_Usage;
+
+//@{
+// Determines the usage of the selected stack.
+// Note: The high-water mark scans the unused part of the stack, do not call it from time critical code.
+// @param context: Select the stack.
+// @param pUsage: Pointer to the StackMonitor_Usage structure to fill.
+//@}
+void StackMonitor_GetUsage(const StackMonitor_Context context, StackMonitor_Usage* const pUsage);
+
+//@{
+// Returns the maximum bytes used of the selected stack since reset.
+// @param context: Select the stack.
+//@}
+uint32_t StackMonitor_GetHighWaterMark(const StackMonitor_Context context);
+
+#ifdef __cplusplus
+}
+#endif // __cplusplus
+
+#endif // SYSTEMSTACKMONITOR_H
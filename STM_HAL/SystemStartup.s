@@ -9,6 +9,10 @@
 // After Reset the Cortex-M3 processor is in Thread mode, priority is Privileged.
 // This assembler module performs:
 // - Declare Reset_Handler (weak definition)
+// - Start the DWT cycle counter for the boot time measurement (@see SystemStartupControl.h)
+// - Paint CSTACK and ISR_STACK with the stack monitor pattern (@see SystemStackMonitor.h)
+// - Switch the thread mode to the process stack pointer (PSP) located in CSTACK
+// - Move the main stack pointer (MSP, used in handler mode) to ISR_STACK
 // - Set the initial PC == __iar_program_start
 //
 // __iar_program_start will do the following
@@ -20,10 +24,70 @@
 
         EXTERN  __iar_program_start
 
+        ;; Forward declaration of sections.
+        SECTION CSTACK:DATA:NOROOT(3)
+        SECTION ISR_STACK:DATA:NOROOT(3)
+
+; Fill pattern of unused stack, must match STACKMONITOR_PAINT_PATTERN
+STACK_PAINT_PATTERN     EQU     0xCDCDCDCD
+; CONTROL register: SPSEL selects the process stack pointer in thread mode
+CONTROL_SPSEL           EQU     0x02
+; Debug Exception and Monitor Control Register, TRCENA enables the DWT
+COREDEBUG_DEMCR         EQU     0xE000EDFC
+COREDEBUG_DEMCR_TRCENA  EQU     0x01000000
+; DWT control and cycle count register
+DWT_CTRL                EQU     0xE0001000
+DWT_CYCCNT              EQU     0xE0001004
+DWT_CTRL_CYCCNTENA      EQU     0x00000001
+
 THUMB
         PUBWEAK Reset_Handler
         SECTION .text:CODE:REORDER:NOROOT(2)
 Reset_Handler
+        ; Start the cycle counter at 0, the boot milestones are measured from here
+        LDR     R0, =COREDEBUG_DEMCR
+        LDR     R1, [R0]
+        ORR     R1, R1, #COREDEBUG_DEMCR_TRCENA
+        STR     R1, [R0]
+        LDR     R0, =DWT_CYCCNT
+        MOVS    R1, #0
+        STR     R1, [R0]
+        LDR     R0, =DWT_CTRL
+        LDR     R1, [R0]
+        ORR     R1, R1, #DWT_CTRL_CYCCNTENA
+        STR     R1, [R0]
+
+        ; Paint the interrupt stack
+        LDR     R0, =sfb(ISR_STACK)
+        LDR     R1, =sfe(ISR_STACK)
+        LDR     R2, =STACK_PAINT_PATTERN
+        BL      ?stackPaint
+
+        ; Paint the main stack, nothing has been pushed to it yet
+        LDR     R0, =sfb(CSTACK)
+        LDR     R1, =sfe(CSTACK)
+        BL      ?stackPaint
+
+        ; Thread mode (main context) continues on the process stack
+        MSR     PSP, R1
+        MOVS    R0, #CONTROL_SPSEL
+        MSR     CONTROL, R0
+        ISB
+
+        ; Handler mode (interrupt nesting) uses the main stack
+        LDR     R0, =sfe(ISR_STACK)
+        MSR     MSP, R0
+
         LDR     R0, =__iar_program_start
         BX      R0
-        END
\ No newline at end of file
+
+; Fill the memory [R0, R1) with the pattern in R2
+?stackPaint
+        CMP     R0, R1
+        BHS     ?stackPaintDone
+        STR     R2, [R0], #4
+        B       ?stackPaint
+?stackPaintDone
+        BX      LR
+
+        END
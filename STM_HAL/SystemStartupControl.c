@@ -0,0 +1,62 @@
+// (c) IMT - Information Management Technology AG, CH-9470 Buchs, www.imt.ch.
+// SW guideline: Technote Coding Guidelines Ver. 1.5.1
+
+#include "SystemStartupControl.h"
+
+// Project includes
+#include "Core_CortexM3.h"
+
+// Imt.Base includes
+#include <Imt.Base.Core.Diagnostics/Diagnostics.h>
+
+// C-Lib includes
+#include <string.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif // __cplusplus
+// Hook of the IAR C++ runtime, called before the RAM sections are initialized
+int __low_level_init(void);
+#ifdef __cplusplus
+}
+#endif // __cplusplus
+
+// Cycle counter per milestone, written before the RAM sections are initialized and therefore in .noinit
+static STARTUP_NOINIT uint32_t startupMilestoneCycles[Startup_Milestone_Count];
+
+int __low_level_init(void) {
+    for (uint32_t i = 0U; i < (uint32_t)Startup_Milestone_Count; ++i) {
+        startupMilestoneCycles[i] = 0U;
+    }
+    Startup_MarkMilestone(Startup_Milestone_LowLevelInit);
+
+    // 1: initialize the RAM sections as defined in LinkerConfig.icf
+    return 1;
+}
+
+void Startup_InitLazyBuffer(Startup_LazyBuffer* const pBuffer) {
+    if (pBuffer == NULL) {
+        ASSERT_DEBUG(false);
+        return;
+    }
+    (void)memset(pBuffer->pData, pBuffer->FillValue, pBuffer->Size);
+    pBuffer->Initialized = true;
+}
+
+void Startup_MarkMilestone(const Startup_Milestone milestone) {
+    if (milestone >= Startup_Milestone_Count) {
+        ASSERT_DEBUG(false);
+        return;
+    }
+    if (startupMilestoneCycles[milestone] == 0U) {
+        startupMilestoneCycles[milestone] = DWT->CYCCNT;
+    }
+}
+
+uint32_t Startup_GetMilestoneCycles(const Startup_Milestone milestone) {
+    if (milestone >= Startup_Milestone_Count) {
+        ASSERT_DEBUG(false);
+        return 0U;
+    }
+    return startupMilestoneCycles[milestone];
+}
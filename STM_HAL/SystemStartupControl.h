@@ -0,0 +1,111 @@
+// (c) IMT - Information Management Technology AG, CH-9470 Buchs, www.imt.ch.
+// SW guideline: Technote Coding Guidelines Ver. 1.5.1
+
+#ifndef SYSTEMSTARTUPCONTROL_H
+#define SYSTEMSTARTUPCONTROL_H
+
+// Must be very first include
+#include <Imt.Base.Core.Platform/Platform.h>
+
+// Determine if a C++ compiler is being used.  If so, ensure that standard C is used to process the API information.
+#ifdef __cplusplus
+extern "C" {
+#endif // __cplusplus
+
+//@{
+// Startup control and boot time measurement.
+// The C++ runtime (__iar_program_start) initializes the RAM per section as defined in LinkerConfig.icf:
+// - .data    (initialized variables): copied from flash
+// - .bss     (zero initialized variables): zeroed
+// - .noinit  (STARTUP_NOINIT variables): not touched, the content is undefined after reset
+// Large buffers (DMA, ring buffers) are placed in .noinit to shorten the time from reset to main.
+// A buffer which needs a defined content is declared with STARTUP_LAZY_BUFFER and initialized on first use.
+//
+// The boot time is measured with the DWT cycle counter, which is started first thing in Reset_Handler.
+//@}
+
+#if defined(__IAR_SYSTEMS_ICC__)
+// Place a variable in the .noinit section (neither copied nor zeroed by the startup code)
+#define STARTUP_NOINIT __no_init
+#else
+// Host build: no placement
+#define STARTUP_NOINIT
+#endif // __IAR_SYSTEMS_ICC__
+
+//@{
+// Lazy initialized buffer in the .noinit section.
+// The descriptor itself is small initialized data, so Initialized is false after every reset.
+//@}
+typedef struct {
+    // Buffer in the .noinit section
+    void* pData;
+
+    // Size of the buffer in bytes
+    uint32_t Size;
+
+    // Value written to every byte on first use
+    uint8_t FillValue;
+
+    // The buffer was initialized since reset
+    bool Initialized;
+} Startup_LazyBuffer;
+
+//@{
+// Define a .noinit buffer of count elements named name##Data and its lazy init descriptor name.
+// Usage: STARTUP_LAZY_BUFFER(txBuffer, uint8_t, 512, 0x00);
+//        uint8_t* pTx = (uint8_t*)Startup_GetLazyBuffer(&txBuffer);
+//@}
+#define STARTUP_LAZY_BUFFER(name, type, count, fillValue) \
+    static STARTUP_NOINIT type name##Data[count]; \
+    static Startup_LazyBuffer name = { name##Data, (uint32_t)sizeof(name##Data), (uint8_t)(fillValue), false }
+
+//@{
+// Fill the buffer with its fill value and mark it initialized.
+// @param pBuffer: Lazy buffer descriptor.
+//@}
+void Startup_InitLazyBuffer(Startup_LazyBuffer* const pBuffer);
+
+//@{
+// Returns the buffer data, initialized on the first call since reset.
+// Note: The first call must not be interrupted by another user of the same buffer,
+//       call it once from the owning module before its interrupt is enabled.
+// @param pBuffer: Lazy buffer descriptor.
+//@}
+static inline void* Startup_GetLazyBuffer(Startup_LazyBuffer* const pBuffer) {
+    if (!pBuffer->Initialized) {
+        Startup_InitLazyBuffer(pBuffer);
+    }
+    return pBuffer->pData;
+}
+
+//@{
+// Enumeration of the boot milestones, in order of occurrence
+//@}
+typedef enum {
+    // __low_level_init: called by the C++ runtime before the RAM sections are initialized
+    Startup_Milestone_LowLevelInit,
+    // Entry of main: RAM sections and static constructors are initialized
+    Startup_Milestone_Main,
+    // The first interrupt is enabled in the NVIC
+    Startup_Milestone_InterruptsEnabled,
+    Startup_Milestone_Count
+} Startup_Milestone;
+
+//@{
+// Record the cycle counter for a milestone, only the first call per milestone is stored.
+// @param milestone: Reached milestone.
+//@}
+void Startup_MarkMilestone(const Startup_Milestone milestone);
+
+//@{
+// Returns the CPU cycles from reset to the milestone, 0 if the milestone was not reached yet.
+// Note: The cycles before and after the clock configuration in main have different lengths, there is no conversion to a time.
+// @param milestone: Select the milestone.
+//@}
+uint32_t Startup_GetMilestoneCycles(const Startup_Milestone milestone);
+
+#ifdef __cplusplus
+}
+#endif // __cplusplus
+
+#endif // SYSTEMSTARTUPCONTROL_H
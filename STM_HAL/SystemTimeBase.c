@@ -0,0 +1,67 @@
+// (c) IMT - Information Management Technology AG, CH-9470 Buchs, www.imt.ch.
+// SW guideline: Technote Coding Guidelines Ver. 1.5.1
+
+#include "SystemTimeBase.h"
+
+// Project includes
+#include "SystemMemoryMap.h"
+#include "SystemPeripherals_TIM.h"
+
+//@{
+// Master (low half) and slave (high half) timer
+//@}
+#define TIMEBASE_LOW_TIMER      TIM_ModuleAddress_TIM3
+#define TIMEBASE_HIGH_TIMER     TIM_ModuleAddress_TIM4
+// Trigger input of TIM4 connected to the TRGO of TIM3
+#define TIMEBASE_HIGH_TRIGGER   TIM_InputTrigger_ITR2
+
+//@{
+// Counter registers (TIMx_CNT), read directly: the read is on the path of every timestamp
+//@}
+//lint -emacro(923, TIMEBASE_LOW_COUNTER, TIMEBASE_HIGH_COUNTER) cast from int to pointer [MISRA C++ Rule 5-2-7], [MISRA C++ Rule 5-2-8]. Justification: register address
+#define TIMEBASE_LOW_COUNTER    (*(const volatile uint16_t*)(TIM3_BASE + 0x24U))
+#define TIMEBASE_HIGH_COUNTER   (*(const volatile uint16_t*)(TIM4_BASE + 0x24U))
+
+void TimeBase_Init(void) {
+    TIM_Enable(TIMEBASE_LOW_TIMER, false);
+    TIM_Enable(TIMEBASE_HIGH_TIMER, false);
+
+    // Master: microseconds, full 16-bit period. Initialized while the slave is stopped, the update
+    // generated by TIM_TimeBaseInit is not counted.
+    TIM_TimeBaseInitStruct timeBase;
+    timeBase.Prescaler = (uint16_t)((TIM_GetInputClockFrequency(TIMEBASE_LOW_TIMER) / TIMEBASE_TICK_FREQUENCY) - 1U);
+    timeBase.CounterMode = TIM_CounterModeUp;
+    timeBase.Period = 0xFFFFU;
+    TIM_TimeBaseInit(TIMEBASE_LOW_TIMER, &timeBase);
+    TIM_SetMasterMode(TIMEBASE_LOW_TIMER, TIM_MasterMode_Update);
+
+    // Slave: counts the master overflows
+    timeBase.Prescaler = 0U;
+    TIM_TimeBaseInit(TIMEBASE_HIGH_TIMER, &timeBase);
+    TIM_SetSlaveMode(TIMEBASE_HIGH_TIMER, TIMEBASE_HIGH_TRIGGER, TIM_SlaveMode_ExternalClock);
+
+    TIM_Enable(TIMEBASE_HIGH_TIMER, true);
+    TIM_Enable(TIMEBASE_LOW_TIMER, true);
+}
+
+uint32_t TimeBase_GetMicroseconds(void) {
+    uint16_t high;
+    uint16_t low;
+    uint16_t highAgain;
+    do {
+        high = TIMEBASE_HIGH_COUNTER;
+        low = TIMEBASE_LOW_COUNTER;
+        highAgain = TIMEBASE_HIGH_COUNTER;
+    } while ((high != highAgain) || (low == 0U));
+    return ((uint32_t)high << 16U) | low;
+}
+
+uint32_t TimeBase_GetElapsedMicroseconds(const uint32_t startMicroseconds) {
+    return TimeBase_GetMicroseconds() - startMicroseconds;
+}
+
+void TimeBase_DelayMicroseconds(const uint32_t microseconds) {
+    const uint32_t startMicroseconds = TimeBase_GetMicroseconds();
+    while (TimeBase_GetElapsedMicroseconds(startMicroseconds) < microseconds) {
+    }
+}
@@ -0,0 +1,58 @@
+// (c) IMT - Information Management Technology AG, CH-9470 Buchs, www.imt.ch.
+// SW guideline: Technote Coding Guidelines Ver. 1.5.1
+
+#ifndef SYSTEMTIMEBASE_H
+#define SYSTEMTIMEBASE_H
+
+// Must be very first include
+#include <Imt.Base.Core.Platform/Platform.h>
+
+// Determine if a C++ compiler is being used.  If so, ensure that standard C is used to process the API information.
+#ifdef __cplusplus
+extern "C" {
+#endif // __cplusplus
+
+//@{
+// Free-running 32-bit microsecond time base of two chained 16-bit timers, without interrupts.
+// TIM3 (master) counts microseconds and outputs its update event as trigger (TRGO), TIM4 (slave, external clock
+// mode with the trigger input ITR2 = TIM3) counts the overflows of TIM3. So TIM4:TIM3 is a 32-bit counter which
+// wraps after 71.6 minutes; use differences of timestamps (TimeBase_GetElapsedMicroseconds).
+// The read is consistent from any context without locking: the high half is read before and after the low half
+// and the read is repeated if the high half changed or the low half just wrapped (the slave counts some timer
+// clocks after the master overflow, within the first microsecond).
+// TIM3 captures can be extended with this time base (@see SystemInputCapture.h), TIM2 drives the LED (@see TimerApp.h).
+// The clocks of TIM3 and TIM4 must be enabled by the application.
+//
+// Reference: ST_CortexM3_STM32F103_TRM_Rev15.pdf Chapter 15.3.15 Timer synchronization
+//@}
+
+// Counter frequency of the time base
+#define TIMEBASE_TICK_FREQUENCY 1000000U
+
+//@{
+// Configure and start the chained timers, the time starts at 0.
+//@}
+void TimeBase_Init(void);
+
+//@{
+// Returns the microseconds since TimeBase_Init (modulo 2^32), callable from any context.
+//@}
+uint32_t TimeBase_GetMicroseconds(void);
+
+//@{
+// Returns the microseconds elapsed since a timestamp, correct over the wrap of the counter.
+// @param startMicroseconds: Timestamp of TimeBase_GetMicroseconds.
+//@}
+uint32_t TimeBase_GetElapsedMicroseconds(const uint32_t startMicroseconds);
+
+//@{
+// Busy wait.
+// @param microseconds: Time to wait, less than 2^31.
+//@}
+void TimeBase_DelayMicroseconds(const uint32_t microseconds);
+
+#ifdef __cplusplus
+}
+#endif // __cplusplus
+
+#endif // SYSTEMTIMEBASE_H
@@ -0,0 +1,262 @@
+// (c) IMT - Information Management Technology AG, CH-9470 Buchs, www.imt.ch.
+// SW guideline: Technote Coding Guidelines Ver. 1.5.1
+
+#include "SystemUsartLink.h"
+
+// Project includes
+#include "SystemRamCode.h"
+
+//@{
+// Configure a DMA channel between the data register of the USART and a buffer.
+//@}
+static void UsartLink_InitDma(const USART_ModuleAddress usart, const DMA_ChannelAddress dmaChannel, const DMA_DatatTransferDir direction,
+                              uint8_t* const pBuffer, const uint32_t size, const DMA_Mode mode) {
+    DMA_InitStruct dmaInit;
+    dmaInit.PeripheralBaseAddr = USART_GetDataRegisterAddress(usart);
+    dmaInit.MemoryBaseAddr = (uint32_t)pBuffer; //lint !e923 cast from pointer to int [MISRA C++ Rule 5-2-9]. Justification: DMA address register
+    dmaInit.DIR = direction;
+    dmaInit.BufferSize = size;
+    dmaInit.PeripheralInc = DMA_PeripheralInc_Disable;
+    dmaInit.MemoryInc = DMA_MemoryInc_Enable;
+    dmaInit.PeripheralDataSize = DMA_PeripheralDataSize_Byte;
+    dmaInit.MemoryDataSize = DMA_MemoryDataSize_Byte;
+    dmaInit.Mode = mode;
+    dmaInit.Priority = DMA_Priority_Medium;
+    dmaInit.M2M = DMA_M2M_Disable;
+    DMA_Enable(dmaChannel, false);
+    DMA_Init(dmaChannel, &dmaInit);
+}
+
+void UsartLink_Init(UsartLink_State* const pState, const UsartLink_Config* const pConfig) {
+    if ((pState == NULL) || (pConfig == NULL) || (pConfig->pRxBuffer == NULL) || (pConfig->pTxBuffer == NULL)) {
+        ASSERT_DEBUG(false);
+        return;
+    }
+    pState->pRxBuffer = pConfig->pRxBuffer;
+    pState->RxBufferSize = pConfig->RxBufferSize;
+    pState->pTxBuffer = pConfig->pTxBuffer;
+    pState->TxBufferSize = pConfig->TxBufferSize;
+    pState->Notification = pConfig->Notification;
+    UsartLink_ResetStatistics(pState);
+
+    Atomic_Store32(&pState->RxHalfPasses, 0U);
+    pState->RxReadCount = 0U;
+    pState->RxIsFlowControlled = false;
+    pState->RxHeldSize = 0U;
+    pState->RxIsPaused = false;
+    UsartLink_InitDma(pConfig->Usart, pConfig->RxDma, DMA_DIR_PeripheralSRC, pConfig->pRxBuffer, pConfig->RxBufferSize, DMA_Mode_Circular);
+    DMA_EnableInterrupt(pConfig->RxDma, (DMA_Irq)(DMA_Irq_HalfTransferComplete | DMA_Irq_TransferComplete), true);
+    DMA_Enable(pConfig->RxDma, true);
+
+    pState->TxRead = 0U;
+    pState->TxWrite = 0U;
+    pState->TxWrapEnd = 0U;
+    pState->TxIsWrapped = false;
+    pState->TxDmaSize = 0U;
+    pState->TxReservedSize = 0U;
+    pState->TxIsReservationWrapped = false;
+    UsartLink_InitDma(pConfig->Usart, pConfig->TxDma, DMA_DIR_PeripheralDST, pConfig->pTxBuffer, 0U, DMA_Mode_Normal);
+    DMA_EnableInterrupt(pConfig->TxDma, DMA_Irq_TransferComplete, true);
+
+    USART_EnableInterrupt(pConfig->Usart, USART_Irq_CR1_RXNE, false);
+    USART_EnableDmaRequest(pConfig->Usart, (USART_DmaRequest)(USART_DmaRequest_Rx | USART_DmaRequest_Tx), true);
+    USART_ClearIdleLine(pConfig->Usart);
+    USART_EnableInterrupt(pConfig->Usart, USART_Irq_CR1_IDLE, true);
+}
+
+bool UsartLink_PassReceived(UsartLink_State* const pState, const uint32_t writeCount, const UsartLink_ReceiveHandler handler,
+                            void* const pContext, const uint32_t heldSize) {
+    if (handler == NULL) {
+        ASSERT_DEBUG(false);
+        return false;
+    }
+    const uint32_t ringSize = pState->RxBufferSize;
+    const uint32_t pendingSize = writeCount - pState->RxReadCount;
+    if ((pendingSize + heldSize) > ringSize) {
+        pState->RxReadCount = writeCount;
+        ++pState->Statistics.RxOverruns;
+        return false;
+    }
+
+    const uint32_t readIndex = pState->RxReadCount % ringSize;
+    const uint32_t firstSize = ((readIndex + pendingSize) > ringSize) ? (ringSize - readIndex) : pendingSize;
+    if (firstSize != 0U) {
+        handler(pContext, &pState->pRxBuffer[readIndex], firstSize);
+    }
+    if (pendingSize != firstSize) {
+        handler(pContext, pState->pRxBuffer, pendingSize - firstSize);
+    }
+    pState->RxReadCount = writeCount;
+    pState->Statistics.RxBytes += pendingSize;
+    return true;
+}
+
+void UsartLink_EnableFlowControl(UsartLink_State* const pState, const UsartLink_FlowControl* const pFlowControl) {
+    if ((pFlowControl == NULL) || (pFlowControl->HighWatermark >= (pState->RxBufferSize / 2U)) ||
+        (pFlowControl->LowWatermark >= pFlowControl->HighWatermark)) {
+        ASSERT_DEBUG(false);
+        return;
+    }
+    pState->RxFlowControl = *pFlowControl;
+    pState->RxIsPaused = false;
+    pState->RxIsFlowControlled = true;
+    // low: ready to receive
+    GPIO_ResetBits(pFlowControl->RtsGpio, pFlowControl->RtsPin);
+}
+
+SYSTEM_RAMFUNC void UsartLink_UpdateFlowControl(UsartLink_State* const pState, const uint32_t writeCount) {
+    if (!pState->RxIsFlowControlled) {
+        return;
+    }
+    const uint32_t fill = (writeCount - pState->RxReadCount) + pState->RxHeldSize;
+    if (fill > pState->Statistics.RxHighWaterMark) {
+        pState->Statistics.RxHighWaterMark = fill;
+    }
+    if (!pState->RxIsPaused) {
+        if (fill >= pState->RxFlowControl.HighWatermark) {
+            GPIO_SetBits(pState->RxFlowControl.RtsGpio, pState->RxFlowControl.RtsPin);
+            pState->RxIsPaused = true;
+            ++pState->Statistics.RxPauses;
+        }
+    }
+    else if (fill <= pState->RxFlowControl.LowWatermark) {
+        GPIO_ResetBits(pState->RxFlowControl.RtsGpio, pState->RxFlowControl.RtsPin);
+        pState->RxIsPaused = false;
+    }
+    else {
+        // between the watermarks: RTS unchanged
+    }
+}
+
+//@{
+// Returns true if the transmit ring holds no data, neither queued nor in transfer.
+//@}
+static bool UsartLink_IsTxEmpty(const UsartLink_State* const pState) {
+    return !pState->TxIsWrapped && (pState->TxRead == pState->TxWrite) && (pState->TxDmaSize == 0U);
+}
+
+//@{
+// Restart an empty transmit ring at the beginning, the largest contiguous region. Called at the ceiling.
+//@}
+static void UsartLink_RestartIfEmpty(UsartLink_State* const pState) {
+    if (UsartLink_IsTxEmpty(pState)) {
+        pState->TxRead = 0U;
+        pState->TxWrite = 0U;
+    }
+}
+
+//@{
+// Returns the start of a free contiguous region of size bytes, NULL if the ring is too full. Called at the ceiling.
+// An empty ring is evaluated as restarted (@see UsartLink_RestartIfEmpty), the state is not changed.
+// @param pIsWrapped: Set if the region starts at the beginning of a not wrapped ring.
+//@}
+static uint8_t* UsartLink_FindRegion(const UsartLink_State* const pState, const uint32_t size, bool* const pIsWrapped) {
+    uint8_t* pRegion = NULL;
+    *pIsWrapped = false;
+    if (!pState->TxIsWrapped) {
+        const uint32_t write = UsartLink_IsTxEmpty(pState) ? 0U : pState->TxWrite;
+        if ((pState->TxBufferSize - write) >= size) {
+            pRegion = &pState->pTxBuffer[write];
+        }
+        else if (pState->TxRead > size) {
+            // wrap: the region ends before read, write stays behind read
+            pRegion = pState->pTxBuffer;
+            *pIsWrapped = true;
+        }
+        else {
+            // too full
+        }
+    }
+    else if ((pState->TxRead - pState->TxWrite) > size) {
+        pRegion = &pState->pTxBuffer[pState->TxWrite];
+    }
+    else {
+        // too full
+    }
+    return pRegion;
+}
+
+uint8_t* UsartLink_ReserveRegion(UsartLink_State* const pState, const uint32_t size) {
+    if ((size == 0U) || (size >= pState->TxBufferSize)) {
+        ASSERT_DEBUG(false);
+        return NULL;
+    }
+    const uint32_t previousBasePriority = CriticalSection_Enter(USARTLINK_CEILING);
+    UsartLink_RestartIfEmpty(pState);
+    uint8_t* const pRegion = UsartLink_FindRegion(pState, size, &pState->TxIsReservationWrapped);
+    CriticalSection_Exit(previousBasePriority);
+
+    if (pRegion == NULL) {
+        ++pState->Statistics.TxRejected;
+        pState->TxReservedSize = 0U;
+    }
+    else {
+        pState->TxReservedSize = size;
+    }
+    return pRegion;
+}
+
+bool UsartLink_CanReserveRegion(const UsartLink_State* const pState, const uint32_t size) {
+    if ((size == 0U) || (size >= pState->TxBufferSize)) {
+        ASSERT_DEBUG(false);
+        return false;
+    }
+    bool isWrapped = false;
+    const uint32_t previousBasePriority = CriticalSection_Enter(USARTLINK_CEILING);
+    const bool isFree = UsartLink_FindRegion(pState, size, &isWrapped) != NULL;
+    CriticalSection_Exit(previousBasePriority);
+    return isFree;
+}
+
+bool UsartLink_QueueRegion(UsartLink_State* const pState, const uint32_t size) {
+    if (size > pState->TxReservedSize) {
+        ASSERT_DEBUG(false);
+        return false;
+    }
+    pState->TxReservedSize = 0U;
+    if (size == 0U) {
+        return false;
+    }
+    if (pState->TxIsReservationWrapped) {
+        pState->TxWrapEnd = pState->TxWrite;
+        pState->TxIsWrapped = true;
+        pState->TxWrite = size;
+    }
+    else {
+        pState->TxWrite += size;
+    }
+    const uint32_t queuedSize = pState->TxIsWrapped ? ((pState->TxWrapEnd - pState->TxRead) + pState->TxWrite) : (pState->TxWrite - pState->TxRead);
+    pState->Statistics.TxBytes += size;
+    if (queuedSize > pState->Statistics.TxHighWaterMark) {
+        pState->Statistics.TxHighWaterMark = queuedSize;
+    }
+    return true;
+}
+
+uint8_t* UsartLink_TakeRegion(UsartLink_State* const pState, uint32_t* const pSize) {
+    *pSize = 0U;
+    if (pState->TxDmaSize != 0U) {
+        return NULL;
+    }
+    if (pState->TxIsWrapped && (pState->TxRead == pState->TxWrapEnd)) {
+        pState->TxRead = 0U;
+        pState->TxIsWrapped = false;
+    }
+    const uint32_t size = (pState->TxIsWrapped ? pState->TxWrapEnd : pState->TxWrite) - pState->TxRead;
+    if (size == 0U) {
+        return NULL;
+    }
+    pState->TxDmaSize = size;
+    *pSize = size;
+    return &pState->pTxBuffer[pState->TxRead];
+}
+
+void UsartLink_ResetStatistics(UsartLink_State* const pState) {
+    pState->Statistics.RxBytes = 0U;
+    pState->Statistics.RxOverruns = 0U;
+    pState->Statistics.TxBytes = 0U;
+    pState->Statistics.TxRejected = 0U;
+    pState->Statistics.TxHighWaterMark = 0U;
+    pState->Statistics.RxPauses = 0U;
+    pState->Statistics.RxHighWaterMark = 0U;
+}
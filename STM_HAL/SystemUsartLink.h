@@ -0,0 +1,601 @@
+// (c) IMT - Information Management Technology AG, CH-9470 Buchs, www.imt.ch.
+// SW guideline: Technote Coding Guidelines Ver. 1.5.1
+
+#ifndef SYSTEMUSARTLINK_H
+#define SYSTEMUSARTLINK_H
+
+// Must be very first include
+#include <Imt.Base.Core.Platform/Platform.h>
+
+// Project includes
+#include "SystemPeripherals_USART.h"
+#include "SystemPeripherals_DMA.h"
+#include "SystemPeripherals_GPIO.h"
+#include "SystemPeripherals_RCC.h"
+#include "SystemStartupControl.h"
+#include "SystemMemoryCopy.h"
+#include "Core_CortexM3.h"
+#include "Core_Atomic.h"
+
+// Imt.Base includes
+#include <Imt.Base.Core.Diagnostics/Diagnostics.h>
+
+// Determine if a C++ compiler is being used.  If so, ensure that standard C is used to process the API information.
+#ifdef __cplusplus
+extern "C" {
+#endif // __cplusplus
+
+//@{
+// Byte stream over a USART with DMA in both directions, no CPU work per byte. One link per USART (USART1..3), each with
+// its own rings, DMA channels, state and statistics (@see UsartLink).
+// - Receive: the receive DMA channel writes into a circular ring. The half and full ring interrupts of the channel and
+//   the idle line interrupt of the USART call the notification, receive passes the received bytes as at most two chunks
+//   (the wrap of the ring) to a handler. The chunk memory is writable: a decoder may decode in place (@see SystemFraming.h)
+//   and hold the bytes of an incomplete frame in the ring; a ring lapped over unread or held bytes is an overrun.
+// - Transmit: the transmit DMA channel sends from a ring of contiguous regions. reserveTransmit returns a contiguous
+//   region, the producer writes into it (e.g. Framing_Encode) and queues it with commitTransmit. The transfer complete
+//   interrupt starts the next region.
+// - Flow control (optional, @see enableFlowControl): RTS is a GPIO output driven by the fill of the receive ring, the
+//   hardware RTS of the USART only follows its data register which the DMA empties at once. RTS is deasserted (high) at
+//   the high watermark and asserted (low) again at the low watermark. The fill is checked by the half ring and idle line
+//   interrupts and by receive, so the high watermark plus half the ring plus the bytes the sender sends after RTS
+//   (its FIFO) must fit into the ring. CTS is the hardware flow control of the USART (USART_HardwareFlowControl_CTS):
+//   while the sender deasserts it, the USART holds the next byte and the transmit DMA waits without losing bytes.
+//
+// The ring logic is shared by all links (UsartLink_State functions), the register accesses are instantiated per USART
+// with the addresses and flags as constants. The USART must be initialized and the clock of DMA1 enabled by the
+// application. The interrupts of the port (@see USARTLINK_INTERRUPTS) must be enabled in the NVIC, their handlers call
+// the interrupt functions of the link. Receive and transmit are used from one execution level each (e.g. main loop).
+//@}
+
+// Ceiling of the state shared with the DMA interrupts of a link (@see INTERRUPTPLAN_CHECK_CEILING)
+#define USARTLINK_CEILING 4U
+
+//@{
+// Interrupts of a port: INTERRUPT(argument, interrupt, handler, link function) for the USART, the receive and the
+// transmit DMA channel (@see ST_CortexM3_STM32F103_TRM_Rev15.pdf Chapter 13.3.7 DMA request mapping).
+// The port is USART1, USART2 or USART3, or a macro expanding to it. The argument is passed unchanged, e.g. the entry
+// macro of an interrupt plan.
+//@}
+#define USARTLINK_INTERRUPTS(port, INTERRUPT, argument) USARTLINK_INTERRUPTS_OF(port, INTERRUPT, argument)
+#define USARTLINK_INTERRUPTS_OF(port, INTERRUPT, argument) USARTLINK_INTERRUPTS_##port(INTERRUPT, argument)
+#define USARTLINK_INTERRUPTS_USART1(INTERRUPT, argument)                          \
+    INTERRUPT(argument, USART1_IRQn, USART1_IRQHandler, handleUsartInterrupt)      \
+    INTERRUPT(argument, DMA1_Channel5_IRQn, DMA1_Channel5_IRQHandler, handleRxDmaInterrupt) \
+    INTERRUPT(argument, DMA1_Channel4_IRQn, DMA1_Channel4_IRQHandler, handleTxDmaInterrupt)
+#define USARTLINK_INTERRUPTS_USART2(INTERRUPT, argument)                          \
+    INTERRUPT(argument, USART2_IRQn, USART2_IRQHandler, handleUsartInterrupt)      \
+    INTERRUPT(argument, DMA1_Channel6_IRQn, DMA1_Channel6_IRQHandler, handleRxDmaInterrupt) \
+    INTERRUPT(argument, DMA1_Channel7_IRQn, DMA1_Channel7_IRQHandler, handleTxDmaInterrupt)
+#define USARTLINK_INTERRUPTS_USART3(INTERRUPT, argument)                          \
+    INTERRUPT(argument, USART3_IRQn, USART3_IRQHandler, handleUsartInterrupt)      \
+    INTERRUPT(argument, DMA1_Channel3_IRQn, DMA1_Channel3_IRQHandler, handleRxDmaInterrupt) \
+    INTERRUPT(argument, DMA1_Channel2_IRQn, DMA1_Channel2_IRQHandler, handleTxDmaInterrupt)
+
+//@{
+// EXTI vector of the Rx pin of a port, e.g. for an auto-baud detection (@see SystemAutoBaud.h): INTERRUPT(argument,
+// interrupt, handler). The handlers are defined by the EXTI dispatcher (@see SystemExtiDispatcher.h). USART1 (PA10) and
+// USART3 (PB11) share EXTI15_10 with the other lines 10..15.
+//@}
+#define USARTLINK_RX_EDGE_INTERRUPT(port, INTERRUPT, argument) USARTLINK_RX_EDGE_INTERRUPT_OF(port, INTERRUPT, argument)
+#define USARTLINK_RX_EDGE_INTERRUPT_OF(port, INTERRUPT, argument) USARTLINK_RX_EDGE_INTERRUPT_##port(INTERRUPT, argument)
+#define USARTLINK_RX_EDGE_INTERRUPT_USART1(INTERRUPT, argument) INTERRUPT(argument, EXTI15_10_IRQn, EXTI15_10_IRQHandler)
+#define USARTLINK_RX_EDGE_INTERRUPT_USART2(INTERRUPT, argument) INTERRUPT(argument, EXTI3_IRQn, EXTI3_IRQHandler)
+#define USARTLINK_RX_EDGE_INTERRUPT_USART3(INTERRUPT, argument) INTERRUPT(argument, EXTI15_10_IRQn, EXTI15_10_IRQHandler)
+
+//@{
+// USART module of a port (USART1, USART2, USART3 or a macro expanding to it)
+//@}
+#define USARTLINK_MODULE(port) USARTLINK_MODULE_OF(port)
+#define USARTLINK_MODULE_OF(port) USART_ModuleAddress_##port
+
+//@{
+// Link statistics since the last reset
+//@}
+typedef struct {
+    // Bytes passed to the receive handler
+    uint32_t RxBytes;
+
+    // Receive ring lapped over unread or held bytes, the unread bytes are dropped
+    uint32_t RxOverruns;
+
+    // Bytes committed for transmission
+    uint32_t TxBytes;
+
+    // Regions which could not be reserved, the ring was too full
+    uint32_t TxRejected;
+
+    // Maximum number of bytes queued in the transmit ring
+    uint32_t TxHighWaterMark;
+
+    // RTS deasserted at the high watermark of the receive ring
+    uint32_t RxPauses;
+
+    // Maximum fill of the receive ring (pending and held bytes) seen by the flow control
+    uint32_t RxHighWaterMark;
+} UsartLink_Statistics;
+
+//@{
+// Called from the interrupt context when received bytes are pending.
+//@}
+typedef void (*UsartLink_Notification)(void);
+
+//@{
+// Called by receive for each chunk of received bytes.
+// @param pContext: Context passed to receive.
+// @param pChunk: Received bytes in the receive ring, the handler may overwrite them.
+// @param size: Number of bytes, at least 1.
+//@}
+typedef void (*UsartLink_ReceiveHandler)(void* pContext, uint8_t* const pChunk, const uint32_t size);
+
+//@{
+// Link configuration
+//@}
+typedef struct {
+    // USART and its DMA channels
+    USART_ModuleAddress Usart;
+    DMA_ChannelAddress RxDma;
+    DMA_ChannelAddress TxDma;
+
+    // Receive ring, the size is even
+    uint8_t* pRxBuffer;
+    uint32_t RxBufferSize;
+
+    // Transmit ring
+    uint8_t* pTxBuffer;
+    uint32_t TxBufferSize;
+
+    // Called when received bytes are pending, NULL for polling
+    UsartLink_Notification Notification;
+} UsartLink_Config;
+
+//@{
+// Flow control configuration of the receive ring
+//@}
+typedef struct {
+    // RTS pin, an output driven by the link
+    GPIO_ModuleAddress RtsGpio;
+    uint16_t RtsPin;
+
+    // Fill of the receive ring (pending and held bytes) which deasserts RTS, below half the ring size
+    uint32_t HighWatermark;
+
+    // Fill which asserts RTS again, below the high watermark
+    uint32_t LowWatermark;
+} UsartLink_FlowControl;
+
+//@{
+// State of a link, owned by its UsartLink instantiation.
+// Receive: bytes of the half rings written (counted by the interrupt) and bytes passed to the handler.
+// Transmit: ring of regions. Not wrapped, the queued bytes are [read, write). Wrapped, they are [read, wrapEnd) and
+// [0, write). The region in transfer starts at read.
+//@}
+typedef struct {
+    uint8_t* pRxBuffer;
+    uint32_t RxBufferSize;
+    uint8_t* pTxBuffer;
+    uint32_t TxBufferSize;
+    UsartLink_Notification Notification;
+
+    Atomic_Uint32 RxHalfPasses;
+    uint32_t RxReadCount;
+    // Flow control: held bytes of the last receive call, RTS deasserted
+    bool RxIsFlowControlled;
+    UsartLink_FlowControl RxFlowControl;
+    uint32_t RxHeldSize;
+    bool RxIsPaused;
+
+    uint32_t TxRead;
+    uint32_t TxWrite;
+    uint32_t TxWrapEnd;
+    bool TxIsWrapped;
+    uint32_t TxDmaSize;
+    // Reservation of the producer
+    uint32_t TxReservedSize;
+    bool TxIsReservationWrapped;
+
+    UsartLink_Statistics Statistics;
+} UsartLink_State;
+
+//@{
+// Reset the state, start the receive DMA, enable the DMA requests and the idle line interrupt of the USART.
+// @param pState: State of the link.
+// @param pConfig: Link configuration.
+//@}
+void UsartLink_Init(UsartLink_State* const pState, const UsartLink_Config* const pConfig);
+
+//@{
+// Pass the bytes received up to the write count to the handler.
+// @param pState: State of the link.
+// @param writeCount: Bytes written by the receive DMA since init (modulo 2^32).
+// @param handler: Receive handler.
+// @param pContext: Passed unchanged to the handler.
+// @param heldSize: Bytes of earlier chunks still used by the handler (e.g. an incomplete frame decoded in place).
+// @return bool: false on an overrun, the pending bytes are dropped and the held bytes are invalid
+//@}
+bool UsartLink_PassReceived(UsartLink_State* const pState, const uint32_t writeCount, const UsartLink_ReceiveHandler handler,
+                            void* const pContext, const uint32_t heldSize);
+
+//@{
+// Enable the flow control of the receive ring and assert RTS.
+// @param pState: State of the link.
+// @param pFlowControl: Flow control configuration.
+//@}
+void UsartLink_EnableFlowControl(UsartLink_State* const pState, const UsartLink_FlowControl* const pFlowControl);
+
+//@{
+// Deassert or assert RTS by the fill of the receive ring, called at the ceiling.
+// @param pState: State of the link.
+// @param writeCount: Bytes written by the receive DMA since init (modulo 2^32).
+//@}
+void UsartLink_UpdateFlowControl(UsartLink_State* const pState, const uint32_t writeCount);
+
+//@{
+// Reserve a contiguous region in the transmit ring.
+// @param pState: State of the link.
+// @param size: Region size 1..TxBufferSize-1.
+// @return uint8_t*: Start of the region, NULL if the ring is too full (counted)
+//@}
+uint8_t* UsartLink_ReserveRegion(UsartLink_State* const pState, const uint32_t size);
+
+//@{
+// Check if a region could be reserved now without counting a rejection, the ring is not changed.
+// @param pState: State of the link.
+// @param size: Region size 1..TxBufferSize-1.
+// @return bool: true if UsartLink_ReserveRegion(size) succeeds until the next transmit call of this execution level
+//@}
+bool UsartLink_CanReserveRegion(const UsartLink_State* const pState, const uint32_t size);
+
+//@{
+// Queue the reserved region, called at the ceiling.
+// @param pState: State of the link.
+// @param size: Bytes written into the region, at most the reserved size. 0 releases the region.
+// @return bool: true if bytes were queued
+//@}
+bool UsartLink_QueueRegion(UsartLink_State* const pState, const uint32_t size);
+
+//@{
+// Take the next queued region for the transmit DMA if it is idle, called at the ceiling or from the interrupt.
+// @param pState: State of the link.
+// @param pSize: Set to the region size.
+// @return uint8_t*: Start of the region, NULL if the DMA is busy or nothing is queued
+//@}
+uint8_t* UsartLink_TakeRegion(UsartLink_State* const pState, uint32_t* const pSize);
+
+//@{
+// Reset the statistics.
+// @param pState: State of the link.
+//@}
+void UsartLink_ResetStatistics(UsartLink_State* const pState);
+
+#ifdef __cplusplus
+}
+#endif // __cplusplus
+
+#ifdef __cplusplus
+//@{
+// Hardware of a port: DMA channels of the USART with their interrupt flags, pins (Tx, Rx, CTS, RTS) without remap
+// (@see ST_CortexM3_STM32F103_TRM_Rev15.pdf Chapter 9.3.8), EXTI source of the Rx pin and the peripheral clock.
+//@}
+template <USART_ModuleAddress Usart>
+struct UsartLink_Port;
+
+template <>
+struct UsartLink_Port<USART_ModuleAddress_USART1> {
+    static const DMA_ChannelAddress RX_DMA = DMA_ChannelAddress_DMA1_Channel5;
+    static const DMA_IrqFlag RX_HALF_FLAG = DMA1_IrqFlag_Ch5_HT;
+    static const DMA_IrqFlag RX_FULL_FLAG = DMA1_IrqFlag_Ch5_TC;
+    static const DMA_ChannelAddress TX_DMA = DMA_ChannelAddress_DMA1_Channel4;
+    static const DMA_IrqFlag TX_FULL_FLAG = DMA1_IrqFlag_Ch4_TC;
+    static const DMA_IrqFlag TX_GLOBAL_FLAG = DMA1_IrqFlag_Ch4_GL;
+    static const GPIO_ModuleAddress GPIO = GPIO_ModuleAddress_GPIOA;
+    static const uint16_t TX_PIN = GPIO_Pin_9;
+    static const uint16_t RX_PIN = GPIO_Pin_10;
+    static const uint16_t CTS_PIN = GPIO_Pin_11;
+    static const uint16_t RTS_PIN = GPIO_Pin_12;
+    static const GPIO_PortSource RX_PORT_SOURCE = GPIO_PortSourceA;
+    static const GPIO_PinSource RX_PIN_SOURCE = GPIO_PinSource10;
+    static void enableClock(void) {
+        RCC_EnableAPB2PeripheralClock(RCC_APB2Periph_USART1, true);
+    }
+};
+
+template <>
+struct UsartLink_Port<USART_ModuleAddress_USART2> {
+    static const DMA_ChannelAddress RX_DMA = DMA_ChannelAddress_DMA1_Channel6;
+    static const DMA_IrqFlag RX_HALF_FLAG = DMA1_IrqFlag_Ch6_HT;
+    static const DMA_IrqFlag RX_FULL_FLAG = DMA1_IrqFlag_Ch6_TC;
+    static const DMA_ChannelAddress TX_DMA = DMA_ChannelAddress_DMA1_Channel7;
+    static const DMA_IrqFlag TX_FULL_FLAG = DMA1_IrqFlag_Ch7_TC;
+    static const DMA_IrqFlag TX_GLOBAL_FLAG = DMA1_IrqFlag_Ch7_GL;
+    static const GPIO_ModuleAddress GPIO = GPIO_ModuleAddress_GPIOA;
+    static const uint16_t TX_PIN = GPIO_Pin_2;
+    static const uint16_t RX_PIN = GPIO_Pin_3;
+    static const uint16_t CTS_PIN = GPIO_Pin_0;
+    static const uint16_t RTS_PIN = GPIO_Pin_1;
+    static const GPIO_PortSource RX_PORT_SOURCE = GPIO_PortSourceA;
+    static const GPIO_PinSource RX_PIN_SOURCE = GPIO_PinSource3;
+    static void enableClock(void) {
+        RCC_EnableAPB1PeripheralClock(RCC_APB1Periph_USART2, true);
+    }
+};
+
+template <>
+struct UsartLink_Port<USART_ModuleAddress_USART3> {
+    static const DMA_ChannelAddress RX_DMA = DMA_ChannelAddress_DMA1_Channel3;
+    static const DMA_IrqFlag RX_HALF_FLAG = DMA1_IrqFlag_Ch3_HT;
+    static const DMA_IrqFlag RX_FULL_FLAG = DMA1_IrqFlag_Ch3_TC;
+    static const DMA_ChannelAddress TX_DMA = DMA_ChannelAddress_DMA1_Channel2;
+    static const DMA_IrqFlag TX_FULL_FLAG = DMA1_IrqFlag_Ch2_TC;
+    static const DMA_IrqFlag TX_GLOBAL_FLAG = DMA1_IrqFlag_Ch2_GL;
+    static const GPIO_ModuleAddress GPIO = GPIO_ModuleAddress_GPIOB;
+    static const uint16_t TX_PIN = GPIO_Pin_10;
+    static const uint16_t RX_PIN = GPIO_Pin_11;
+    static const uint16_t CTS_PIN = GPIO_Pin_13;
+    static const uint16_t RTS_PIN = GPIO_Pin_14;
+    static const GPIO_PortSource RX_PORT_SOURCE = GPIO_PortSourceB;
+    static const GPIO_PinSource RX_PIN_SOURCE = GPIO_PinSource11;
+    static void enableClock(void) {
+        RCC_EnableAPB1PeripheralClock(RCC_APB1Periph_USART3, true);
+    }
+};
+
+//@{
+// Link on a USART, one instantiation per USART. The rings are in .noinit.
+// Usage: typedef UsartLink<USART_ModuleAddress_USART2, 256U, 256U> HostLink; HostLink::init(&onReceived);
+// @param Usart: USART of the link.
+// @param RxBufferSize: Size of the receive ring, even, twice the longest burst between two receive calls plus the held bytes.
+// @param TxBufferSize: Size of the transmit ring, the largest region is one byte less.
+//@}
+template <USART_ModuleAddress Usart, uint32_t RxBufferSize, uint32_t TxBufferSize>
+class UsartLink {
+
+public:
+
+    // Hardware of the port
+    typedef UsartLink_Port<Usart> Port;
+
+    //@{
+    // Start the receive DMA, enable the DMA requests and the idle line interrupt of the USART.
+    // @param notification: Called when received bytes are pending, NULL for polling.
+    //@}
+    static void init(const UsartLink_Notification notification) {
+        UsartLink_Config config;
+        config.Usart = Usart;
+        config.RxDma = Port::RX_DMA;
+        config.TxDma = Port::TX_DMA;
+        config.pRxBuffer = rxBuffer;
+        config.RxBufferSize = RxBufferSize;
+        config.pTxBuffer = txBuffer;
+        config.TxBufferSize = TxBufferSize;
+        config.Notification = notification;
+        UsartLink_Init(&state, &config);
+    }
+
+    //@{
+    // Enable the flow control of the receive ring and assert RTS, call it after init. The RTS pin of the port must be
+    // an output (GPIO_Mode_Out_PP) and the USART initialized with USART_HardwareFlowControl_CTS.
+    // @param highWatermark: Fill of the receive ring which deasserts RTS, below RxBufferSize / 2.
+    // @param lowWatermark: Fill which asserts RTS again, below the high watermark.
+    //@}
+    static void enableFlowControl(const uint32_t highWatermark, const uint32_t lowWatermark) {
+        UsartLink_FlowControl flowControl;
+        flowControl.RtsGpio = Port::GPIO;
+        flowControl.RtsPin = Port::RTS_PIN;
+        flowControl.HighWatermark = highWatermark;
+        flowControl.LowWatermark = lowWatermark;
+        const CriticalSectionGuard<USARTLINK_CEILING> guard;
+        UsartLink_EnableFlowControl(&state, &flowControl);
+    }
+
+    //@{
+    // Serve the idle line interrupt, call it from the USART interrupt handler.
+    //@}
+    static void handleUsartInterrupt(void) {
+        if (USART_IsIdleLineDetected(Usart)) {
+            USART_ClearIdleLine(Usart);
+            UsartLink_UpdateFlowControl(&state, getRxWriteCount());
+            if (state.Notification != NULL) {
+                state.Notification();
+            }
+        }
+    }
+
+    //@{
+    // Serve the half and full ring interrupt, call it from the receive DMA interrupt handler.
+    //@}
+    static void handleRxDmaInterrupt(void) {
+        // one read: a flag set after it stays pending for the next interrupt, the global flag would clear it too
+        const uint32_t pending = (uint32_t)DMA_GetPendingInterrupts((DMA_IrqFlag)(Port::RX_HALF_FLAG | Port::RX_FULL_FLAG));
+        uint32_t halfPasses = 0U;
+        if ((pending & (uint32_t)Port::RX_HALF_FLAG) != 0U) {
+            ++halfPasses;
+        }
+        if ((pending & (uint32_t)Port::RX_FULL_FLAG) != 0U) {
+            ++halfPasses;
+        }
+        DMA_ClearPendingInterrupt((DMA_IrqFlag)pending);
+        (void)Atomic_FetchAdd32(&state.RxHalfPasses, halfPasses);
+        UsartLink_UpdateFlowControl(&state, getRxWriteCount());
+        if (state.Notification != NULL) {
+            state.Notification();
+        }
+    }
+
+    //@{
+    // Serve the transfer complete interrupt, call it from the transmit DMA interrupt handler.
+    //@}
+    static void handleTxDmaInterrupt(void) {
+        DMA_ClearPendingInterrupt((DMA_IrqFlag)(Port::TX_FULL_FLAG | Port::TX_GLOBAL_FLAG));
+        state.TxRead += state.TxDmaSize;
+        state.TxDmaSize = 0U;
+        startTransmit();
+    }
+
+    //@{
+    // Pass the bytes received since the last call to the handler.
+    // @param handler: Receive handler.
+    // @param pContext: Passed unchanged to the handler.
+    // @param heldSize: Bytes of earlier chunks still used by the handler (e.g. an incomplete frame decoded in place).
+    // @return bool: false on an overrun, the pending bytes are dropped and the held bytes are invalid
+    //@}
+    static bool receive(const UsartLink_ReceiveHandler handler, void* const pContext, const uint32_t heldSize) {
+        const bool isPassed = UsartLink_PassReceived(&state, getRxWriteCount(), handler, pContext, heldSize);
+        if (state.RxIsFlowControlled) {
+            // held bytes as of this call, the bytes the handler holds after it are passed with the next call
+            const CriticalSectionGuard<USARTLINK_CEILING> guard;
+            state.RxHeldSize = isPassed ? heldSize : 0U;
+            UsartLink_UpdateFlowControl(&state, getRxWriteCount());
+        }
+        return isPassed;
+    }
+
+    //@{
+    // Reserve a contiguous region in the transmit ring, commit it with commitTransmit before the next reservation.
+    // @param size: Region size 1..TxBufferSize-1.
+    // @return uint8_t*: Start of the region, NULL if the ring is too full (counted)
+    //@}
+    static uint8_t* reserveTransmit(const uint32_t size) {
+        return UsartLink_ReserveRegion(&state, size);
+    }
+
+    //@{
+    // Check if a region could be reserved now without counting a rejection, e.g. to poll for space.
+    // @param size: Region size 1..TxBufferSize-1.
+    // @return bool: true if reserveTransmit(size) succeeds until the next transmit call of this execution level
+    //@}
+    static bool canReserveTransmit(const uint32_t size) {
+        return UsartLink_CanReserveRegion(&state, size);
+    }
+
+    //@{
+    // Queue the reserved region for transmission.
+    // @param size: Bytes written into the region, at most the reserved size. 0 releases the region.
+    //@}
+    static void commitTransmit(const uint32_t size) {
+        const CriticalSectionGuard<USARTLINK_CEILING> guard;
+        if (UsartLink_QueueRegion(&state, size)) {
+            startTransmit();
+        }
+    }
+
+    //@{
+    // Copy data into the transmit ring and queue it.
+    // @param pData: Data.
+    // @param size: Number of bytes 1..TxBufferSize-1.
+    // @return bool: false if the ring was too full, nothing is queued
+    //@}
+    static bool transmit(const void* const pData, const uint32_t size) {
+        if (pData == NULL) {
+            ASSERT_DEBUG(false);
+            return false;
+        }
+        uint8_t* const pRegion = reserveTransmit(size);
+        if (pRegion == NULL) {
+            return false;
+        }
+        MemoryCopy_Copy(pRegion, pData, size);
+        commitTransmit(size);
+        return true;
+    }
+
+    //@{
+    // Copy the statistics.
+    // @param pStatistics: Pointer to the UsartLink_Statistics structure to fill.
+    //@}
+    static void getStatistics(UsartLink_Statistics* const pStatistics) {
+        if (pStatistics == NULL) {
+            ASSERT_DEBUG(false);
+            return;
+        }
+        *pStatistics = state.Statistics;
+    }
+
+    //@{
+    // Returns true while the flow control deasserts RTS.
+    //@}
+    static bool isReceivePaused(void) {
+        return state.RxIsPaused;
+    }
+
+    //@{
+    // Reset the statistics.
+    //@}
+    static void resetStatistics(void) {
+        UsartLink_ResetStatistics(&state);
+    }
+
+private:
+
+    // The half ring interrupt divides the receive ring into two halves
+    ASSERT_COMPILER((RxBufferSize >= 2U) && ((RxBufferSize % 2U) == 0U) && (RxBufferSize <= 0xFFFFU));
+    ASSERT_COMPILER((TxBufferSize >= 2U) && (TxBufferSize <= 0xFFFFU));
+
+    //@{
+    // Returns the number of bytes written by the receive DMA since init (modulo 2^32).
+    // The half ring interrupt of a crossed boundary may be pending (masked), then the boundary is counted here.
+    //@}
+    static uint32_t getRxWriteCount(void) {
+        const uint32_t halfSize = RxBufferSize / 2U;
+        uint32_t halfPasses = 0U;
+        uint32_t position = 0U;
+        do {
+            halfPasses = Atomic_Load32(&state.RxHalfPasses);
+            position = (RxBufferSize - (uint32_t)DMA_GetCurrDataCounter(Port::RX_DMA)) % RxBufferSize;
+        } while (halfPasses != Atomic_Load32(&state.RxHalfPasses));
+        if ((position / halfSize) != (halfPasses % 2U)) {
+            ++halfPasses;
+        }
+        return (halfPasses * halfSize) + (position % halfSize);
+    }
+
+    //@{
+    // Start the transfer of the next queued region if the DMA is idle. Called at the ceiling or from the interrupt.
+    //@}
+    static void startTransmit(void) {
+        uint32_t size = 0U;
+        const uint8_t* const pRegion = UsartLink_TakeRegion(&state, &size);
+        if (pRegion != NULL) {
+            DMA_Enable(Port::TX_DMA, false);
+            DMA_SetMemoryBaseAddress(Port::TX_DMA, (uint32_t)pRegion); //lint !e923 cast from pointer to int [MISRA C++ Rule 5-2-9]. Justification: DMA address register
+            DMA_SetCurrDataCounter(Port::TX_DMA, (uint16_t)size);
+            DMA_Enable(Port::TX_DMA, true);
+        }
+    }
+
+    //@{
+    // Constructor.
+    //@}
+    explicit UsartLink();
+
+    //@{
+    // Destructor.
+    //@}
+    ~UsartLink();
+
+    //@{
+    // Provide the private copy constructor so the compiler does not generate the default one.
+    //@}
+    UsartLink(const UsartLink& other);
+
+    //@{
+    // Provide the private assignment operator so the compiler does not generate the default one.
+    //@}
+    UsartLink& operator=(const UsartLink& other);
+
+    static UsartLink_State state;
+    static uint8_t rxBuffer[RxBufferSize];
+    static uint8_t txBuffer[TxBufferSize];
+};
+
+template <USART_ModuleAddress Usart, uint32_t RxBufferSize, uint32_t TxBufferSize>
+UsartLink_State UsartLink<Usart, RxBufferSize, TxBufferSize>::state;
+
+template <USART_ModuleAddress Usart, uint32_t RxBufferSize, uint32_t TxBufferSize>
+STARTUP_NOINIT uint8_t UsartLink<Usart, RxBufferSize, TxBufferSize>::rxBuffer[RxBufferSize];
+
+template <USART_ModuleAddress Usart, uint32_t RxBufferSize, uint32_t TxBufferSize>
+STARTUP_NOINIT uint8_t UsartLink<Usart, RxBufferSize, TxBufferSize>::txBuffer[TxBufferSize];
+#endif // __cplusplus
+
+#endif // SYSTEMUSARTLINK_H
@@ -0,0 +1,185 @@
+// (c) IMT - Information Management Technology AG, CH-9470 Buchs, www.imt.ch.
+// SW guideline: Technote Coding Guidelines Ver. 1.5.1
+
+#include "SystemVectorTable.h"
+
+// Project includes
+#include "Core_CortexM3.h"
+#include "SystemStartupControl.h"
+
+// Imt.Base includes
+#include <Imt.Base.Core.Diagnostics/Diagnostics.h>
+
+// IAR includes
+#include <intrinsics.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif // __cplusplus
+// Flash vector table defined in vector_table_M.s
+extern const uint32_t __vector_table[VECTORTABLE_VECTOR_COUNT];
+void FLASH_IRQHandler(void);
+#ifdef __cplusplus
+}
+#endif // __cplusplus
+
+// Vector number of the first interrupt (IRQ_NumberType 0)
+#define VECTORTABLE_IRQ_OFFSET 16
+// IPSR: number of the active exception
+#define VECTORTABLE_IPSR_VECTOR_Mask ((uint32_t)0x000001FF)
+// The 4 priority bits are the upper bits of BASEPRI
+#define VECTORTABLE_PRIORITY_SHIFT 4U
+// Number of runs of the latency measurement
+#define VECTORTABLE_LATENCY_RUNS 8U
+
+//@{
+// Handler with context called by the dispatcher
+//@}
+typedef struct {
+    VectorTable_Isr Isr;
+    void* pContext;
+} VectorTable_IsrEntry;
+
+// SRAM vector table, VTOR requires an alignment of the table size rounded up to a power of two (64 words)
+// Filled by VectorTable_RelocateToRam, so it does not need to be initialized at startup.
+#pragma data_alignment = 256
+static STARTUP_NOINIT VectorTable_Handler vectorTableRam[VECTORTABLE_VECTOR_COUNT];
+
+// Registered handlers with context, indexed by the vector number
+static VectorTable_IsrEntry vectorTableIsrs[VECTORTABLE_VECTOR_COUNT];
+
+// Cycle counter at the entry of the latency measurement handler
+static volatile uint32_t vectorTableLatencyEntry = 0U;
+
+//@{
+// Returns the vector number of an interrupt or exception, VECTORTABLE_VECTOR_COUNT if out of range.
+//@}
+static uint32_t VectorTable_GetVector(const IRQ_NumberType irqNumber) {
+    const int32_t vector = (int32_t)irqNumber + VECTORTABLE_IRQ_OFFSET;
+    // vector 0 is the initial stack pointer and 1 the reset handler, both cannot be changed at runtime
+    if ((vector < 2) || (vector >= (int32_t)VECTORTABLE_VECTOR_COUNT)) {
+        return VECTORTABLE_VECTOR_COUNT;
+    }
+    return (uint32_t)vector;
+}
+
+//@{
+// Common handler of all vectors registered with VectorTable_RegisterIsr.
+//@}
+static void VectorTable_Dispatch(void) {
+    const uint32_t vector = __get_IPSR() & VECTORTABLE_IPSR_VECTOR_Mask;
+    const VectorTable_IsrEntry* const pEntry = &vectorTableIsrs[vector];
+    pEntry->Isr(pEntry->pContext);
+}
+
+//@{
+// Write a vector of the SRAM table, the new handler is used by the next exception entry.
+//@}
+static void VectorTable_WriteVector(const uint32_t vector, const VectorTable_Handler handler) {
+    vectorTableRam[vector] = handler;
+    __DSB();
+}
+
+void VectorTable_RelocateToRam(void) {
+    const __istate_t interruptState = __get_interrupt_state();
+    __disable_interrupt();
+
+    for (uint32_t vector = 0U; vector < VECTORTABLE_VECTOR_COUNT; ++vector) {
+        vectorTableRam[vector] = (VectorTable_Handler)__vector_table[vector]; //lint !e923 cast from int to pointer [MISRA C++ Rule 5-2-7], [MISRA C++ Rule 5-2-8]. Justification: The vector table holds the handler addresses
+    }
+    __DSB();
+    SCB->VTOR = (uint32_t)vectorTableRam; //lint !e923 cast from pointer to int [MISRA C++ Rule 5-2-9]. Justification: VTOR holds the table address
+    __DSB();
+    __ISB();
+
+    __set_interrupt_state(interruptState);
+}
+
+bool VectorTable_IsInRam(void) {
+    return (SCB->VTOR == (uint32_t)vectorTableRam); //lint !e923 cast from pointer to int [MISRA C++ Rule 5-2-9]
+}
+
+void VectorTable_SetHandler(const IRQ_NumberType irqNumber, const VectorTable_Handler handler) {
+    const uint32_t vector = VectorTable_GetVector(irqNumber);
+    if ((vector == VECTORTABLE_VECTOR_COUNT) || (handler == NULL) || !VectorTable_IsInRam()) {
+        ASSERT_DEBUG(false);
+        return;
+    }
+    VectorTable_WriteVector(vector, handler);
+}
+
+void VectorTable_RegisterIsr(const IRQ_NumberType irqNumber, const VectorTable_Isr isr, void* const pContext) {
+    const uint32_t vector = VectorTable_GetVector(irqNumber);
+    if ((vector == VECTORTABLE_VECTOR_COUNT) || (isr == NULL) || !VectorTable_IsInRam()) {
+        ASSERT_DEBUG(false);
+        return;
+    }
+    // the entry is complete before the dispatcher can be reached through the vector
+    vectorTableIsrs[vector].Isr = isr;
+    vectorTableIsrs[vector].pContext = pContext;
+    VectorTable_WriteVector(vector, &VectorTable_Dispatch);
+}
+
+void VectorTable_RestoreHandler(const IRQ_NumberType irqNumber) {
+    const uint32_t vector = VectorTable_GetVector(irqNumber);
+    if ((vector == VECTORTABLE_VECTOR_COUNT) || !VectorTable_IsInRam()) {
+        ASSERT_DEBUG(false);
+        return;
+    }
+    VectorTable_WriteVector(vector, (VectorTable_Handler)__vector_table[vector]); //lint !e923 cast from int to pointer [MISRA C++ Rule 5-2-7], [MISRA C++ Rule 5-2-8]
+}
+
+//@{
+// Handler of VECTORTABLE_LATENCY_IRQn, the same function is used by the flash and the SRAM vector table.
+//@}
+void FLASH_IRQHandler(void) {
+    vectorTableLatencyEntry = DWT->CYCCNT;
+}
+
+//@{
+// Returns the minimum cycles from pending VECTORTABLE_LATENCY_IRQn to its handler with the current VTOR.
+//@}
+static uint32_t VectorTable_MeasureLatency(void) {
+    uint32_t minimumCycles = 0xFFFFFFFFU;
+    for (uint32_t run = 0U; run < VECTORTABLE_LATENCY_RUNS; ++run) {
+        const uint32_t startCycles = DWT->CYCCNT;
+        NVIC_SetPendingIRQ(VECTORTABLE_LATENCY_IRQn);
+        // the interrupt is taken at the latest after the barriers
+        __DSB();
+        __ISB();
+        const uint32_t cycles = vectorTableLatencyEntry - startCycles;
+        if (cycles < minimumCycles) {
+            minimumCycles = cycles;
+        }
+    }
+    return minimumCycles;
+}
+
+void VectorTable_MeasureDispatchLatency(VectorTable_Latency* const pLatency) {
+    if ((pLatency == NULL) || !VectorTable_IsInRam()) {
+        ASSERT_DEBUG(false);
+        return;
+    }
+
+    const uint32_t vector = VectorTable_GetVector(VECTORTABLE_LATENCY_IRQn);
+    const VectorTable_Handler ramHandler = vectorTableRam[vector];
+    VectorTable_WriteVector(vector, &FLASH_IRQHandler);
+    NVIC_SetPriority(VECTORTABLE_LATENCY_IRQn, IRQ_Priority0);
+    NVIC_EnableIRQ(VECTORTABLE_LATENCY_IRQn);
+
+    // while VTOR points to flash, all other interrupts are masked: their runtime handlers are only in the SRAM table
+    const uint32_t basePriority = __get_BASEPRI();
+    __set_BASEPRI((uint32_t)IRQ_Priority1 << VECTORTABLE_PRIORITY_SHIFT);
+
+    SCB->VTOR = (uint32_t)__vector_table; //lint !e923 cast from pointer to int [MISRA C++ Rule 5-2-9]
+    __DSB();
+    pLatency->FlashCycles = VectorTable_MeasureLatency();
+
+    SCB->VTOR = (uint32_t)vectorTableRam; //lint !e923 cast from pointer to int [MISRA C++ Rule 5-2-9]
+    __DSB();
+    pLatency->RamCycles = VectorTable_MeasureLatency();
+    __set_BASEPRI(basePriority);
+
+    NVIC_DisableIRQ(VECTORTABLE_LATENCY_IRQn);
+    VectorTable_WriteVector(vector, ramHandler);
+}
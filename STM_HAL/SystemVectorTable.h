@@ -0,0 +1,103 @@
+// (c) IMT - Information Management Technology AG, CH-9470 Buchs, www.imt.ch.
+// SW guideline: Technote Coding Guidelines Ver. 1.5.1
+
+#ifndef SYSTEMVECTORTABLE_H
+#define SYSTEMVECTORTABLE_H
+
+// Must be very first include
+#include <Imt.Base.Core.Platform/Platform.h>
+
+// Project includes
+#include "SystemPeripherals_NVIC.h"
+
+// Determine if a C++ compiler is being used.  If so, ensure that standard C is used to process the API information.
+#ifdef __cplusplus
+extern "C" {
+#endif // __cplusplus
+
+//@{
+// Vector table relocation to SRAM and runtime interrupt handler registration.
+// After reset the NVIC fetches the handlers from __vector_table in flash (vector_table_M.s),
+// the handlers are bound at link time by the weak XXX_IRQHandler symbols.
+// VectorTable_RelocateToRam copies the flash table to SRAM and sets VTOR, afterwards:
+// - VectorTable_SetHandler writes a handler directly into the vector (zero indirection, for hot interrupts)
+// - VectorTable_RegisterIsr binds a handler with a context pointer through a common dispatcher,
+//   which looks up the active vector (IPSR) in a table (one indirection, for shared or multi-instance drivers)
+//
+// Reference: Cortex-M3 Devices Generic User Guide DUI0552A Chapter 2.3.4 Vector table
+// Reference: Cortex-M3 Devices Generic User Guide DUI0552A Chapter 4.3.4 Vector Table Offset Register
+//@}
+
+// Number of vectors of the medium density STM32F103: 16 Cortex-M3 exceptions + 43 interrupts
+#define VECTORTABLE_VECTOR_COUNT (16U + 43U)
+
+// Interrupt pended by VectorTable_MeasureDispatchLatency, the FLASH interrupt is not used by the application.
+// Note: The measurement defines the strong FLASH_IRQHandler.
+#define VECTORTABLE_LATENCY_IRQn FLASH_IRQn
+
+//@{
+// Interrupt handler placed directly in the vector table
+//@}
+typedef void (*VectorTable_Handler)(void);
+
+//@{
+// Interrupt handler called by the dispatcher with the registered context
+//@}
+typedef void (*VectorTable_Isr)(void* pContext);
+
+//@{
+// Dispatch latency from pending the interrupt to the first instruction of the handler body in CPU cycles
+//@}
+typedef struct {
+    // Vector fetched from the flash table (I-Code bus, flash wait states apply)
+    uint32_t FlashCycles;
+
+    // Vector fetched from the SRAM table (System bus)
+    uint32_t RamCycles;
+} VectorTable_Latency;
+
+//@{
+// Copy the flash vector table to SRAM and point VTOR to the copy.
+// Call it once during initialization before any handler is registered.
+//@}
+void VectorTable_RelocateToRam(void);
+
+//@{
+// Returns true if VTOR points to the SRAM vector table.
+//@}
+bool VectorTable_IsInRam(void);
+
+//@{
+// Place a handler directly in the SRAM vector table (no dispatcher).
+// @param irqNumber: Interrupt or Cortex-M3 exception number.
+// @param handler: Interrupt handler.
+//@}
+void VectorTable_SetHandler(const IRQ_NumberType irqNumber, const VectorTable_Handler handler);
+
+//@{
+// Register a handler with a context pointer, called through the dispatcher.
+// @param irqNumber: Interrupt or Cortex-M3 exception number.
+// @param isr: Interrupt handler.
+// @param pContext: Passed unchanged to the handler, e.g. the driver instance.
+//@}
+void VectorTable_RegisterIsr(const IRQ_NumberType irqNumber, const VectorTable_Isr isr, void* const pContext);
+
+//@{
+// Restore the link time handler of the flash vector table.
+// @param irqNumber: Interrupt or Cortex-M3 exception number.
+//@}
+void VectorTable_RestoreHandler(const IRQ_NumberType irqNumber);
+
+//@{
+// Measure the dispatch latency of the flash and the SRAM vector table with VECTORTABLE_LATENCY_IRQn.
+// The interrupt is pended by software with interrupts enabled, the minimum of several runs is reported.
+// Note: Requires the relocated vector table and the running DWT cycle counter (@see SystemStartupControl.h).
+// @param pLatency: Pointer to the VectorTable_Latency structure to fill.
+//@}
+void VectorTable_MeasureDispatchLatency(VectorTable_Latency* const pLatency);
+
+#ifdef __cplusplus
+}
+#endif // __cplusplus
+
+#endif // SYSTEMVECTORTABLE_H
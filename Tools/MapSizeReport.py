@@ -0,0 +1,351 @@
+#!/usr/bin/env python3
+# (c) IMT - Information Management Technology AG, CH-9470 Buchs, www.imt.ch.
+# SW guideline: Technote Coding Guidelines Ver. 1.5.1
+"""
+Flash/RAM budget report of the IAR linker map file.
+
+Reads the MODULE SUMMARY and ENTRY LIST of the map file written by ILINK
+(Debug/List/STM32F103BR_Led_Blink.map) and reports the size per module group
+(HAL, Diagnostics, App, ...), per translation unit and per symbol.
+The memory budget is taken from src/LinkerConfig.icf.
+
+Commands:
+  report  print the size report
+  check   print the report and compare it against the checked-in baseline,
+          exit code 1 on a size regression or when the budget is exceeded
+  update  write the baseline from the current map file
+
+The check runs as post-build step of both IAR configurations with the baseline
+Tools/MapSizeBaseline_<configuration>.txt. A baseline without totals is a
+placeholder: the first check writes it from the map file (the budget is
+checked), the written baseline must be committed.
+
+Only the python standard library is used, so the check runs on any Linux host
+which has access to the map file of the IAR build.
+"""
+
+import argparse
+import os
+import re
+import sys
+
+REPO_DIR = os.path.normpath(os.path.join(os.path.dirname(os.path.abspath(__file__)), '..'))
+DEFAULT_MAP = os.path.join(REPO_DIR, 'Debug', 'List', 'STM32F103BR_Led_Blink.map')
+DEFAULT_ICF = os.path.join(REPO_DIR, 'src', 'LinkerConfig.icf')
+DEFAULT_BASELINE = os.path.join(REPO_DIR, 'Tools', 'MapSizeBaseline_Debug.txt')
+
+# Source directory -> module group shown in the report (first match wins)
+MODULE_GROUPS = (
+    ('STM_HAL', 'HAL'),
+    ('Imt.Base/Imt.Base.HAL.STM32F103MD', 'HAL'),
+    ('Imt.Base/Imt.Base.Core.Diagnostics', 'Diagnostics'),
+    ('Imt.Base/Imt.Base.Core.Platform', 'Platform'),
+    ('App', 'App'),
+    ('src', 'System'),
+)
+# Directories which are not part of the firmware sources
+IGNORED_DIRS = ('.git', 'Debug', 'Release', 'Unittest', 'settings', 'Tools')
+SOURCE_EXTENSIONS = ('.c', '.cpp', '.s')
+
+# Objects which are not built from a source of the repository
+GROUP_LINKER = 'Linker'
+GROUP_LIBRARY = 'Library'
+
+
+class SizeError(Exception):
+    pass
+
+
+def parse_number(text):
+    # ILINK groups thousands with a space ("1 234") and hex addresses with an apostrophe
+    text = text.replace(' ', '').replace("'", '')
+    if not text:
+        return 0
+    return int(text, 16) if text.lower().startswith('0x') else int(text)
+
+
+def find_section(lines, title):
+    for index, line in enumerate(lines):
+        if line.startswith('***') and title in line:
+            # skip the closing "***" line of the section title
+            return index + 2
+    raise SizeError('section "%s" not found in map file' % title)
+
+
+def parse_module_summary(lines):
+    """Returns {object: (container, [column values])} and the column names."""
+    index = find_section(lines, 'MODULE SUMMARY')
+    while index < len(lines) and not lines[index].strip().startswith('Module'):
+        index += 1
+    if index == len(lines):
+        raise SizeError('MODULE SUMMARY header not found')
+
+    # Column labels may contain single spaces ("ro code"), values are right aligned to the label
+    header = lines[index]
+    labels = [(m.group(0), m.end()) for m in re.finditer(r'\S+(?: \S+)*', header)][1:]
+    columns = [label for label, _ in labels]
+
+    modules = {}
+    container = None
+    name = None
+    for line in lines[index + 2:]:
+        stripped = line.strip()
+        if line.startswith('***') or stripped.startswith('Grand Total'):
+            break
+        if not stripped or stripped.startswith(('---', 'Total:', 'Gaps')):
+            continue
+        if not line.startswith(' '):
+            # Object directory or library, e.g. "C:\...\Debug\Obj: [1]" or "dl7M_tln.a: [2]"
+            container = re.sub(r':\s*\[\d+\]\s*$', '', stripped)
+            continue
+        if stripped.startswith('Linker created'):
+            # stacks, heap and init tables
+            name = 'LinkerCreated'
+            container = GROUP_LINKER
+            line = line.replace('Linker created', ' ' * len('Linker created'))
+        else:
+            match = re.match(r'\s+(\S+)', line)
+            if not match.group(1)[0].isdigit():
+                name = match.group(1)
+                line = ' ' * match.end() + line[match.end():]
+            if not line.strip():
+                # name wrapped, values follow on the next line
+                continue
+
+        values = [0] * len(columns)
+        for number in re.finditer(r'\d{1,3}(?: \d{3})*', line):
+            # assign the value to the column with the nearest right edge
+            distances = [abs(end - number.end()) for _, end in labels]
+            values[distances.index(min(distances))] = parse_number(number.group(0))
+        modules[name] = (container, values)
+    return modules, columns
+
+
+def parse_entry_list(lines):
+    """Returns {(object, symbol): size} of all symbols with a size."""
+    index = find_section(lines, 'ENTRY LIST')
+    symbols = {}
+    pending = ''
+    for line in lines[index:]:
+        if line.startswith('***') or line.startswith('[1] = '):
+            break
+        if not line.strip() or line.startswith('Entry') or line.startswith('-----'):
+            continue
+        if pending:
+            line = pending + ' ' + line.strip()
+            pending = ''
+        match = re.search(r"\s(0x[0-9a-fA-F']+)\s", line)
+        if match is None:
+            # long symbol name, the remaining columns follow on the next line
+            pending = line.rstrip()
+            continue
+        name = line[:match.start()].strip()
+        tokens = line[match.end():].split()
+        if not tokens or not tokens[0].lower().startswith('0x'):
+            continue
+        size = parse_number(tokens[0])
+        for position, token in enumerate(tokens):
+            if token in ('Gb', 'Lc', 'Wk'):
+                objectName = re.sub(r'\s*\[\d+\]$', '', ' '.join(tokens[position + 1:]))
+                symbols[(objectName, name)] = size
+                break
+    return symbols
+
+
+def parse_totals(lines):
+    totals = {}
+    for line in lines:
+        match = re.match(r'\s*([\d ]+) bytes of (readonly|readwrite)\s+(code|data) memory', line)
+        if match:
+            totals[match.group(2) + ' ' + match.group(3)] = parse_number(match.group(1))
+    return totals
+
+
+def parse_budget(icfFile):
+    text = open(icfFile).read()
+    budget = {}
+    for key, symbol in (('flash', '__FLASH_size__'), ('ram', '__RAM_size__')):
+        match = re.search(r'^\s*define\s+symbol\s+%s\s*=\s*(0x[0-9a-fA-F]+|\d+)' % symbol, text, re.M)
+        if match is None:
+            raise SizeError('%s not defined in %s' % (symbol, icfFile))
+        budget[key] = parse_number(match.group(1))
+    return budget
+
+
+def source_groups():
+    """Returns {object file name: module group} of the firmware sources in the repository."""
+    groups = {}
+    for root, dirs, files in os.walk(REPO_DIR):
+        dirs[:] = [d for d in dirs if d not in IGNORED_DIRS]
+        relative = os.path.relpath(root, REPO_DIR).replace(os.sep, '/')
+        group = relative
+        for prefix, name in MODULE_GROUPS:
+            if relative == prefix or relative.startswith(prefix + '/'):
+                group = name
+                break
+        for fileName in files:
+            base, extension = os.path.splitext(fileName)
+            if extension in SOURCE_EXTENSIONS:
+                groups[base + '.o'] = group
+    return groups
+
+
+def module_sizes(modules, columns):
+    """Returns {(group, object): (flash, ram)} from the module summary."""
+    groups = source_groups()
+    sizes = {}
+    for name, (container, values) in modules.items():
+        flash = sum(v for c, v in zip(columns, values) if c.startswith('ro'))
+        ram = sum(v for c, v in zip(columns, values) if c.startswith('rw') and '(abs)' not in c)
+        if container == GROUP_LINKER:
+            group = GROUP_LINKER
+        elif name in groups:
+            group = groups[name]
+        else:
+            group = GROUP_LIBRARY
+        sizes[(group, name)] = (flash, ram)
+    return sizes
+
+
+def analyse(mapFile, icfFile):
+    try:
+        lines = open(mapFile, encoding='latin-1').read().splitlines()
+    except IOError as error:
+        raise SizeError('cannot read map file: %s' % error)
+    modules, columns = parse_module_summary(lines)
+    sizes = module_sizes(modules, columns)
+    objects = dict((name, group) for group, name in sizes)
+    symbols = dict(((objects[o], o, s), size) for (o, s), size in parse_entry_list(lines).items() if o in objects)
+    totals = parse_totals(lines)
+    current = {
+        'flash': totals.get('readonly code', 0) + totals.get('readonly data', 0),
+        'ram': totals.get('readwrite data', 0),
+    }
+    if not current['flash']:
+        current['flash'] = sum(f for f, _ in sizes.values())
+        current['ram'] = sum(r for _, r in sizes.values())
+    return {'modules': sizes, 'symbols': symbols, 'totals': current, 'budget': parse_budget(icfFile)}
+
+
+def print_report(result, topSymbols):
+    totals, budget = result['totals'], result['budget']
+    print('Memory budget (%s)' % os.path.relpath(DEFAULT_ICF, REPO_DIR))
+    for key in ('flash', 'ram'):
+        print('  %-5s %7d / %7d bytes (%5.1f%%)' % (key, totals[key], budget[key], 100.0 * totals[key] / budget[key]))
+
+    groups = {}
+    for (group, name), (flash, ram) in result['modules'].items():
+        groupFlash, groupRam = groups.get(group, (0, 0))
+        groups[group] = (groupFlash + flash, groupRam + ram)
+    print('\n%-40s %8s %8s' % ('Module group / translation unit', 'flash', 'ram'))
+    for group in sorted(groups, key=lambda g: -sum(groups[g])):
+        print('%-40s %8d %8d' % (group, groups[group][0], groups[group][1]))
+        units = sorted((n, s) for (g, n), s in result['modules'].items() if g == group)
+        for name, (flash, ram) in sorted(units, key=lambda u: -sum(u[1])):
+            print('  %-38s %8d %8d' % (name, flash, ram))
+
+    print('\nLargest %d symbols' % topSymbols)
+    ranked = sorted(result['symbols'].items(), key=lambda item: -item[1])[:topSymbols]
+    for (group, objectName, symbol), size in ranked:
+        print('  %6d  %-12s %-28s %s' % (size, group, objectName, symbol))
+
+
+def write_baseline(result, baselineFile):
+    with open(baselineFile, 'w', newline='\r\n') as baseline:
+        baseline.write('# Flash/RAM size baseline of the map file, regenerate with: python3 Tools/MapSizeReport.py update\n')
+        baseline.write('# total <flash|ram> <bytes>\n# module <group> <object> <flash> <ram>\n# symbol <group> <object> <size> <name>\n')
+        for key in ('flash', 'ram'):
+            baseline.write('total %s %d\n' % (key, result['totals'][key]))
+        for (group, name), (flash, ram) in sorted(result['modules'].items()):
+            baseline.write('module %s %s %d %d\n' % (group, name, flash, ram))
+        for (group, objectName, symbol), size in sorted(result['symbols'].items()):
+            baseline.write('symbol %s %s %d %s\n' % (group, objectName, size, symbol))
+
+
+def read_baseline(baselineFile):
+    baseline = {'totals': {}, 'modules': {}, 'symbols': {}}
+    try:
+        lines = open(baselineFile).read().splitlines()
+    except IOError as error:
+        raise SizeError('cannot read baseline, create it with "update": %s' % error)
+    for line in lines:
+        fields = line.split(' ', 4)
+        if fields[0] == 'total':
+            baseline['totals'][fields[1]] = int(fields[2])
+        elif fields[0] == 'module':
+            baseline['modules'][(fields[1], fields[2])] = (int(fields[3]), int(fields[4]))
+        elif fields[0] == 'symbol':
+            baseline['symbols'][(fields[1], fields[2], fields[4])] = int(fields[3])
+    return baseline
+
+
+def compare(result, baseline, tolerance):
+    """Prints all differences to the baseline and returns the number of regressions."""
+    regressions = 0
+    for key in ('flash', 'ram'):
+        if result['totals'][key] > result['budget'][key]:
+            print('BUDGET   %s %d bytes exceeds %d bytes' % (key, result['totals'][key], result['budget'][key]))
+            regressions += 1
+    if not baseline['totals']:
+        # placeholder, the baseline is recorded by this check
+        return regressions
+
+    for key in ('flash', 'ram'):
+        delta = result['totals'][key] - baseline['totals'].get(key, 0)
+        if delta > tolerance:
+            print('GROWTH   total %s +%d bytes' % (key, delta))
+            regressions += 1
+
+    print('\n%-48s %8s %8s' % ('Translation unit delta', 'flash', 'ram'))
+    for unit in sorted(set(result['modules']) | set(baseline['modules'])):
+        flash, ram = result['modules'].get(unit, (0, 0))
+        oldFlash, oldRam = baseline['modules'].get(unit, (0, 0))
+        if (flash, ram) != (oldFlash, oldRam):
+            marker = ''
+            if (flash - oldFlash > tolerance) or (ram - oldRam > tolerance):
+                marker = '  <- regression'
+                regressions += 1
+            print('  %-46s %+8d %+8d%s' % ('%s/%s' % unit, flash - oldFlash, ram - oldRam, marker))
+
+    print('\nSymbol delta')
+    for symbol in sorted(set(result['symbols']) | set(baseline['symbols'])):
+        delta = result['symbols'].get(symbol, 0) - baseline['symbols'].get(symbol, 0)
+        if delta != 0:
+            print('  %+6d  %s/%s %s' % (delta, symbol[0], symbol[1], symbol[2]))
+    return regressions
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Flash/RAM budget report of the IAR linker map file.')
+    parser.add_argument('command', choices=('report', 'check', 'update'))
+    parser.add_argument('--map', default=DEFAULT_MAP, help='ILINK map file (default: %(default)s)')
+    parser.add_argument('--icf', default=DEFAULT_ICF, help='linker configuration with the memory budget')
+    parser.add_argument('--baseline', default=DEFAULT_BASELINE, help='checked-in size baseline')
+    parser.add_argument('--tolerance', type=int, default=0, help='allowed growth in bytes per unit (default: 0)')
+    parser.add_argument('--top', type=int, default=20, help='number of symbols in the report')
+    args = parser.parse_args()
+
+    try:
+        result = analyse(args.map, args.icf)
+        if args.command == 'update':
+            write_baseline(result, args.baseline)
+            print('baseline written to %s' % args.baseline)
+            return 0
+        print_report(result, args.top)
+        if args.command == 'check':
+            print('')
+            baseline = read_baseline(args.baseline)
+            if not baseline['totals']:
+                write_baseline(result, args.baseline)
+                print('placeholder baseline, recorded from this map file: commit %s' % args.baseline)
+            regressions = compare(result, baseline, args.tolerance)
+            print('\n%d size regression(s)' % regressions)
+            return 1 if regressions else 0
+    except SizeError as error:
+        print('error: %s' % error, file=sys.stderr)
+        return 2
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
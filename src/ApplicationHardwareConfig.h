@@ -7,6 +7,9 @@
 // Must be very first include
 #include <Imt.Base.Core.Platform/Platform.h>
 
+// Project includes
+#include "SystemUsartLink.h"
+
 // Imt.Base includes
 #include <Imt.Base.HAL.STM32F103MD/SystemMemoryMap.h>
 
@@ -26,6 +29,112 @@
     #define W_LED_STAT             GPIOA_5_WRITE_ADDR
     #define R_LED_STAT             GPIOA_5_READ_ADDR 
     #define R_USER_BUTTON_B1   GPIOC_13_READ_ADDR
+    // Driver enable of the RS-485 transceiver of the Modbus line, 1 drives the bus
+    #define W_RS485_DE         GPIOB_12_WRITE_ADDR
 //#endif // _UNITTEST
 
+//------------------------------------------------------------------------------
+// Interrupt configuration
+//------------------------------------------------------------------------------
+// 1: copy the vector table to SRAM during initInterrupts, handlers can be registered at runtime (@see SystemVectorTable.h)
+// 0: handlers are bound at link time in the flash vector table
+#define APPLICATION_VECTOR_TABLE_IN_RAM 1
+
+// Priority grouping (PRIGROUP): all priority bits for preemption, none for sub-priority
+#define APPLICATION_INTERRUPT_PRIORITY_GROUPING 0U
+
+//------------------------------------------------------------------------------
+// Modbus RTU on USART3 (PB10 Tx, PB11 Rx, PB12 RS-485 driver enable), 8 data bits and even parity (@see ModbusApp.h)
+//------------------------------------------------------------------------------
+#define APPLICATION_MODBUS_BAUDRATE 19200U
+// Bits per character: start, 8 data, even parity, stop
+#define APPLICATION_MODBUS_CHARACTER_BITS 11U
+
+//------------------------------------------------------------------------------
+// Input capture of PB0 (@see SystemInputCapture.h)
+//------------------------------------------------------------------------------
+// 1: DMA mode, needs DMA1 Channel2 and Channel3 which the Modbus RTU slave owns: fails the check in SystemInitializationDriver
+// 0: interrupt mode, one capture interrupt per edge
+#define APPLICATION_INPUT_CAPTURE_DMA 0
+
+//------------------------------------------------------------------------------
+// DMA link to the host (@see UsartApp.h), 8 data bits and no parity. The port is named only here: the DMA channels, pins,
+// clock, interrupt handlers and plan entries follow from it (@see SystemUsartLink.h).
+// USART1: PA9 Tx, PA10 Rx. USART2: PA2 Tx, PA3 Rx (ST-LINK virtual COM port). USART3: PB10 Tx, PB11 Rx (Modbus).
+// CTS and RTS: USART1 PA11, PA12. USART2 PA0, PA1. USART3 PB13, PB14.
+//------------------------------------------------------------------------------
+#define APPLICATION_LINK_PORT USART2
+#define APPLICATION_LINK_BAUDRATE 115200U
+// 1: the link detects the baud rate of the host from the sync character 0x55 at startup (@see SystemAutoBaud.h)
+// 0: the link starts at APPLICATION_LINK_BAUDRATE. The shell command bauddetect starts a detection in both cases.
+#define APPLICATION_LINK_AUTOBAUD 0
+// 1: RTS/CTS flow control, RTS follows the fill of the receive ring (@see SystemUsartLink.h)
+// 0: no flow control, the ST-LINK virtual COM port has no RTS and CTS lines
+#define APPLICATION_LINK_FLOW_CONTROL 0
+// Fill of the receive ring which deasserts RTS and asserts it again: 96 + 128 (half ring) leaves 32 bytes for the FIFO of
+// the sender
+#define APPLICATION_LINK_RX_HIGH_WATERMARK 96U
+#define APPLICATION_LINK_RX_LOW_WATERMARK 32U
+
+#ifdef __cplusplus
+// Link of the port, receive and transmit ring of 256 bytes
+typedef UsartLink<USARTLINK_MODULE(APPLICATION_LINK_PORT), 256U, 256U> ApplicationLink;
+#endif // __cplusplus
+
+// Helpers of the link interrupts: handler declaration and interrupt plan entry
+#define APPLICATION_LINK_DECLARATION(returnType, irqNumber, handler, function) returnType handler(void);
+#define APPLICATION_LINK_ENTRY(ENTRY, irqNumber, handler, function) \
+    ENTRY(irqNumber, IRQ_Priority4, &handler, INTERRUPTPLAN_ENABLED, INTERRUPTPLAN_NORMAL)
+// Helpers of the Rx edge interrupt of the link port (auto-baud): handler declaration and interrupt plan entry
+#define APPLICATION_RX_EDGE_DECLARATION(returnType, irqNumber, handler) returnType handler(void);
+#define APPLICATION_RX_EDGE_ENTRY(ENTRY, irqNumber, handler) \
+    ENTRY(irqNumber, IRQ_Priority1, &handler, INTERRUPTPLAN_ENABLED, INTERRUPTPLAN_CRITICAL)
+
+#ifdef __cplusplus
+extern "C" {
+#endif // __cplusplus
+// Interrupt handlers of the application modules
+void SysTick_Handler(void);
+void TIM3_IRQHandler(void);
+USARTLINK_INTERRUPTS(APPLICATION_LINK_PORT, APPLICATION_LINK_DECLARATION, void)
+USARTLINK_RX_EDGE_INTERRUPT(APPLICATION_LINK_PORT, APPLICATION_RX_EDGE_DECLARATION, void)
+void USART3_IRQHandler(void);
+void TIM1_CC_IRQHandler(void);
+void DMA1_Channel3_IRQHandler(void);
+void EXTI15_10_IRQHandler(void);
+void DMA1_Channel4_IRQHandler(void);
+#ifdef __cplusplus
+}
+#endif // __cplusplus
+
+//@{
+// Interrupt plan of the application (@see SystemInterruptPlan.h), checked at compile time and applied by
+// SystemInitializationDriver::initInterrupts / enableInterrupts. Every interrupt of the application is listed here.
+// The RS-485 driver enable of the Modbus slave is released in USART3_IRQHandler (normal class). After the last stop
+// bit the release waits for the interrupt entry, a Modbus handler of the same priority already running, and every run
+// of the critical handlers meanwhile: SysTick_Handler (at most once, period 1ms), TIM3_IRQHandler (once per capture
+// of PB0) and the auto-baud Rx edge handler (once per falling edge on the link Rx, only during a detection).
+// One bit time at APPLICATION_MODBUS_BAUDRATE (52us, 416 cycles at 8MHz) holds only while these together stay below
+// it: a baud detection or a fast PB0 signal during a Modbus response can delay the release beyond one bit time.
+// The measured maximum is release_max of the rs485 statistics (shell command stats).
+// ENTRY(interrupt, preemption priority, handler, enable state, latency class)
+//@}
+#define APPLICATION_INTERRUPT_TABLE(ENTRY)                                                                             \
+    /* 1ms tick of the button debouncer */                                                                             \
+    ENTRY(SysTick_IRQn,       IRQ_Priority0, &SysTick_Handler,           INTERRUPTPLAN_ENABLED, INTERRUPTPLAN_CRITICAL) \
+    /* Auto-baud: falling edges of the link Rx pin, timestamped in the interrupt, masked except during a detection */ \
+    USARTLINK_RX_EDGE_INTERRUPT(APPLICATION_LINK_PORT, APPLICATION_RX_EDGE_ENTRY, ENTRY)                               \
+    /* Input capture of PB0 in the interrupt mode: the capture flag must be served before the next edge */             \
+    ENTRY(TIM3_IRQn,          IRQ_Priority2, &TIM3_IRQHandler,           INTERRUPTPLAN_ENABLED, INTERRUPTPLAN_CRITICAL) \
+    /* Modbus RTU slave: USART3 idle line, TIM1 gaps t1.5/t3.5 and receive half buffer, the response within t3.5 */  \
+    ENTRY(USART3_IRQn,        IRQ_Priority3, &USART3_IRQHandler,         INTERRUPTPLAN_ENABLED, INTERRUPTPLAN_NORMAL)  \
+    ENTRY(TIM1_CC_IRQn,       IRQ_Priority3, &TIM1_CC_IRQHandler,        INTERRUPTPLAN_ENABLED, INTERRUPTPLAN_NORMAL)  \
+    ENTRY(DMA1_Channel3_IRQn, IRQ_Priority3, &DMA1_Channel3_IRQHandler,  INTERRUPTPLAN_ENABLED, INTERRUPTPLAN_NORMAL)  \
+    /* DMA link: USART idle line, receive ring half/full and transmit complete of the link port */                    \
+    USARTLINK_INTERRUPTS(APPLICATION_LINK_PORT, APPLICATION_LINK_ENTRY, ENTRY)                                        \
+    /* User button B1 (PC13) edges, demultiplexed by the EXTI dispatcher */                                            \
+    ENTRY(EXTI15_10_IRQn,     IRQ_Priority5, &EXTI15_10_IRQHandler,      INTERRUPTPLAN_ENABLED, INTERRUPTPLAN_NORMAL)  \
+    /* Memory-to-memory DMA copies: completion handlers and start of the next request */                               \
+    ENTRY(DMA1_Channel4_IRQn, IRQ_Priority5, &DMA1_Channel4_IRQHandler,  INTERRUPTPLAN_ENABLED, INTERRUPTPLAN_NORMAL)
+
 #endif // #ifndef APPLICATIONHARDWARECONFIG_H
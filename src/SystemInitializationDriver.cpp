@@ -14,13 +14,43 @@
 #include "SystemPeripherals_EXTI.h"
 #include "SystemPeripherals_USART.h"
 #include "SystemPeripherals_TIM.h"
+#include "SystemStartupControl.h"
+#include "SystemVectorTable.h"
+#include "SystemTimeBase.h"
+#include "SystemInputCapture.h"
+#include "SystemUsartLink.h"
+#include "SystemModbusRtu.h"
+#include "SystemAutoBaud.h"
+#include "SystemMemoryCopy.h"
+#include "SystemInterruptPlan.h"
+#include "ApplicationHardwareConfig.h"
+#include "TimerApp.h"
 // Imt.Base
-#if 0
-//#include "ApplicationHardwareConfig.h"
-#include <Imt.Base.Dff.Runtime/RuntimeCore.h>
-#include <Imt.Base.Dff.Runtime/RuntimeTimer.h>
-#include <LowLevelIOInterface.h>
-#endif
+#include <Imt.Base.Core.Diagnostics/Diagnostics.h>
+
+// Interrupt plan of the application (@see ApplicationHardwareConfig.h)
+INTERRUPTPLAN_CHECK(APPLICATION_INTERRUPT_TABLE, APPLICATION_INTERRUPT_PRIORITY_GROUPING);
+INTERRUPTPLAN_CHECK_CEILING(INPUTCAPTURE_CEILING, TIM3_IRQn);
+// The interrupts of the link port share the state of the link
+#define APPLICATION_LINK_CHECK_CEILING(ceiling, irqNumber, handler, function) && ((ceiling) <= (uint32_t)InterruptPlan_Irq_##irqNumber)
+ASSERT_COMPILER((USARTLINK_CEILING >= CORE_CRITICALSECTION_HIGHEST_CEILING) USARTLINK_INTERRUPTS(APPLICATION_LINK_PORT, APPLICATION_LINK_CHECK_CEILING, USARTLINK_CEILING));
+#define APPLICATION_RX_EDGE_CHECK_CEILING(ceiling, irqNumber, handler) INTERRUPTPLAN_CHECK_CEILING(ceiling, irqNumber)
+USARTLINK_RX_EDGE_INTERRUPT(APPLICATION_LINK_PORT, APPLICATION_RX_EDGE_CHECK_CEILING, AUTOBAUD_CEILING);
+INTERRUPTPLAN_CHECK_CEILING(MODBUSRTU_CEILING, USART3_IRQn);
+INTERRUPTPLAN_CHECK_CEILING(MODBUSRTU_CEILING, TIM1_CC_IRQn);
+INTERRUPTPLAN_CHECK_CEILING(MODBUSRTU_CEILING, DMA1_Channel3_IRQn);
+INTERRUPTPLAN_CHECK_CEILING(MEMORYCOPY_CEILING, DMA1_Channel4_IRQn);
+// The copy channel is the transmit channel of USART1, the link must be on another port
+ASSERT_COMPILER(ApplicationLink::Port::TX_DMA != MEMORYCOPY_DMA_CHANNEL);
+// The LED pattern channel is the receive channel of USART1, the link must be on another port
+ASSERT_COMPILER(ApplicationLink::Port::RX_DMA != TimerApp::LED_DMA_CHANNEL);
+// The DMA mode of the input capture uses the DMA channels of USART3, the Modbus RTU slave owns them
+ASSERT_COMPILER((APPLICATION_INPUT_CAPTURE_DMA == 0) || ((INPUTCAPTURE_RISING_DMA_CHANNEL != MODBUSRTU_RX_DMA_CHANNEL) && (INPUTCAPTURE_RISING_DMA_CHANNEL != MODBUSRTU_TX_DMA_CHANNEL)));
+ASSERT_COMPILER((APPLICATION_INPUT_CAPTURE_DMA == 0) || ((INPUTCAPTURE_FALLING_DMA_CHANNEL != MODBUSRTU_RX_DMA_CHANNEL) && (INPUTCAPTURE_FALLING_DMA_CHANNEL != MODBUSRTU_TX_DMA_CHANNEL)));
+static const InterruptPlan_Entry INTERRUPT_PLAN[] = {
+    APPLICATION_INTERRUPT_TABLE(INTERRUPTPLAN_ENTRY)
+};
+static const uint32_t INTERRUPT_PLAN_COUNT = sizeof(INTERRUPT_PLAN) / sizeof(INTERRUPT_PLAN[0]);
 
  void SystemInitializationDriver::initCpuClock() {
   // after reset the clock is set to internal 8MHz (HSI)
@@ -38,18 +68,29 @@ void SystemInitializationDriver::initPeripheralClocks() {
   // initialize peripheral clocks based on application use case
     RCC_EnableAPB2PeripheralClock(RCC_APB2Periph_GPIOA, true);
     RCC_EnableAPB2PeripheralClock(RCC_APB2Periph_GPIOC, true); 
-    RCC_EnableAPB1PeripheralClock(RCC_APB1Periph_USART2, true); 
+    ApplicationLink::Port::enableClock();
     RCC_EnableAPB1PeripheralClock(RCC_APB1Periph_TIM2, true);
+    // 32-bit microsecond time base (@see SystemTimeBase.h)
+    RCC_EnableAPB1PeripheralClock(RCC_APB1Periph_TIM3, true);
+    RCC_EnableAPB1PeripheralClock(RCC_APB1Periph_TIM4, true);
+    // Input capture of PB0 (@see SystemInputCapture.h)
+    RCC_EnableAPB2PeripheralClock(RCC_APB2Periph_GPIOB, true);
     RCC_EnableAPB2PeripheralClock(RCC_APB2Periph_AFIO,true);
+    // CRC unit and DMA1 (memory-to-memory feed of the CRC unit and memory copies)
+    RCC_EnableAHBPeriphClock(RCC_AHBPeriph_CRC, true);
+    RCC_EnableAHBPeriphClock(RCC_AHBPeriph_DMA1, true);
+    // Modbus RTU slave: USART3 and the gap timer TIM1 (@see SystemModbusRtu.h)
+    RCC_EnableAPB1PeripheralClock(RCC_APB1Periph_USART3, true);
+    RCC_EnableAPB2PeripheralClock(RCC_APB2Periph_TIM1, true);
 }
 
 void SystemInitializationDriver::initPinConfig() {
-    GPIO_InitStruct  GPIO_config,GPIO_config2,GPIO_config3,GPIO_config4;
+    GPIO_InitStruct  GPIO_config,GPIO_config2,GPIO_config3,GPIO_config4,GPIO_config5;
     USART_InitStruct USART_config; 
    
-    /* GPIO Port A Pin5 Configuration Output for LED; LD2 on the board*/
+    /* GPIO Port A Pin5 Configuration Output for LED; LD2 on the board, driven by TIM2_CH1 output compare (@see TimerApp.h)*/
     GPIO_config.Pin = GPIO_Pin_5; 
-    GPIO_config.Mode = GPIO_Mode_Out_PP;   //GPIO_Mode_Out_OD;// 
+    GPIO_config.Mode = GPIO_Mode_AF_PP;   //GPIO_Mode_Out_PP;// 
     GPIO_config.Speed = GPIO_Speed_50MHz;
     GPIO_Init(GPIO_ModuleAddress_GPIOA, &GPIO_config);
     
@@ -59,33 +100,92 @@ void SystemInitializationDriver::initPinConfig() {
     GPIO_config4.Speed = GPIO_Speed_50MHz;
     GPIO_Init(GPIO_ModuleAddress_GPIOC, &GPIO_config4);
     
-    /* GPIO Port A Pin2 Configuration USART Tx */
-    GPIO_config2.Pin = GPIO_Pin_2; 
+    /* GPIO Port B Pin0 Configuration TIM3_CH3 input capture */
+    GPIO_config5.Pin = GPIO_Pin_0; 
+    GPIO_config5.Mode = GPIO_Mode_IN_FLOATING;
+    GPIO_config5.Speed = GPIO_Speed_50MHz;
+    GPIO_Init(GPIO_ModuleAddress_GPIOB, &GPIO_config5);
+    
+    /* Tx pin of the link port (@see ApplicationHardwareConfig.h) */
+    GPIO_config2.Pin = ApplicationLink::Port::TX_PIN; 
     GPIO_config2.Mode = GPIO_Mode_AF_PP;//GPIO_Mode_AF_OD;   
     GPIO_config2.Speed = GPIO_Speed_50MHz;
-    GPIO_Init(GPIO_ModuleAddress_GPIOA, &GPIO_config2);
+    GPIO_Init(ApplicationLink::Port::GPIO, &GPIO_config2);
   
-    /* GPIO Port A Pin3 Configuration USART Rx */
-    GPIO_config3.Pin = GPIO_Pin_3; 
+    /* Rx pin of the link port */
+    GPIO_config3.Pin = ApplicationLink::Port::RX_PIN; 
     GPIO_config3.Mode =  GPIO_Mode_AF_OD;//GPIO_Mode_AF_PP; 
     GPIO_config3.Speed = GPIO_Speed_50MHz;
-    GPIO_Init(GPIO_ModuleAddress_GPIOA, &GPIO_config3);
+    GPIO_Init(ApplicationLink::Port::GPIO, &GPIO_config3);
+
+#if (APPLICATION_LINK_FLOW_CONTROL == 1)
+    /* CTS pin of the link port, read by the USART */
+    GPIO_config3.Pin = ApplicationLink::Port::CTS_PIN;
+    GPIO_config3.Mode = GPIO_Mode_IN_FLOATING;
+    GPIO_Init(ApplicationLink::Port::GPIO, &GPIO_config3);
+
+    /* RTS pin of the link port, driven by the link: high (not ready) until the receive DMA runs */
+    GPIO_SetBits(ApplicationLink::Port::GPIO, ApplicationLink::Port::RTS_PIN);
+    GPIO_config3.Pin = ApplicationLink::Port::RTS_PIN;
+    GPIO_config3.Mode = GPIO_Mode_Out_PP;
+    GPIO_Init(ApplicationLink::Port::GPIO, &GPIO_config3);
+#endif
        
-   /*USART Configuration */
-    USART_Enable(USART_ModuleAddress_USART2,true); 
-    USART_config.BaudRate = 115200; //9600;
+   /*USART Configuration of the link port */
+    USART_Enable(USARTLINK_MODULE(APPLICATION_LINK_PORT), true); 
+    USART_config.BaudRate = APPLICATION_LINK_BAUDRATE; //9600;
     USART_config.DataBits =  USART_DataBits_8b; 
     USART_config.StopBits = USART_StopBits_1; 
     USART_config.Parity = USART_Parity_No; 
     USART_config.Mode = USART_Mode_RxTx ;
+#if (APPLICATION_LINK_FLOW_CONTROL == 1)
+    // CTS only: the hardware RTS follows the data register, the link drives RTS by the fill of its receive ring
+    USART_config.HardwareFlowControl = USART_HardwareFlowControl_CTS;
+#else
+    USART_config.HardwareFlowControl = USART_HardwareFlowControl_None;
+#endif
+    // rejected if the divider misses the baud rate by more than the tolerance, the link stays silent (stats: baud)
+    USART_BaudRateSetting baudRateSetting;
+    if (!USART_InitChecked(USARTLINK_MODULE(APPLICATION_LINK_PORT), &USART_config, USART_BAUDRATE_MAX_ERROR_PPM, &baudRateSetting)) {
+        ASSERT_DEBUG(false);
+    }
+
+    /* GPIO Port B Pin10 USART3 Tx and Pin11 USART3 Rx of the Modbus RTU slave */
+    GPIO_config2.Pin = GPIO_Pin_10;
+    GPIO_config2.Mode = GPIO_Mode_AF_PP;
+    GPIO_Init(GPIO_ModuleAddress_GPIOB, &GPIO_config2);
+    GPIO_config3.Pin = GPIO_Pin_11;
+    GPIO_config3.Mode = GPIO_Mode_IN_FLOATING;
+    GPIO_Init(GPIO_ModuleAddress_GPIOB, &GPIO_config3);
+    /* GPIO Port B Pin12 driver enable of the RS-485 transceiver, low: bus released */
+    W_RS485_DE = 0U;
+    GPIO_config3.Pin = GPIO_Pin_12;
+    GPIO_config3.Mode = GPIO_Mode_Out_PP;
+    GPIO_Init(GPIO_ModuleAddress_GPIOB, &GPIO_config3);
+
+    /* USART3 Configuration: 8 data bits and the parity bit are 9 bits */
+    USART_Enable(USART_ModuleAddress_USART3, true);
+    USART_config.BaudRate = APPLICATION_MODBUS_BAUDRATE;
+    USART_config.DataBits = USART_DataBits_9b;
+    USART_config.Parity = USART_Parity_Even;
     USART_config.HardwareFlowControl = USART_HardwareFlowControl_None;
-    USART_Init(USART_ModuleAddress_USART2, &USART_config);
+    if (!USART_InitChecked(USART_ModuleAddress_USART3, &USART_config, USART_BAUDRATE_MAX_ERROR_PPM, &baudRateSetting)) {
+        ASSERT_DEBUG(false);
+    }
+
+    /* RS-485 half-duplex: the transceiver receives its own transmission, the USART receiver is disabled meanwhile */
+    USART_Rs485Config rs485Config;
+    rs485Config.pDriverEnable = &W_RS485_DE;
+    rs485Config.IsEchoSuppressed = true;
+    rs485Config.CharacterBits = APPLICATION_MODBUS_CHARACTER_BITS;
+    USART_Rs485Init(USART_ModuleAddress_USART3, &rs485Config);
     
     /* Port C pin 13 EXTI configuration*/  
     EXTI_InitStruct extiInitStruct;
     extiInitStruct.Line = EXTI_Line13;
     extiInitStruct.Mode = EXTI_Mode_Interrupt;
-    extiInitStruct.Trigger = EXTI_Trigger_Falling;// EXTI_Trigger_Rising;
+    // both edges: the debouncer confirms press and release
+    extiInitStruct.Trigger = EXTI_Trigger_Rising_Falling;
     extiInitStruct.EXTI_Enabled = true;
     EXTI_Init(&extiInitStruct);
    // NVIC_SetPriority(EXTI15_10_IRQn,IRQ_Priority5);
@@ -94,68 +194,35 @@ void SystemInitializationDriver::initPinConfig() {
 
 void SystemInitializationDriver::initInterrupts() {
 
-    // Assign all priority bits for preemption-priority and none to sub-priority
-    NVIC_SetPriorityGrouping(0U);
-    // Initialize system tick interrupt as highest interrupt
-   // NVIC_SetPriority(SysTick_IRQn, IRQ_Priority0);
-    
-    /* Port C pin 13 EXTI configuration*/  
-    NVIC_SetPriority(EXTI15_10_IRQn,IRQ_Priority5);
-    
-    //GPIO_Pin_2 USART2 Tx
-    NVIC_SetPriority(USART2_IRQn, IRQ_Priority4);
-   // USART_EnableInterrupt(USART_ModuleAddress_USART2,USART_Irq_CR1_TXE,true);
+#if (APPLICATION_VECTOR_TABLE_IN_RAM == 1)
+    // Vector table in SRAM, before any interrupt is enabled
+    VectorTable_RelocateToRam();
+#endif
+
+    // Priority grouping, priorities and handlers of all interrupts from the interrupt plan
+    InterruptPlan_ApplyPriorities(INTERRUPT_PLAN, INTERRUPT_PLAN_COUNT, APPLICATION_INTERRUPT_PRIORITY_GROUPING);
     
-    //GPIO_Pin_3 USART2 Rx
-    NVIC_SetPriority(USART2_IRQn, IRQ_Priority4);
-    USART_EnableInterrupt(USART_ModuleAddress_USART2,USART_Irq_CR1_RXNE,true);
+    // Tx and Rx of the link port are served by DMA, the link enables the idle line interrupt (@see SystemUsartLink.h)
     
-    //Timer interrupt
-    NVIC_SetPriority(TIM2_IRQn,IRQ_Priority3);
-    TIM_EnableInterrupt(TIM_ModuleAddress_TIM2, TIM_Irq_UpdateInterrupt, true);
+    // TIM2 toggles the LED by output compare and DMA without interrupt (@see TimerApp.h)
 }
 
 
-#if 0
-void SystemInitializationDriver::initRuntime(IdleCallbackIfc* const pCallback) {
-
-    RuntimeCore::init(pCallback);
-    // Initialize timer modules
-    RuntimeTimer::initTimerModule();
-
-}
-#endif
-
 void SystemInitializationDriver::enableInterrupts(void) {
 
-    // SysTick is used by DFF-runtime to process the 1ms tick count
- //   SysTick_EnableInterrupt(true);  
-    //GPIO EXTI 
-    NVIC_EnableIRQ(EXTI15_10_IRQn);
-    //USART IRQ  
-    NVIC_EnableIRQ(USART2_IRQn);  
-    //Timer interrupt
-    NVIC_EnableIRQ(TIM2_IRQn);
-  //  TIM_EnableInterrupt(TIM_ModuleAddress_TIM2, TIM_Irq_UpdateInterrupt, true);
+    // SysTick (button debouncer), input capture, USART and EXTI interrupts of the interrupt plan
+    InterruptPlan_EnableInterrupts(INTERRUPT_PLAN, INTERRUPT_PLAN_COUNT);
+    // End of the boot time measurement (@see SystemStartupControl.h)
+    Startup_MarkMilestone(Startup_Milestone_InterruptsEnabled);
 
  }
 
 void  SystemInitializationDriver::initTimer(void) {
 
-  // APB1 Timer Clock is 16 MHz
-    TIM_TimeBaseInitStruct config;
-   
-    // master timer counting microseconds
-    config.CounterMode = TIM_CounterModeUp;
-    config.Period =  2000;
-    
-    //80000/prescaler value * period= time in sec 
-    config.Prescaler = 20000; // scale timer to 10kHz, so that it has an increment of 100 microsecond
-    TIM_TimeBaseInit(TIM_ModuleAddress_TIM2, &config);
-   // TIM_SetMasterMode(TIM_ModuleAddress_TIM2, TIM_MasterMode_Update);
+    // TIM2 is configured and started with the LED pattern by TimerApp::startPattern (time base = pattern length)
 
-   //Enable timer; Enabled before using the Timer in LedHeartbeatAppHandler.cpp
-    TIM_Enable(TIM_ModuleAddress_TIM2, true); 
+    // TIM3 (master, microseconds) clocks TIM4 (slave, overflows of TIM3): 32-bit microsecond counter
+    TimeBase_Init();
 }
 
 
@@ -163,16 +230,7 @@ void SystemInitializationDriver::UART_TransmitData(void){
 
    const unsigned char msg[] = "USART is Working\n\r"; 
   
-   for (int i = 0; msg[i] != '\0'; ++i) {
-      while(!USART_IsTransmitDataRegisterEmpty(USART_ModuleAddress_USART2)){};
-      USART_SendData(USART_ModuleAddress_USART2, msg[i]);
-   }
-  // while (!USART_IsReadDataRegisterNotEmpty(USART_ModuleAddress_USART2)){};
-     
-   {
-     //cnt++;
-   //  uint16_t rxbyte = USART_ReceiveData (USART_ModuleAddress_USART2);
-   }
-
+   // queued for the transmit DMA of the link, does not wait for the transmission
+   (void)ApplicationLink::transmit(msg, sizeof(msg) - 1U);
  }
 
@@ -9,9 +9,6 @@
 //#include <Imt.Base.Core.Platform/Platform.h>
 #include "types.h"
 
-// Imt.Base includes
-//#include <Imt.Base.Dff.Runtime/IdleCallbackIfc.h>
-
 namespace blinky {
 
 //@{
@@ -42,17 +39,11 @@ public:
     //@}
     static void initInterrupts();
     
-    //@{
-    // Initialize the Runtime of Imt.Base.Dff (priority based, preemptive run to completion kernel)
-    // @param callback: When the runtime has no work to perform, the idle callback is called
-    //@}
-   // static void initRuntime(IdleCallbackIfc* const pCallback);
-
     //@{
     // Enable the interrupts of the processor and modules.
     //@}
     static void enableInterrupts(void);
-    //Added by Sunil for USART testing 
+    //Added by Sunil for USART testing, queues the message on the link (APPLICATION_LINK_PORT)
     static void UART_TransmitData(void);
     
     //For timer initialization 
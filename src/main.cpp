@@ -1,8 +1,22 @@
 #include "SystemInitializationDriver.h"
+#include "ApplicationHardwareConfig.h"
+#include "SystemStartupControl.h"
+#include "SystemInputCapture.h"
+#include "SystemFaultRecord.h"
 #include "LedBlink.h"
+#include "UsartApp.h"
+#include "ApplicationEvents.h"
+#include "ApplicationParts.h"
+#include "CommandShell.h"
+#include "ModbusApp.h"
+#include "SystemMemoryCopy.h"
+#include "BenchmarkApp.h"
 
 
 int main(void) {
+    Startup_MarkMilestone(Startup_Milestone_Main);
+    // Keep the fault records of the last resets, enable the fault handlers
+    FaultRecord_Init();
   
   //Processor, Clock and Ping Config
     SystemInitializationDriver::initCpuClock();
@@ -12,12 +26,37 @@ int main(void) {
      SystemInitializationDriver::initTimer();
     //Initialize the external interrupts
     SystemInitializationDriver::initInterrupts();
+    // Memory-to-memory DMA copies, the CPU copies below the measured crossover
+    MemoryCopy_Init();
+    (void)MemoryCopy_Calibrate();
+    // Benchmarks of the HAL for the timing command of the shell, before the interrupts of the drivers run
+    BenchmarkApp::measure();
+    // Queue of the events from the interrupts to the main loop
+    ApplicationEvents::init();
+    // Register the application inputs
+    LedBlinkHandler::init();
+    // Link on APPLICATION_LINK_PORT, receive and transmit by DMA
+    UsartHandler::init();
+    // Command shell on the link, fed by the USART part
+    CommandShell::init();
+    // Modbus RTU slave on USART3, its DMA channels 2 and 3 are shared with the DMA mode of the input capture
+    ModbusApp::init();
+    // Measure the signal on PB0, the mode is checked against the DMA channels of the Modbus slave
+    InputCapture_Init((APPLICATION_INPUT_CAPTURE_DMA == 1) ? InputCapture_Mode_Dma : InputCapture_Mode_Interrupt, 0U);
+    // Start the active parts, the timer part starts the first LED pattern
+    ApplicationParts::start();
       // Enable the interrupts just before the scheduler starts
     SystemInitializationDriver::enableInterrupts();
+    // Start message, then the link carries the frames of the USART part
+    SystemInitializationDriver::UART_TransmitData();
     
     while(1) {
+      (void)ApplicationEvents::dispatch();
+      (void)ApplicationParts::run();
+      InputCapture_Process();
+      CommandShell::process();
+      ModbusApp::process();
      // LedBlinkHandler::ledBlink();
-      SystemInitializationDriver::UART_TransmitData();
     }
     
     return 0;